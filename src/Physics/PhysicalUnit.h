@@ -64,6 +64,12 @@ PHYSICAL_UNIT_TYPE(-2, -1, 1, 0, 0, 0, 0, Pressure);
 PHYSICAL_UNIT_TYPE(0, -3, 1, 0, 0, 0, 0, Density);
 PHYSICAL_UNIT_TYPE(0, 0, 1, 0, 0, -1, 0, MolarMass);
 PHYSICAL_UNIT_TYPE(0, -1, 0, 0, 1, 0, 0, LapseRate);
+PHYSICAL_UNIT_TYPE(0, -1, 0, 0, 0, 0, 0, ReciprocalLength);
+PHYSICAL_UNIT_TYPE(-1, -1, 1, 0, 0, 0, 0, DynamicViscosity);
+PHYSICAL_UNIT_TYPE(-1, 2, 0, 0, 0, 0, 0, KinematicViscosity);
+PHYSICAL_UNIT_TYPE(-2, -2, 1, 0, 0, 0, 0, PressureGradient);
+PHYSICAL_UNIT_TYPE(0, -4, 1, 0, 0, 0, 0, DensityGradient);
+PHYSICAL_UNIT_TYPE(-1, 0, 1, 0, 0, 0, 0, MassFlowRate);
 
 // Constants
 PHYSICAL_UNIT_TYPE(-2, 2, 1, 0, -1, -1, 0, GasConstant);
@@ -0,0 +1,159 @@
+#include "SpaceToolkit/Atmosphere.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "SpaceToolkit/Simd.h"
+
+using SpaceToolkit::Atmosphere;
+using SpaceToolkit::AtmosphereProperties;
+using SpaceToolkit::AtmosphereState;
+namespace Simd = SpaceToolkit::Simd;
+
+namespace {
+// batch queries of the properties evaluate the state in chunks on the stack
+constexpr size_t CHUNK = 512;
+
+// the properties of a chunk as separate arrays, which vectorizes, they are
+// interleaved into the output afterwards
+struct PropertiesChunk {
+  double a[CHUNK];
+  double mu[CHUNK];
+  double nu[CHUNK];
+  double reynoldsPerMetre[CHUNK];
+  double meanFreePath[CHUNK];
+};
+
+SPACETOOLKIT_TARGET_CLONES
+void propertiesKernel(const Temperature* T, const Pressure* P,
+                      const Density* rho, PropertiesChunk& c, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    AtmosphereProperties p = Atmosphere::deriveProperties(
+        T[i].getValue(), P[i].getValue(), rho[i].getValue(), Simd::sqrt);
+    c.a[i] = p.a.getValue();
+    c.mu[i] = p.mu.getValue();
+    c.nu[i] = p.nu.getValue();
+    c.reynoldsPerMetre[i] = p.reynoldsPerMetre.getValue();
+    c.meanFreePath[i] = p.meanFreePath.getValue();
+  }
+}
+
+// number of values outside [lowest, highest], NaN counts as outside
+template <typename Unit>
+inline size_t countOutside(const Unit* x, size_t n, Unit lowest,
+                           Unit highest) {
+  size_t count = 0;
+  for (size_t i = 0; i < n; ++i)
+    count += !(x[i] >= lowest) | !(x[i] <= highest);
+  return count;
+}
+}  // namespace
+
+AtmosphereState Atmosphere::getAtmosphereStateByHeight(Length h) const {
+  return {getAtmosphereTemperatureByHeight(h),
+          getAtmospherePressureByHeight(h), getAtmosphereDensityByHeight(h)};
+}
+
+void Atmosphere::getAtmosphereTemperatureByHeight(const Length* h,
+                                                  Temperature* T,
+                                                  size_t n) const {
+  for (size_t i = 0; i < n; ++i) T[i] = getAtmosphereTemperatureByHeight(h[i]);
+}
+
+void Atmosphere::getAtmospherePressureByHeight(const Length* h, Pressure* P,
+                                               size_t n) const {
+  for (size_t i = 0; i < n; ++i) P[i] = getAtmospherePressureByHeight(h[i]);
+}
+
+void Atmosphere::getAtmosphereDensityByHeight(const Length* h, Density* rho,
+                                              size_t n) const {
+  for (size_t i = 0; i < n; ++i) rho[i] = getAtmosphereDensityByHeight(h[i]);
+}
+
+void Atmosphere::getAtmosphereStateByHeight(const Length* h, Temperature* T,
+                                            Pressure* P, Density* rho,
+                                            size_t n) const {
+  getAtmosphereTemperatureByHeight(h, T, n);
+  getAtmospherePressureByHeight(h, P, n);
+  getAtmosphereDensityByHeight(h, rho, n);
+}
+
+AtmosphereProperties Atmosphere::getAtmospherePropertiesByHeight(
+    Length h) const {
+  AtmosphereState state = getAtmosphereStateByHeight(h);
+  return deriveProperties(state.T.getValue(), state.P.getValue(),
+                          state.rho.getValue(),
+                          [](double x) { return std::sqrt(x); });
+}
+
+void Atmosphere::getAtmospherePropertiesByHeight(
+    const Length* h, AtmosphereProperties* properties, size_t n) const {
+  Temperature T[CHUNK];
+  Pressure P[CHUNK];
+  Density rho[CHUNK];
+  PropertiesChunk c;
+  for (size_t i = 0; i < n; i += CHUNK) {
+    size_t m = std::min(CHUNK, n - i);
+    getAtmosphereStateByHeight(h + i, T, P, rho, m);
+    propertiesKernel(T, P, rho, c, m);
+    for (size_t j = 0; j < m; ++j)
+      properties[i + j] = {T[j],
+                           P[j],
+                           rho[j],
+                           Speed(c.a[j]),
+                           DynamicViscosity(c.mu[j]),
+                           KinematicViscosity(c.nu[j]),
+                           ReciprocalLength(c.reynoldsPerMetre[j]),
+                           Length(c.meanFreePath[j])};
+  }
+}
+
+SPACETOOLKIT_TARGET_CLONES
+size_t Atmosphere::countOutOfRange(const Length* h, size_t n, Length bottom,
+                                   Length top) {
+  return countOutside(h, n, bottom, top);
+}
+
+SPACETOOLKIT_TARGET_CLONES
+size_t Atmosphere::countOutOfRange(const Pressure* P, size_t n,
+                                   Pressure lowest, Pressure highest) {
+  return countOutside(P, n, lowest, highest);
+}
+
+SPACETOOLKIT_TARGET_CLONES
+size_t Atmosphere::countOutOfRange(const Density* rho, size_t n,
+                                   Density lowest, Density highest) {
+  return countOutside(rho, n, lowest, highest);
+}
+
+SPACETOOLKIT_TARGET_CLONES
+size_t Atmosphere::countOutOfRange(const float* x, size_t n, float lowest,
+                                   float highest) {
+  return countOutside(x, n, lowest, highest);
+}
+
+// scalar since out of range heights are expected to be rare
+size_t Atmosphere::markOutOfRange(const Length* h, size_t n, Length bottom,
+                                  Length top, uint64_t* outOfRange) {
+  std::fill(outOfRange, outOfRange + (n + 63) / 64, 0);
+  size_t count = 0;
+  for (size_t i = 0; i < n; ++i) {
+    if (h[i] >= bottom && h[i] <= top) continue;
+    outOfRange[i / 64] |= uint64_t(1) << (i % 64);
+    ++count;
+  }
+  return count;
+}
+
+size_t Atmosphere::countProfileUpTo(Length bottom, Length step, size_t n,
+                                    Length top) {
+  double h0 = bottom.getValue(), dh = step.getValue();
+  if (n == 0 || h0 > top.getValue()) return 0;
+
+  // the estimate is off by at most one from rounding
+  double estimate = std::floor((top.getValue() - h0) / dh) + 1.0;
+  size_t count = estimate < double(n) ? static_cast<size_t>(estimate) : n;
+  while (count > 0 && h0 + (count - 1) * dh > top.getValue()) --count;
+  while (count < n && h0 + count * dh <= top.getValue()) ++count;
+  return count;
+}
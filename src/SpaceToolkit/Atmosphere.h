@@ -1,16 +1,133 @@
 #ifndef ATMOSPHERE_H_
 #define ATMOSPHERE_H_
 
+#include <cstddef>
+#include <cstdint>
+
 #include "Physics/PhysicalUnit.h"
 
 using namespace Physics;
 
 namespace SpaceToolkit {
+// temperature, pressure and density at one height
+struct AtmosphereState {
+  Temperature T;
+  Pressure P;
+  Density rho;
+};
+
+// derivatives of the state by height
+struct AtmosphereDerivatives {
+  LapseRate dT;
+  PressureGradient dP;
+  DensityGradient drho;
+};
+
+// the state and the gas properties derived from it. Speed of sound and
+// viscosity use the constants of air, above 86 km they extrapolate beyond the
+// range where the standard defines them.
+struct AtmosphereProperties {
+  Temperature T;
+  Pressure P;
+  Density rho;
+  Speed a;                            // speed of sound
+  DynamicViscosity mu;                // Sutherland's law
+  KinematicViscosity nu;              // mu / rho
+  ReciprocalLength reynoldsPerMetre;  // Reynolds number per metre at Mach 1
+  Length meanFreePath;
+};
+
+// result of the non-throwing queries
+enum class AtmosphereStatus { Ok, BelowRange, AboveRange };
+
+// what the non-throwing queries return for heights out of range: the state at
+// the nearest valid height, or NaN
+enum class OutOfRangePolicy { Clamp, NaN };
+
+// Interface of the atmosphere models. The queries are const, so one instance
+// can be shared between threads. See AtmosphereModel for calls without the
+// vtable.
 class Atmosphere {
  public:
-  virtual Temperature getAtmosphereTemperatureByHeight(Length h) = 0;
-  virtual Pressure getAtmospherePressureByHeight(Length h) = 0;
-  virtual Density getAtmosphereDensityByHeight(Length h) = 0;
+  virtual ~Atmosphere() = default;
+
+  virtual Temperature getAtmosphereTemperatureByHeight(Length h) const = 0;
+  virtual Pressure getAtmospherePressureByHeight(Length h) const = 0;
+  virtual Density getAtmosphereDensityByHeight(Length h) const = 0;
+
+  // all state variables at once, the default implementation calls the single
+  // queries
+  virtual AtmosphereState getAtmosphereStateByHeight(Length h) const;
+
+  // batch queries: evaluate the n heights in h and write the results to the
+  // caller provided array. The default implementations loop over the scalar
+  // queries.
+  virtual void getAtmosphereTemperatureByHeight(const Length* h,
+                                                Temperature* T,
+                                                size_t n) const;
+  virtual void getAtmospherePressureByHeight(const Length* h, Pressure* P,
+                                             size_t n) const;
+  virtual void getAtmosphereDensityByHeight(const Length* h, Density* rho,
+                                            size_t n) const;
+  virtual void getAtmosphereStateByHeight(const Length* h, Temperature* T,
+                                          Pressure* P, Density* rho,
+                                          size_t n) const;
+
+  // the state query and the derived gas properties in one pass. The Reynolds
+  // number of a flow is Mach * length * reynoldsPerMetre. The batch query
+  // works in chunks, if it throws the earlier chunks are written already.
+  AtmosphereProperties getAtmospherePropertiesByHeight(Length h) const;
+  void getAtmospherePropertiesByHeight(const Length* h,
+                                       AtmosphereProperties* properties,
+                                       size_t n) const;
+
+  // the gas properties of a state. Speed of sound and viscosity use the ratio
+  // of specific heats and the Sutherland constants of air, the mean free path
+  // the collision diameter of the standard. sqrt is passed in, the scalar
+  // queries use the libm one and the batch kernels Simd::sqrt.
+  template <typename Sqrt>
+  static AtmosphereProperties deriveProperties(double T, double P, double rho,
+                                               Sqrt sqrt) {
+    constexpr double GAMMA = 1.4;
+    constexpr double BETA = 1.458e-6;  // kg / (m s K^0.5)
+    constexpr double S = 110.4;        // K
+    // k_B / (sqrt(2) pi sigma^2) with sigma = 3.65e-10 m
+    constexpr double MEAN_FREE_PATH = 1.380622e-23 /
+                                      (1.41421356237309504880 *
+                                       3.14159265358979323846 * 3.65e-10 *
+                                       3.65e-10);
+
+    // sqrt(T) and 1 / rho are shared between the properties
+    double sqrtT = sqrt(T);
+    double invRho = 1.0 / rho;
+    double a = sqrt(GAMMA * P * invRho);
+    double mu = BETA * T * sqrtT / (T + S);
+    double nu = mu * invRho;
+    return {Temperature(T),           Pressure(P),
+            Density(rho),             Speed(a),
+            DynamicViscosity(mu),     KinematicViscosity(nu),
+            ReciprocalLength(a / nu), Length(MEAN_FREE_PATH * T / P)};
+  }
+
+ protected:
+  // number of heights outside [bottom, top], NaN counts as out of range
+  static size_t countOutOfRange(const Length* h, size_t n, Length bottom,
+                                Length top);
+  // the same for the inverse queries and the single precision queries
+  static size_t countOutOfRange(const Pressure* P, size_t n, Pressure lowest,
+                                Pressure highest);
+  static size_t countOutOfRange(const Density* rho, size_t n, Density lowest,
+                                Density highest);
+  static size_t countOutOfRange(const float* x, size_t n, float lowest,
+                                float highest);
+  // the same, and sets bit i % 64 of outOfRange[i / 64] for every height out
+  // of range
+  static size_t markOutOfRange(const Length* h, size_t n, Length bottom,
+                               Length top, uint64_t* outOfRange);
+  // number of leading heights bottom + i * step <= top of a profile of n
+  // heights, step > 0
+  static size_t countProfileUpTo(Length bottom, Length step, size_t n,
+                                 Length top);
 };
 }  // namespace SpaceToolkit
 #endif  // ATMOSPHERE_H_
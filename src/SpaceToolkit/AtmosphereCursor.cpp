@@ -0,0 +1,48 @@
+#include "SpaceToolkit/AtmosphereCursor.h"
+
+#include <algorithm>
+
+#include "SpaceToolkit/SpaceToolkitException.h"
+
+using SpaceToolkit::AtmosphereCursor;
+using SpaceToolkit::AtmosphereState;
+using SpaceToolkit::LayeredAtmosphere;
+using SpaceToolkit::SpaceToolkitException;
+using SpaceToolkit::USStandardAtmosphere1976;
+
+AtmosphereCursor::AtmosphereCursor(const LayeredAtmosphere& atmosphere)
+    : m_atmosphere(atmosphere),
+      m_thermosphere(nullptr),
+      m_topHeight(atmosphere.getTopHeight()),
+      m_layer(0) {}
+
+AtmosphereCursor::AtmosphereCursor(const USStandardAtmosphere1976& atmosphere)
+    : m_atmosphere(atmosphere.getLowerAtmosphere()),
+      m_thermosphere(&atmosphere.getThermosphere()),
+      m_topHeight(atmosphere.getTopHeight()),
+      m_layer(0) {}
+
+AtmosphereState AtmosphereCursor::moveTo(Length h) {
+  if (!(h >= m_atmosphere.getBottomHeight() && h <= m_topHeight))
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+
+  size_t layerCount = m_atmosphere.m_layerCount;
+  if (h > m_atmosphere.getTopHeight()) {
+    m_layer = layerCount + m_thermosphere->regionOf(h);
+    return m_thermosphere->getState(h);
+  }
+
+  // walk to the layer k with h_b[k] < h <= h_b[k + 1]
+  const double* h_b = m_atmosphere.m_table.h_b;
+  m_layer = std::min(m_layer, layerCount - 1);
+  while (m_layer + 1 < layerCount && h.getValue() > h_b[m_layer + 1])
+    ++m_layer;
+  while (m_layer > 0 && h.getValue() <= h_b[m_layer]) --m_layer;
+
+  Temperature T;
+  Pressure P = m_atmosphere.pressureInLayer(h, m_layer, T);
+  return {T, P, P * m_atmosphere.m_molarMass / (R * T)};
+}
+
+size_t AtmosphereCursor::getLayer() const { return m_layer; }
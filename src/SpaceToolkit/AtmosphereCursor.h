@@ -0,0 +1,34 @@
+#ifndef ATMOSPHERECURSOR_H_
+#define ATMOSPHERECURSOR_H_
+
+#include "SpaceToolkit/LayeredAtmosphere.h"
+#include "SpaceToolkit/USStandardAtmosphere1976.h"
+
+namespace SpaceToolkit {
+// Walks a LayeredAtmosphere along a trajectory. The cursor remembers the
+// layer of the last query and only steps across the neighbouring boundaries,
+// so slowly changing heights cost amortized O(1) instead of a layer search.
+// The atmosphere must outlive the cursor.
+class AtmosphereCursor {
+ public:
+  explicit AtmosphereCursor(const LayeredAtmosphere& atmosphere);
+  // walks the lower layers and the thermosphere regions above them
+  explicit AtmosphereCursor(const USStandardAtmosphere1976& atmosphere);
+
+  // state at h, throws if h is out of range
+  AtmosphereState moveTo(Length h);
+
+  // index of the layer of the last query, starting at 0 for the bottom layer.
+  // A change between two queries marks a boundary crossing, e.g. layer 0 to 1
+  // is the tropopause in USStandardAtmosphere1976. The thermosphere regions
+  // follow the lower layers.
+  size_t getLayer() const;
+
+ private:
+  const LayeredAtmosphere& m_atmosphere;
+  const Thermosphere1976* m_thermosphere;  // null without thermosphere
+  Length m_topHeight;
+  size_t m_layer;
+};
+}  // namespace SpaceToolkit
+#endif  // ATMOSPHERECURSOR_H_
@@ -0,0 +1,242 @@
+#include "SpaceToolkit/AtmosphereDispersion.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "SpaceToolkit/Random.h"
+#include "SpaceToolkit/Simd.h"
+
+using SpaceToolkit::AtmosphereDispersion;
+using SpaceToolkit::DispersedAtmosphere;
+using SpaceToolkit::SpaceToolkitException;
+
+namespace {
+// batch queries are evaluated in chunks, which keeps the base states on the
+// stack
+constexpr size_t CHUNK = 1024;
+
+// pairs of normal numbers of a sample: the temperature offset and the log
+// density scale, then the innovations of the knots j and j + 1 in pair
+// FIRST_KNOT_PAIR + j / 2
+constexpr uint64_t PARAMETER_PAIR = 0;
+constexpr uint64_t FIRST_KNOT_PAIR = 1;
+
+// the perturbed states of the base states by the log density perturbations
+SPACETOOLKIT_TARGET_CLONES
+void perturbKernel(const double* perturbation, const Temperature* T_base,
+                   const Pressure* P_base, const Density* rho_base,
+                   Temperature* T, Pressure* P, Density* rho, size_t n,
+                   double temperatureOffset) {
+  for (size_t i = 0; i < n; ++i) {
+    double factor = SpaceToolkit::Simd::exp(perturbation[i]);
+    double T_b = T_base[i].getValue();
+    double T_i =
+        DispersedAtmosphere::perturbTemperature(T_b, temperatureOffset);
+    T[i] = Temperature(T_i);
+    P[i] = Pressure(P_base[i].getValue() * factor * (T_i / T_b));
+    rho[i] = Density(rho_base[i].getValue() * factor);
+  }
+}
+}  // namespace
+
+DispersedAtmosphere::DispersedAtmosphere(const Atmosphere& base,
+                                         Length bottomHeight,
+                                         Length topHeight, Length knotSpacing)
+    : m_base(base),
+      m_temperatureOffset(0.0),
+      m_logDensityScale(0.0),
+      m_bottomHeight(bottomHeight),
+      m_topHeight(topHeight),
+      m_invKnotSpacing(1.0 / knotSpacing.getValue()) {}
+
+Temperature DispersedAtmosphere::getAtmosphereTemperatureByHeight(
+    Length h) const {
+  checkHeights(&h, 1);
+  return Temperature(perturbTemperature(
+      m_base.getAtmosphereTemperatureByHeight(h).getValue(),
+      m_temperatureOffset.getValue()));
+}
+
+Pressure DispersedAtmosphere::getAtmospherePressureByHeight(Length h) const {
+  return getAtmosphereStateByHeight(h).P;
+}
+
+Density DispersedAtmosphere::getAtmosphereDensityByHeight(Length h) const {
+  checkHeights(&h, 1);
+  return m_base.getAtmosphereDensityByHeight(h) *
+         Fexp(Number(getLogDensityPerturbation(h)));
+}
+
+void DispersedAtmosphere::getAtmosphereTemperatureByHeight(const Length* h,
+                                                           Temperature* T,
+                                                           size_t n) const {
+  checkHeights(h, n);
+  m_base.getAtmosphereTemperatureByHeight(h, T, n);
+  double offset = m_temperatureOffset.getValue();
+  for (size_t i = 0; i < n; ++i)
+    T[i] = Temperature(perturbTemperature(T[i].getValue(), offset));
+}
+
+void DispersedAtmosphere::getAtmospherePressureByHeight(const Length* h,
+                                                        Pressure* P,
+                                                        size_t n) const {
+  Temperature T[CHUNK];
+  Density rho[CHUNK];
+  for (size_t i = 0; i < n; i += CHUNK)
+    getAtmosphereStateByHeight(h + i, T, P + i, rho, std::min(CHUNK, n - i));
+}
+
+void DispersedAtmosphere::getAtmosphereDensityByHeight(const Length* h,
+                                                       Density* rho,
+                                                       size_t n) const {
+  Temperature T[CHUNK];
+  Pressure P[CHUNK];
+  for (size_t i = 0; i < n; i += CHUNK)
+    getAtmosphereStateByHeight(h + i, T, P, rho + i, std::min(CHUNK, n - i));
+}
+
+void DispersedAtmosphere::getAtmosphereStateByHeight(const Length* h,
+                                                     Temperature* T,
+                                                     Pressure* P, Density* rho,
+                                                     size_t n) const {
+  checkHeights(h, n);
+  m_base.getAtmosphereStateByHeight(h, T, P, rho, n);
+  perturb(h, T, P, rho, T, P, rho, n);
+}
+
+Temperature DispersedAtmosphere::getTemperatureOffset() const {
+  return m_temperatureOffset;
+}
+
+double DispersedAtmosphere::getLogDensityScale() const {
+  return m_logDensityScale;
+}
+
+Length DispersedAtmosphere::getBottomHeight() const { return m_bottomHeight; }
+
+Length DispersedAtmosphere::getTopHeight() const { return m_topHeight; }
+
+void DispersedAtmosphere::checkHeights(const Length* h, size_t n) const {
+  if (countOutOfRange(h, n, m_bottomHeight, m_topHeight) > 0)
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+}
+
+void DispersedAtmosphere::perturb(const Length* h, const Temperature* T_base,
+                                  const Pressure* P_base,
+                                  const Density* rho_base, Temperature* T,
+                                  Pressure* P, Density* rho, size_t n) const {
+  // the interpolation of the knots does not vectorize, the rest does
+  double perturbation[CHUNK];
+  for (size_t i = 0; i < n; i += CHUNK) {
+    size_t m = std::min(CHUNK, n - i);
+    for (size_t j = 0; j < m; ++j)
+      perturbation[j] = getLogDensityPerturbation(h[i + j]);
+    perturbKernel(perturbation, T_base + i, P_base + i, rho_base + i, T + i,
+                  P + i, rho + i, m, m_temperatureOffset.getValue());
+  }
+}
+
+AtmosphereDispersion::AtmosphereDispersion(
+    const Atmosphere& base, Length bottomHeight, Length topHeight,
+    const DispersionParameters& parameters, uint64_t seed, size_t sampleCount)
+    : m_base(base),
+      m_bottomHeight(bottomHeight),
+      m_topHeight(topHeight),
+      m_parameters(parameters),
+      m_seed(seed),
+      m_temperatureOffset(sampleCount),
+      m_logDensityScale(sampleCount) {
+  if (!(topHeight > bottomHeight) ||
+      !(parameters.temperatureSigma.getValue() >= 0.0) ||
+      !(parameters.densityScaleSigma >= 0.0) ||
+      !(parameters.densityNoiseSigma >= 0.0) ||
+      !(parameters.correlationLength.getValue() > 0.0) ||
+      !(parameters.knotSpacing.getValue() > 0.0))
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+  // the range of the base is an interval, the base throws for either end
+  // out of it
+  base.getAtmosphereStateByHeight(bottomHeight);
+  base.getAtmosphereStateByHeight(topHeight);
+
+  // knots at both ends, with the spacing rounded down to divide the range
+  double range = (topHeight - bottomHeight).getValue();
+  m_knotCount =
+      static_cast<size_t>(
+          std::ceil(range / parameters.knotSpacing.getValue())) +
+      1;
+  m_parameters.knotSpacing = Length(range / (m_knotCount - 1));
+
+  for (size_t s = 0; s < sampleCount; ++s) {
+    double z0, z1;
+    Random::normalPair(m_seed, s, PARAMETER_PAIR, z0, z1);
+    m_temperatureOffset[s] =
+        static_cast<float>(parameters.temperatureSigma.getValue() * z0);
+    m_logDensityScale[s] =
+        static_cast<float>(parameters.densityScaleSigma * z1);
+  }
+}
+
+size_t AtmosphereDispersion::getSampleCount() const {
+  return m_temperatureOffset.size();
+}
+
+size_t AtmosphereDispersion::getKnotCount() const { return m_knotCount; }
+
+Length AtmosphereDispersion::getBottomHeight() const { return m_bottomHeight; }
+
+Length AtmosphereDispersion::getTopHeight() const { return m_topHeight; }
+
+DispersedAtmosphere AtmosphereDispersion::getSample(size_t sample) const {
+  if (sample >= getSampleCount())
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+
+  DispersedAtmosphere atmosphere(m_base, m_bottomHeight, m_topHeight,
+                                 m_parameters.knotSpacing);
+  atmosphere.m_temperatureOffset = Temperature(m_temperatureOffset[sample]);
+  atmosphere.m_logDensityScale = m_logDensityScale[sample];
+
+  // first order Gauss-Markov sequence, which is stationary with the
+  // correlation exp(-|dh| / correlationLength) between the knots
+  double sigma = m_parameters.densityNoiseSigma;
+  double correlation = std::exp(-(m_parameters.knotSpacing /
+                                  m_parameters.correlationLength)
+                                     .getValue());
+  double innovation = sigma * std::sqrt(1.0 - correlation * correlation);
+
+  std::vector<double>& noise = atmosphere.m_noise;
+  noise.resize(m_knotCount);
+  for (size_t j = 0; j < m_knotCount; j += 2) {
+    double z[2];
+    Random::normalPair(m_seed, sample, FIRST_KNOT_PAIR + j / 2, z[0], z[1]);
+    for (size_t k = j; k < std::min(j + 2, m_knotCount); ++k)
+      noise[k] = k == 0 ? sigma * z[0]
+                        : correlation * noise[k - 1] + innovation * z[k - j];
+  }
+  return atmosphere;
+}
+
+void AtmosphereDispersion::getAtmosphereStateBySample(
+    const Length* h, size_t n, size_t firstSample, size_t count,
+    Temperature* T, Pressure* P, Density* rho) const {
+  if (firstSample > getSampleCount() ||
+      count > getSampleCount() - firstSample ||
+      DispersedAtmosphere::countOutOfRange(h, n, m_bottomHeight,
+                                           m_topHeight) > 0)
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+
+  std::vector<Temperature> T_base(n);
+  std::vector<Pressure> P_base(n);
+  std::vector<Density> rho_base(n);
+  m_base.getAtmosphereStateByHeight(h, T_base.data(), P_base.data(),
+                                    rho_base.data(), n);
+
+  for (size_t s = 0; s < count; ++s) {
+    DispersedAtmosphere atmosphere = getSample(firstSample + s);
+    atmosphere.perturb(h, T_base.data(), P_base.data(), rho_base.data(),
+                       T + s * n, P + s * n, rho + s * n, n);
+  }
+}
@@ -0,0 +1,161 @@
+#ifndef ATMOSPHEREDISPERSION_H_
+#define ATMOSPHEREDISPERSION_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "SpaceToolkit/AtmosphereModel.h"
+#include "SpaceToolkit/FastMath.h"
+#include "SpaceToolkit/SpaceToolkitException.h"
+
+namespace SpaceToolkit {
+// standard deviations of the perturbations of a dispersed atmosphere. The
+// density perturbations act on ln rho: a scale factor per sample and noise
+// which is correlated over height by exp(-|dh| / correlationLength).
+struct DispersionParameters {
+  Temperature temperatureSigma;
+  double densityScaleSigma;
+  double densityNoiseSigma;
+  Length correlationLength;
+  // spacing of the noise values, which are interpolated linearly between.
+  // A spacing well below the correlation length keeps the variance of the
+  // noise between the knots close to densityNoiseSigma^2.
+  Length knotSpacing;
+};
+
+// One sample of an AtmosphereDispersion: the base atmosphere with
+//
+//   T'   = max(T + dT, T / 10)
+//   rho' = rho exp(s + n(h))
+//   P'   = P (rho' / rho) (T' / T)
+//
+// with the temperature offset dT, the log density scale s and the noise n(h)
+// of the sample, so that the state still satisfies the gas law. The floor of
+// T' only applies to offsets of the order of T, e.g. of a large
+// temperatureSigma at the cold mesopause, and keeps T' and P' positive. The
+// base must outlive the sample. The scalar state query is inline, see
+// AtmosphereModel.
+class DispersedAtmosphere final : public AtmosphereModel<DispersedAtmosphere> {
+ public:
+  Temperature getAtmosphereTemperatureByHeight(Length h) const;
+  Pressure getAtmospherePressureByHeight(Length h) const;
+  Density getAtmosphereDensityByHeight(Length h) const;
+  AtmosphereState getAtmosphereStateByHeight(Length h) const;
+
+  void getAtmosphereTemperatureByHeight(const Length* h, Temperature* T,
+                                        size_t n) const;
+  void getAtmospherePressureByHeight(const Length* h, Pressure* P,
+                                     size_t n) const;
+  void getAtmosphereDensityByHeight(const Length* h, Density* rho,
+                                    size_t n) const;
+  void getAtmosphereStateByHeight(const Length* h, Temperature* T, Pressure* P,
+                                  Density* rho, size_t n) const;
+
+  Temperature getTemperatureOffset() const;
+  double getLogDensityScale() const;
+  // ln rho' - ln rho at h
+  double getLogDensityPerturbation(Length h) const;
+  // T' of the base temperature T and the temperature offset dT
+  static double perturbTemperature(double T, double temperatureOffset);
+  Length getBottomHeight() const;
+  Length getTopHeight() const;
+
+ private:
+  friend class AtmosphereDispersion;
+
+  const Atmosphere& m_base;
+  Temperature m_temperatureOffset;
+  double m_logDensityScale;
+  std::vector<double> m_noise;  // noise at the knots
+  Length m_bottomHeight;
+  Length m_topHeight;
+  double m_invKnotSpacing;
+
+  DispersedAtmosphere(const Atmosphere& base, Length bottomHeight,
+                      Length topHeight, Length knotSpacing);
+
+  void checkHeights(const Length* h, size_t n) const;
+  // the perturbed states of the base states at n heights
+  void perturb(const Length* h, const Temperature* T_base,
+               const Pressure* P_base, const Density* rho_base,
+               Temperature* T, Pressure* P, Density* rho, size_t n) const;
+};
+
+// Generator of dispersed atmospheres for Monte Carlo analyses, e.g. of
+// thousands of perturbed USStandardAtmosphere1976 profiles. A sample is
+// stored as its temperature offset and log density scale in single
+// precision, 8 bytes, on top of the shared base. Its correlated noise is a
+// Gauss-Markov sequence over the knots, which is regenerated when the sample
+// is taken rather than stored, so 10^5 samples take 800 kB.
+//
+// The random numbers come from the counter based generator of Random.h keyed
+// by the seed and the sample index. A sample is therefore the same for any
+// sample count and order of generation, and samples can be taken and
+// evaluated by several threads at once.
+class AtmosphereDispersion {
+ public:
+  // sampleCount samples of the base between bottomHeight and topHeight,
+  // which must lie within the range of the base. Throws if a parameter is
+  // out of range, the range check is by the base queries at both heights.
+  AtmosphereDispersion(const Atmosphere& base, Length bottomHeight,
+                       Length topHeight,
+                       const DispersionParameters& parameters, uint64_t seed,
+                       size_t sampleCount);
+
+  size_t getSampleCount() const;
+  size_t getKnotCount() const;
+  Length getBottomHeight() const;
+  Length getTopHeight() const;
+
+  // the atmosphere of a sample, which costs getKnotCount() / 2 calls of the
+  // generator. Throws if the sample does not exist.
+  DispersedAtmosphere getSample(size_t sample) const;
+
+  // the states of count samples from firstSample at the n heights h, written
+  // to T[s * n + i] for sample firstSample + s and height h[i]. The base is
+  // evaluated once for all samples. Throws if a sample does not exist or a
+  // height is out of range.
+  void getAtmosphereStateBySample(const Length* h, size_t n,
+                                  size_t firstSample, size_t count,
+                                  Temperature* T, Pressure* P,
+                                  Density* rho) const;
+
+ private:
+  const Atmosphere& m_base;
+  Length m_bottomHeight;
+  Length m_topHeight;
+  DispersionParameters m_parameters;
+  uint64_t m_seed;
+  size_t m_knotCount;
+  std::vector<float> m_temperatureOffset;
+  std::vector<float> m_logDensityScale;
+};
+
+inline double DispersedAtmosphere::getLogDensityPerturbation(Length h) const {
+  // linear interpolation between the knots at and below h
+  double x = (h - m_bottomHeight).getValue() * m_invKnotSpacing;
+  size_t last = m_noise.size() - 2;
+  size_t j = x < static_cast<double>(last) ? static_cast<size_t>(x) : last;
+  double w = x - static_cast<double>(j);
+  return m_logDensityScale + m_noise[j] + w * (m_noise[j + 1] - m_noise[j]);
+}
+
+inline double DispersedAtmosphere::perturbTemperature(
+    double T, double temperatureOffset) {
+  double perturbed = T + temperatureOffset;
+  double minimum = 0.1 * T;
+  return perturbed > minimum ? perturbed : minimum;
+}
+
+inline AtmosphereState DispersedAtmosphere::getAtmosphereStateByHeight(
+    Length h) const {
+  checkHeights(&h, 1);
+  AtmosphereState base = m_base.getAtmosphereStateByHeight(h);
+  Temperature T = Temperature(perturbTemperature(
+      base.T.getValue(), m_temperatureOffset.getValue()));
+  Number densityFactor = Fexp(Number(getLogDensityPerturbation(h)));
+  return {T, base.P * densityFactor * (T / base.T),
+          base.rho * densityFactor};
+}
+}  // namespace SpaceToolkit
+#endif  // ATMOSPHEREDISPERSION_H_
@@ -0,0 +1,41 @@
+#ifndef ATMOSPHEREMODEL_H_
+#define ATMOSPHEREMODEL_H_
+
+#include <cmath>
+
+#include "SpaceToolkit/Atmosphere.h"
+
+namespace SpaceToolkit {
+// Static dispatch base of the atmosphere models:
+//
+//   class Model final : public AtmosphereModel<Model>
+//
+// A model implements the queries of Atmosphere as const members and defines
+// its scalar state query in the header. Since the model is final, code
+// templated on the model type, e.g. an integrator, calls the queries without
+// the vtable and the compiler inlines them into its loop. Instantiated on
+// Atmosphere the same code takes any model through the virtual interface:
+//
+//   template <typename A>
+//   Speed terminalVelocity(const A& atmosphere, Length h, ...) {
+//     AtmosphereState state = atmosphere.getAtmosphereStateByHeight(h);
+//     ...
+//   }
+template <typename Model>
+class AtmosphereModel : public Atmosphere {
+ public:
+  using Atmosphere::getAtmospherePropertiesByHeight;
+
+  // the gas properties on top of the model's inlined state query
+  AtmosphereProperties getAtmospherePropertiesByHeight(Length h) const {
+    AtmosphereState state = model().getAtmosphereStateByHeight(h);
+    return deriveProperties(state.T.getValue(), state.P.getValue(),
+                            state.rho.getValue(),
+                            [](double x) { return std::sqrt(x); });
+  }
+
+ protected:
+  const Model& model() const { return static_cast<const Model&>(*this); }
+};
+}  // namespace SpaceToolkit
+#endif  // ATMOSPHEREMODEL_H_
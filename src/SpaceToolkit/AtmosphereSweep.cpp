@@ -0,0 +1,104 @@
+#include "SpaceToolkit/AtmosphereSweep.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+using SpaceToolkit::AtmosphereSweep;
+
+constexpr size_t AtmosphereSweep::CHUNK;
+
+AtmosphereSweep::AtmosphereSweep(size_t threadCount) : m_pool(threadCount) {
+  for (size_t i = 0; i < m_pool.getThreadCount(); ++i) {
+    m_buffers.emplace_back(new Buffers);
+    m_buffers.back()->h.resize(CHUNK);
+    m_buffers.back()->T.resize(CHUNK);
+    m_buffers.back()->P.resize(CHUNK);
+    m_buffers.back()->rho.resize(CHUNK);
+  }
+}
+
+size_t AtmosphereSweep::getThreadCount() const {
+  return m_pool.getThreadCount();
+}
+
+void AtmosphereSweep::getAtmosphereStateByHeight(const Atmosphere& atmosphere,
+                                                 const Length* h,
+                                                 Temperature* T, Pressure* P,
+                                                 Density* rho, size_t n) {
+  run((n + CHUNK - 1) / CHUNK, [&](size_t chunk, Buffers&) {
+    size_t first = chunk * CHUNK;
+    atmosphere.getAtmosphereStateByHeight(h + first, T + first, P + first,
+                                          rho + first,
+                                          std::min(CHUNK, n - first));
+  });
+}
+
+void AtmosphereSweep::getAtmosphereProfile(const Atmosphere& atmosphere,
+                                           Length bottom, Length step,
+                                           Temperature* T, Pressure* P,
+                                           Density* rho, size_t n) {
+  run((n + CHUNK - 1) / CHUNK, [&](size_t chunk, Buffers& buffers) {
+    size_t first = chunk * CHUNK;
+    size_t m = std::min(CHUNK, n - first);
+    for (size_t i = 0; i < m; ++i)
+      buffers.h[i] = bottom + static_cast<double>(first + i) * step;
+    atmosphere.getAtmosphereStateByHeight(buffers.h.data(), T + first,
+                                          P + first, rho + first, m);
+  });
+}
+
+void AtmosphereSweep::getAtmosphereProfile(const Atmosphere& atmosphere,
+                                           Length bottom, Length step,
+                                           size_t n,
+                                           AtmosphereSweepSink& sink) {
+  // a thread with a finished chunk waits for the sink to take the chunks
+  // before it. The chunks are handed out in order, so the thread of the next
+  // chunk is always busy with it.
+  std::mutex order;
+  std::condition_variable turn;
+  size_t nextChunk = 0;
+  bool aborted = false;
+
+  run((n + CHUNK - 1) / CHUNK, [&](size_t chunk, Buffers& buffers) {
+    size_t first = chunk * CHUNK;
+    size_t m = std::min(CHUNK, n - first);
+    try {
+      for (size_t i = 0; i < m; ++i)
+        buffers.h[i] = bottom + static_cast<double>(first + i) * step;
+      atmosphere.getAtmosphereStateByHeight(buffers.h.data(),
+                                            buffers.T.data(), buffers.P.data(),
+                                            buffers.rho.data(), m);
+
+      std::unique_lock<std::mutex> lock(order);
+      turn.wait(lock, [&] { return nextChunk == chunk || aborted; });
+      if (aborted) return;
+      sink.consume(first, buffers.h.data(), buffers.T.data(),
+                   buffers.P.data(), buffers.rho.data(), m);
+      ++nextChunk;
+    } catch (...) {
+      // wakes the threads waiting for this chunk
+      {
+        std::lock_guard<std::mutex> lock(order);
+        aborted = true;
+      }
+      turn.notify_all();
+      throw;
+    }
+    turn.notify_all();
+  });
+}
+
+// the threads take the next chunk until none is left or a chunk failed
+void AtmosphereSweep::run(size_t chunkCount, const Work& work) {
+  if (chunkCount == 0) return;
+  std::atomic<size_t> nextChunk(0);
+  m_pool.run([&](size_t index) {
+    for (;;) {
+      size_t chunk = nextChunk.fetch_add(1);
+      if (chunk >= chunkCount || m_pool.hasFailed()) return;
+      work(chunk, *m_buffers[index]);
+    }
+  });
+}
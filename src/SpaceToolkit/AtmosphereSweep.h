@@ -0,0 +1,82 @@
+#ifndef ATMOSPHERESWEEP_H_
+#define ATMOSPHERESWEEP_H_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "SpaceToolkit/Atmosphere.h"
+#include "SpaceToolkit/ThreadPool.h"
+
+namespace SpaceToolkit {
+// receives the results of a streaming sweep: n states from index first of
+// the sweep. The calls are serialized and in the order of the heights, so a
+// sink needs no locking, e.g. to write a table to a file. The arrays are
+// valid during the call only.
+class AtmosphereSweepSink {
+ public:
+  virtual ~AtmosphereSweepSink() = default;
+
+  virtual void consume(size_t first, const Length* h, const Temperature* T,
+                       const Pressure* P, const Density* rho, size_t n) = 0;
+};
+
+// Evaluates an atmosphere over large sets of heights on a pool of threads,
+// e.g. to regenerate reference profiles and validation tables. The heights
+// are split into chunks of CHUNK, which with the heights and the three
+// results fit in a 256 kB L2 cache, and the threads take the next chunk from
+// a shared counter until none is left. Every thread has its own buffers, and
+// in the output arrays threads share at most the cache line at a chunk
+// boundary, so there is no false sharing to speak of.
+//
+// The queries of the atmosphere are const and thus run concurrently on the
+// same instance. The calling thread takes part in a sweep, a pool of one
+// thread evaluates serially. If a query throws, the sweep stops handing out
+// chunks and rethrows the first exception, the results of the other chunks
+// are undefined. One sweep runs at a time per pool.
+class AtmosphereSweep {
+ public:
+  static constexpr size_t CHUNK = 8192;
+
+  // threadCount threads including the caller, 0 for one per hardware thread
+  explicit AtmosphereSweep(size_t threadCount = 0);
+
+  AtmosphereSweep(const AtmosphereSweep&) = delete;
+  AtmosphereSweep& operator=(const AtmosphereSweep&) = delete;
+
+  size_t getThreadCount() const;
+
+  // the batch query of the atmosphere, into the caller's arrays
+  void getAtmosphereStateByHeight(const Atmosphere& atmosphere,
+                                  const Length* h, Temperature* T,
+                                  Pressure* P, Density* rho, size_t n);
+
+  // the n heights bottom + i * step, into the caller's arrays or to a sink,
+  // which needs no memory for the whole sweep
+  void getAtmosphereProfile(const Atmosphere& atmosphere, Length bottom,
+                            Length step, Temperature* T, Pressure* P,
+                            Density* rho, size_t n);
+  void getAtmosphereProfile(const Atmosphere& atmosphere, Length bottom,
+                            Length step, size_t n, AtmosphereSweepSink& sink);
+
+ private:
+  // chunk buffers of a thread
+  struct Buffers {
+    std::vector<Length> h;
+    std::vector<Temperature> T;
+    std::vector<Pressure> P;
+    std::vector<Density> rho;
+  };
+
+  using Work = std::function<void(size_t chunk, Buffers& buffers)>;
+
+  // buffers of the caller first, then of the workers
+  std::vector<std::unique_ptr<Buffers>> m_buffers;
+  // last, so that the workers stop before the buffers go
+  ThreadPool m_pool;
+
+  void run(size_t chunkCount, const Work& work);
+};
+}  // namespace SpaceToolkit
+#endif  // ATMOSPHERESWEEP_H_
@@ -0,0 +1,109 @@
+#ifndef CONSTEXPRLAYEREDATMOSPHERE_H_
+#define CONSTEXPRLAYEREDATMOSPHERE_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "SpaceToolkit/ConstexprMath.h"
+#include "SpaceToolkit/LayeredAtmosphere.h"
+#include "SpaceToolkit/SpaceToolkitException.h"
+
+namespace SpaceToolkit {
+// LayeredAtmosphere as a literal type, which evaluates at compile time, e.g.
+// a fixed launch site state or a test table baked into the binary:
+//
+//   constexpr AtmosphereState launchSite =
+//       USStandardAtmosphere1976::constexprLowerAtmosphere()
+//           .getAtmosphereStateByHeight(1200_m);
+//
+// Invalid layers or heights out of range throw, which is a compile error in a
+// constant expression. At run time LayeredAtmosphere is the faster choice,
+// see toLayeredAtmosphere.
+template <size_t N>
+class ConstexprLayeredAtmosphere {
+ public:
+  constexpr ConstexprLayeredAtmosphere(const AtmosphereLayer (&layers)[N],
+                                       Length topHeight,
+                                       Temperature baseTemperature,
+                                       Pressure basePressure,
+                                       MolarMass molarMass,
+                                       Acceleration gravity)
+      : m_layers(),
+        m_T_b(),
+        m_P_b(),
+        m_topHeight(topHeight),
+        m_molarMass(molarMass),
+        m_gravity(gravity) {
+    double gMPerR = (gravity * molarMass / R).getValue();
+    double T_b = baseTemperature.getValue();
+    double P_b = basePressure.getValue();
+    for (size_t k = 0; k < N; ++k) {
+      Length h_top = k + 1 < N ? layers[k + 1].baseHeight : topHeight;
+      if (!(h_top > layers[k].baseHeight))
+        throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                    __LINE__);
+
+      // carry the state at the top of this layer to the base of the next one
+      double L_b = layers[k].lapseRate.getValue();
+      double dh = (h_top - layers[k].baseHeight).getValue();
+      double T_top = T_b + L_b * dh;
+      if (!(T_top > 0.0))
+        throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                    __LINE__);
+
+      m_layers[k] = layers[k];
+      m_T_b[k] = T_b;
+      m_P_b[k] = P_b;
+      P_b *= L_b == 0.0 ? ConstexprMath::exp(-gMPerR * dh / T_b)
+                        : ConstexprMath::pow(T_b / T_top, gMPerR / L_b);
+      T_b = T_top;
+    }
+  }
+
+  constexpr AtmosphereState getAtmosphereStateByHeight(Length h) const {
+    if (!(h >= getBottomHeight() && h <= m_topHeight))
+      throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                  __LINE__);
+
+    // the layer k with h_b[k] < h <= h_b[k + 1]
+    size_t k = 0;
+    while (k + 1 < N && h > m_layers[k + 1].baseHeight) ++k;
+
+    double gMPerR = (m_gravity * m_molarMass / R).getValue();
+    double L_b = m_layers[k].lapseRate.getValue();
+    double dh = (h - m_layers[k].baseHeight).getValue();
+    double T = m_T_b[k] + L_b * dh;
+    double P = m_P_b[k] *
+               (L_b == 0.0 ? ConstexprMath::exp(-gMPerR * dh / m_T_b[k])
+                           : ConstexprMath::pow(m_T_b[k] / T, gMPerR / L_b));
+
+    return {Temperature(T), Pressure(P),
+            Density(P * (m_molarMass / R).getValue() / T)};
+  }
+
+  constexpr size_t getLayerCount() const { return N; }
+  constexpr AtmosphereLayer getLayer(size_t k) const { return m_layers[k]; }
+  constexpr Length getBottomHeight() const { return m_layers[0].baseHeight; }
+  constexpr Length getTopHeight() const { return m_topHeight; }
+  constexpr Temperature getBaseTemperature() const { return m_T_b[0]; }
+  constexpr Pressure getBasePressure() const { return m_P_b[0]; }
+  constexpr MolarMass getMolarMass() const { return m_molarMass; }
+  constexpr Acceleration getGravity() const { return m_gravity; }
+
+  // the same model for run time queries
+  LayeredAtmosphere toLayeredAtmosphere() const {
+    std::vector<AtmosphereLayer> layers(m_layers, m_layers + N);
+    return LayeredAtmosphere(layers, m_topHeight, getBaseTemperature(),
+                             getBasePressure(), m_molarMass, m_gravity);
+  }
+
+ private:
+  AtmosphereLayer m_layers[N];
+  double m_T_b[N];
+  double m_P_b[N];
+  Length m_topHeight;
+  MolarMass m_molarMass;
+  Acceleration m_gravity;
+};
+}  // namespace SpaceToolkit
+#endif  // CONSTEXPRLAYEREDATMOSPHERE_H_
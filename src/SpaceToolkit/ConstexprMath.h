@@ -0,0 +1,97 @@
+#ifndef CONSTEXPRMATH_H_
+#define CONSTEXPRMATH_H_
+
+namespace SpaceToolkit {
+// exp, log and pow which can be evaluated at compile time, unlike the libm
+// calls behind Pexp and Ppow. They use the range reductions of Simd::exp and
+// Simd::log with Taylor series and are accurate to a few ulp; exp expects
+// arguments in [-708, 709], log and pow expect normal positive numbers.
+namespace ConstexprMath {
+constexpr double LN2_HI = 6.93147180369123816490e-01;
+constexpr double LN2_LO = 1.90821492927058770002e-10;
+constexpr double LOG2E = 1.44269504088896338700e+00;
+constexpr double SQRT2 = 1.41421356237309504880e+00;
+constexpr double TWO_64 = 18446744073709551616.0;  // 2^64
+
+// 2^k by squaring, exact for the normal range
+constexpr double exp2(long long k) {
+  double base = k < 0 ? 0.5 : 2.0;
+  unsigned long long n = k < 0 ? -k : k;
+  double result = 1.0;
+  while (n > 0) {
+    if (n & 1) result *= base;
+    n >>= 1;
+    if (n > 0) base *= base;
+  }
+  return result;
+}
+
+constexpr double exp(double x) {
+  // x = k ln2 + r with |r| <= ln2 / 2
+  double kd = x * LOG2E;
+  long long k = static_cast<long long>(kd < 0.0 ? kd - 0.5 : kd + 0.5);
+  double r = (x - k * LN2_HI) - k * LN2_LO;
+
+  // Taylor series of exp(r), the remainder is below 2e-16
+  double p = 1.0 / 479001600.0;
+  p = p * r + 1.0 / 39916800.0;
+  p = p * r + 1.0 / 3628800.0;
+  p = p * r + 1.0 / 362880.0;
+  p = p * r + 1.0 / 40320.0;
+  p = p * r + 1.0 / 5040.0;
+  p = p * r + 1.0 / 720.0;
+  p = p * r + 1.0 / 120.0;
+  p = p * r + 1.0 / 24.0;
+  p = p * r + 1.0 / 6.0;
+  p = p * r + 0.5;
+  p = p * r + 1.0;
+  p = p * r + 1.0;
+
+  return p * exp2(k);
+}
+
+constexpr double log(double x) {
+  // x = 2^e * m with m in [sqrt(2) / 2, sqrt(2)), by steps of 2^64 first
+  double m = x;
+  double e = 0.0;
+  while (m >= TWO_64) {
+    m /= TWO_64;
+    e += 64.0;
+  }
+  while (m < 1.0 / TWO_64) {
+    m *= TWO_64;
+    e -= 64.0;
+  }
+  while (m >= SQRT2) {
+    m /= 2.0;
+    e += 1.0;
+  }
+  while (m < SQRT2 / 2) {
+    m *= 2.0;
+    e -= 1.0;
+  }
+
+  // log(m) = 2 atanh(s) with s = (m - 1) / (m + 1), |s| <= 0.1716
+  double s = (m - 1.0) / (m + 1.0);
+  double s2 = s * s;
+  double p = 1.0 / 21.0;
+  p = p * s2 + 1.0 / 19.0;
+  p = p * s2 + 1.0 / 17.0;
+  p = p * s2 + 1.0 / 15.0;
+  p = p * s2 + 1.0 / 13.0;
+  p = p * s2 + 1.0 / 11.0;
+  p = p * s2 + 1.0 / 9.0;
+  p = p * s2 + 1.0 / 7.0;
+  p = p * s2 + 1.0 / 5.0;
+  p = p * s2 + 1.0 / 3.0;
+
+  return e * LN2_HI + (2.0 * s + (2.0 * s * s2 * p + e * LN2_LO));
+}
+
+constexpr double pow(double base, double exponent) {
+  return base == 1.0 ? 1.0 : exp(exponent * log(base));
+}
+}  // namespace ConstexprMath
+}  // namespace SpaceToolkit
+
+#endif  // CONSTEXPRMATH_H_
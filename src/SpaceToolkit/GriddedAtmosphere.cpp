@@ -0,0 +1,533 @@
+#include "SpaceToolkit/GriddedAtmosphere.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+#include "SpaceToolkit/Simd.h"
+
+#if defined(__GNUC__)
+#define SPACETOOLKIT_PREFETCH(p) __builtin_prefetch(p)
+#else
+#define SPACETOOLKIT_PREFETCH(p)
+#endif
+
+using SpaceToolkit::AtmosphereState;
+using SpaceToolkit::GridAxis;
+using SpaceToolkit::GriddedAtmosphere;
+using SpaceToolkit::GriddedAtmosphereGrid;
+using SpaceToolkit::GriddedAtmosphereTable;
+using SpaceToolkit::SpaceToolkitException;
+
+namespace {
+// header of version 1 of the table file
+struct FileHeader {
+  char magic[8];       // "STKGRID" and a zero
+  uint32_t version;
+  uint32_t byteOrder;  // ORDER_MARK in the byte order of the writer
+  uint32_t latitudeCount;
+  uint32_t longitudeCount;
+  uint32_t heightCount;
+  uint32_t timeCount;
+  uint32_t latitudeShift;  // log2 of the block size in latitude
+  uint32_t longitudeShift;
+  uint32_t heightShift;
+  uint32_t reserved;
+  double latitudeFirst;
+  double latitudeStep;
+  double longitudeFirst;
+  double longitudeStep;
+  double timeFirst;
+  double timeStep;
+  uint64_t heightOffset;  // bytes from the start of the file
+  uint64_t nodeOffset;
+  uint64_t nodeBytes;
+  uint64_t reservedBytes;
+};
+static_assert(sizeof(FileHeader) == 128, "the header has 128 bytes");
+
+constexpr char MAGIC[8] = {'S', 'T', 'K', 'G', 'R', 'I', 'D', '\0'};
+constexpr uint32_t VERSION = 1;
+constexpr uint32_t ORDER_MARK = 0x01020304;
+constexpr uint32_t MAX_BLOCK_SHIFT = 8;
+constexpr uint64_t NODE_ALIGNMENT = 4096;
+
+// block size of the writer, 4 x 4 x 8 nodes of 24 bytes are 3 kB
+constexpr uint32_t LATITUDE_SHIFT = 2;
+constexpr uint32_t LONGITUDE_SHIFT = 2;
+constexpr uint32_t HEIGHT_SHIFT = 3;
+
+// batch queries are evaluated in chunks, which keeps the logarithms on the
+// stack
+constexpr size_t CHUNK = 1024;
+
+// points of the batch query whose nodes are prefetched together
+constexpr size_t PREFETCH_GROUP = 16;
+
+// a * b, false on overflow
+bool multiply(uint64_t a, uint64_t b, uint64_t& product) {
+  if (a != 0 && b > std::numeric_limits<uint64_t>::max() / a) return false;
+  product = a * b;
+  return true;
+}
+
+uint64_t blockCount(uint64_t count, uint32_t shift) {
+  return (count + (uint64_t(1) << shift) - 1) >> shift;
+}
+
+bool validAxis(uint32_t count, double first, double step) {
+  if (count == 0 || !std::isfinite(first)) return false;
+  return count == 1 || (std::isfinite(step) && step > 0.0);
+}
+
+GridAxis axisOf(uint32_t count, double first, double step) {
+  return {first, step, count};
+}
+
+// node i and the weight of node next = i + 1 of a coordinate on an axis,
+// throws if the coordinate is out of range
+void cellOf(const GridAxis& axis, double x, size_t& i, size_t& next,
+            double& weight) {
+  if (axis.count == 1) {
+    if (std::isnan(x))
+      throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                  __LINE__);
+    i = next = 0;
+    weight = 0.0;
+    return;
+  }
+
+  double s = (x - axis.first) / axis.step;
+  if (!(s >= 0.0 && s <= static_cast<double>(axis.count - 1)))
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+  i = std::min(static_cast<size_t>(s), axis.count - 2);
+  next = i + 1;
+  weight = s - static_cast<double>(i);
+}
+
+// pressures and densities of the interpolated logarithms
+SPACETOOLKIT_TARGET_CLONES
+void pressureKernel(const double* lnP, Pressure* P, size_t n) {
+  for (size_t i = 0; i < n; ++i)
+    P[i] = Pressure(SpaceToolkit::Simd::exp(lnP[i]));
+}
+
+SPACETOOLKIT_TARGET_CLONES
+void densityKernel(const double* lnRho, Density* rho, size_t n) {
+  for (size_t i = 0; i < n; ++i)
+    rho[i] = Density(SpaceToolkit::Simd::exp(lnRho[i]));
+}
+}  // namespace
+
+GriddedAtmosphereTable::GriddedAtmosphereTable(const std::string& path)
+    : m_map(MAP_FAILED), m_mappedSize(0) {
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    throw SpaceToolkitException("errFileAccess", __FILE__, __LINE__);
+
+  struct stat status;
+  bool empty = false;
+  if (::fstat(fd, &status) == 0) {
+    empty = status.st_size == 0;
+    m_mappedSize = static_cast<size_t>(status.st_size);
+    if (!empty)
+      m_map = ::mmap(nullptr, m_mappedSize, PROT_READ, MAP_SHARED, fd, 0);
+  }
+  // the mapping keeps the file open
+  ::close(fd);
+  // an empty file cannot be mapped, but it is readable and has no header
+  if (empty) throw SpaceToolkitException("errFileFormat", __FILE__, __LINE__);
+  if (m_map == MAP_FAILED)
+    throw SpaceToolkitException("errFileAccess", __FILE__, __LINE__);
+
+  try {
+    readHeader();
+    m_buckets = UniformBuckets(m_heights, m_heightCount);
+  } catch (...) {
+    ::munmap(m_map, m_mappedSize);
+    throw;
+  }
+}
+
+GriddedAtmosphereTable::~GriddedAtmosphereTable() {
+  ::munmap(m_map, m_mappedSize);
+}
+
+// checks the header and sets up the axes and the pointers into the mapping
+void GriddedAtmosphereTable::readHeader() {
+  if (m_mappedSize < sizeof(FileHeader))
+    throw SpaceToolkitException("errFileFormat", __FILE__, __LINE__);
+  FileHeader header;
+  std::memcpy(&header, m_map, sizeof(header));
+
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      header.version != VERSION || header.byteOrder != ORDER_MARK ||
+      header.heightCount < 2 ||
+      !validAxis(header.latitudeCount, header.latitudeFirst,
+                 header.latitudeStep) ||
+      !validAxis(header.longitudeCount, header.longitudeFirst,
+                 header.longitudeStep) ||
+      !validAxis(header.timeCount, header.timeFirst, header.timeStep) ||
+      header.latitudeShift > MAX_BLOCK_SHIFT ||
+      header.longitudeShift > MAX_BLOCK_SHIFT ||
+      header.heightShift > MAX_BLOCK_SHIFT)
+    throw SpaceToolkitException("errFileFormat", __FILE__, __LINE__);
+
+  m_latitude = axisOf(header.latitudeCount, header.latitudeFirst,
+                      header.latitudeStep);
+  m_longitude = axisOf(header.longitudeCount, header.longitudeFirst,
+                       header.longitudeStep);
+  m_time = axisOf(header.timeCount, header.timeFirst, header.timeStep);
+  m_heightCount = header.heightCount;
+  m_latitudeShift = header.latitudeShift;
+  m_longitudeShift = header.longitudeShift;
+  m_heightShift = header.heightShift;
+  m_latitudeBlockCount = blockCount(header.latitudeCount, m_latitudeShift);
+  m_longitudeBlockCount = blockCount(header.longitudeCount, m_longitudeShift);
+  m_heightBlockCount = blockCount(header.heightCount, m_heightShift);
+
+  // the sections are aligned for doubles and lie within the file
+  uint64_t nodeBytes = (3 * sizeof(double))
+                       << (m_latitudeShift + m_longitudeShift + m_heightShift);
+  bool valid = multiply(nodeBytes, m_latitudeBlockCount, nodeBytes) &&
+               multiply(nodeBytes, m_longitudeBlockCount, nodeBytes) &&
+               multiply(nodeBytes, m_heightBlockCount, nodeBytes) &&
+               multiply(nodeBytes, header.timeCount, nodeBytes) &&
+               nodeBytes == header.nodeBytes;
+  valid = valid && header.heightOffset % sizeof(double) == 0 &&
+          header.heightOffset >= sizeof(FileHeader) &&
+          header.heightOffset <= m_mappedSize &&
+          (m_mappedSize - header.heightOffset) / sizeof(double) >=
+              m_heightCount;
+  valid = valid && header.nodeOffset % sizeof(double) == 0 &&
+          header.nodeOffset <= m_mappedSize &&
+          m_mappedSize - header.nodeOffset >= nodeBytes;
+  if (!valid)
+    throw SpaceToolkitException("errFileFormat", __FILE__, __LINE__);
+
+  const char* base = static_cast<const char*>(m_map);
+  m_heights = reinterpret_cast<const double*>(base + header.heightOffset);
+  m_nodes = reinterpret_cast<const double*>(base + header.nodeOffset);
+
+  for (size_t k = 0; k < m_heightCount; ++k) {
+    if (!std::isfinite(m_heights[k]) ||
+        (k > 0 && !(m_heights[k] > m_heights[k - 1])))
+      throw SpaceToolkitException("errFileFormat", __FILE__, __LINE__);
+  }
+}
+
+void GriddedAtmosphereTable::write(
+    const std::string& path, const GriddedAtmosphereGrid& grid,
+    const std::function<AtmosphereState(double latitude, double longitude,
+                                        Length h, Time t)>& state) {
+  const uint64_t MAX_COUNT = std::numeric_limits<uint32_t>::max();
+  size_t heightCount = grid.heights.size();
+  bool valid = heightCount >= 2 && heightCount <= MAX_COUNT;
+  for (const GridAxis& axis : {grid.latitude, grid.longitude, grid.time})
+    valid = valid && axis.count <= MAX_COUNT &&
+            validAxis(static_cast<uint32_t>(axis.count), axis.first,
+                      axis.step);
+  for (size_t k = 0; k < heightCount && valid; ++k)
+    valid = std::isfinite(grid.heights[k].getValue()) &&
+            (k == 0 || grid.heights[k] > grid.heights[k - 1]);
+  if (!valid)
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+
+  FileHeader header = {};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.byteOrder = ORDER_MARK;
+  header.latitudeCount = static_cast<uint32_t>(grid.latitude.count);
+  header.longitudeCount = static_cast<uint32_t>(grid.longitude.count);
+  header.heightCount = static_cast<uint32_t>(heightCount);
+  header.timeCount = static_cast<uint32_t>(grid.time.count);
+  header.latitudeShift = LATITUDE_SHIFT;
+  header.longitudeShift = LONGITUDE_SHIFT;
+  header.heightShift = HEIGHT_SHIFT;
+  header.latitudeFirst = grid.latitude.first;
+  header.latitudeStep = grid.latitude.step;
+  header.longitudeFirst = grid.longitude.first;
+  header.longitudeStep = grid.longitude.step;
+  header.timeFirst = grid.time.first;
+  header.timeStep = grid.time.step;
+
+  uint64_t latitudeBlocks = blockCount(grid.latitude.count, LATITUDE_SHIFT);
+  uint64_t longitudeBlocks = blockCount(grid.longitude.count, LONGITUDE_SHIFT);
+  uint64_t heightBlocks = blockCount(heightCount, HEIGHT_SHIFT);
+  const size_t LATITUDE_SIZE = size_t(1) << LATITUDE_SHIFT;
+  const size_t LONGITUDE_SIZE = size_t(1) << LONGITUDE_SHIFT;
+  const size_t HEIGHT_SIZE = size_t(1) << HEIGHT_SHIFT;
+  const size_t BLOCK_SIZE = LATITUDE_SIZE * LONGITUDE_SIZE * HEIGHT_SIZE;
+
+  header.heightOffset = sizeof(FileHeader);
+  uint64_t heightEnd = header.heightOffset + heightCount * sizeof(double);
+  header.nodeOffset =
+      (heightEnd + NODE_ALIGNMENT - 1) / NODE_ALIGNMENT * NODE_ALIGNMENT;
+  header.nodeBytes = 3 * sizeof(double) * BLOCK_SIZE * latitudeBlocks *
+                     longitudeBlocks * heightBlocks * grid.time.count;
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) throw SpaceToolkitException("errFileAccess", __FILE__, __LINE__);
+
+  std::vector<double> heights(heightCount);
+  for (size_t k = 0; k < heightCount; ++k)
+    heights[k] = grid.heights[k].getValue();
+  std::vector<char> padding(header.nodeOffset - heightEnd, 0);
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char*>(heights.data()),
+             heightCount * sizeof(double));
+  file.write(padding.data(), padding.size());
+
+  // the blocks in the order of the file, nodes beyond the grid are zero
+  std::vector<double> block(3 * BLOCK_SIZE);
+  for (size_t it = 0; it < grid.time.count; ++it) {
+    Time t(grid.time.first + it * grid.time.step);
+    for (size_t bLat = 0; bLat < latitudeBlocks; ++bLat) {
+      for (size_t bLon = 0; bLon < longitudeBlocks; ++bLon) {
+        for (size_t bH = 0; bH < heightBlocks; ++bH) {
+          std::fill(block.begin(), block.end(), 0.0);
+          double* node = block.data();
+          for (size_t k = 0; k < HEIGHT_SIZE; ++k) {
+            for (size_t i = 0; i < LATITUDE_SIZE; ++i) {
+              for (size_t j = 0; j < LONGITUDE_SIZE; ++j, node += 3) {
+                size_t iLat = bLat * LATITUDE_SIZE + i;
+                size_t iLon = bLon * LONGITUDE_SIZE + j;
+                size_t iH = bH * HEIGHT_SIZE + k;
+                if (iLat >= grid.latitude.count ||
+                    iLon >= grid.longitude.count || iH >= heightCount)
+                  continue;
+
+                AtmosphereState s =
+                    state(grid.latitude.first + iLat * grid.latitude.step,
+                          grid.longitude.first + iLon * grid.longitude.step,
+                          grid.heights[iH], t);
+                if (!(s.T.getValue() > 0.0 && s.P.getValue() > 0.0 &&
+                      s.rho.getValue() > 0.0))
+                  throw SpaceToolkitException("errInputParameterOutOfRange",
+                                              __FILE__, __LINE__);
+                node[0] = s.T.getValue();
+                node[1] = std::log(s.P.getValue());
+                node[2] = std::log(s.rho.getValue());
+              }
+            }
+          }
+          file.write(reinterpret_cast<const char*>(block.data()),
+                     block.size() * sizeof(double));
+        }
+      }
+    }
+  }
+
+  if (!file) throw SpaceToolkitException("errFileAccess", __FILE__, __LINE__);
+}
+
+AtmosphereState GriddedAtmosphereTable::getAtmosphereState(double latitude,
+                                                           double longitude,
+                                                           Length h,
+                                                           Time t) const {
+  Node node = interpolate(columnsAt(latitude, longitude, t), h);
+  return {Temperature(node.T), Pressure(Fexp(Number(node.lnP)).getValue()),
+          Density(Fexp(Number(node.lnRho)).getValue())};
+}
+
+void GriddedAtmosphereTable::getAtmosphereState(
+    const double* latitude, const double* longitude, const Length* h,
+    const Time* t, Temperature* T, Pressure* P, Density* rho, size_t n) const {
+  double lnP[CHUNK];
+  double lnRho[CHUNK];
+  for (size_t i = 0; i < n; i += CHUNK) {
+    size_t m = std::min(CHUNK, n - i);
+    for (size_t g = 0; g < m; g += PREFETCH_GROUP) {
+      // the nodes of a group are requested before the first is read, so
+      // their cache misses overlap
+      size_t end = std::min(m, g + PREFETCH_GROUP);
+      Columns columns[PREFETCH_GROUP];
+      size_t levels[PREFETCH_GROUP];
+      for (size_t j = g; j < end; ++j) {
+        columns[j - g] =
+            columnsAt(latitude[i + j], longitude[i + j], t[i + j]);
+        levels[j - g] = levelOf(h[i + j]);
+        prefetch(columns[j - g], levels[j - g]);
+      }
+      for (size_t j = g; j < end; ++j) {
+        Node node = interpolate(columns[j - g], h[i + j], levels[j - g]);
+        T[i + j] = Temperature(node.T);
+        lnP[j] = node.lnP;
+        lnRho[j] = node.lnRho;
+      }
+    }
+    pressureKernel(lnP, P + i, m);
+    densityKernel(lnRho, rho + i, m);
+  }
+}
+
+GridAxis GriddedAtmosphereTable::getLatitudeAxis() const { return m_latitude; }
+
+GridAxis GriddedAtmosphereTable::getLongitudeAxis() const {
+  return m_longitude;
+}
+
+GridAxis GriddedAtmosphereTable::getTimeAxis() const { return m_time; }
+
+size_t GriddedAtmosphereTable::getHeightCount() const { return m_heightCount; }
+
+Length GriddedAtmosphereTable::getBottomHeight() const {
+  return Length(m_heights[0]);
+}
+
+Length GriddedAtmosphereTable::getTopHeight() const {
+  return Length(m_heights[m_heightCount - 1]);
+}
+
+size_t GriddedAtmosphereTable::getMappedSize() const { return m_mappedSize; }
+
+GriddedAtmosphereTable::Columns GriddedAtmosphereTable::columnsAt(
+    double latitude, double longitude, Time t) const {
+  size_t iLat[2], iLon[2], iT[2];
+  double wLat, wLon, wT;
+  cellOf(m_latitude, latitude, iLat[0], iLat[1], wLat);
+  cellOf(m_longitude, longitude, iLon[0], iLon[1], wLon);
+  cellOf(m_time, t.getValue(), iT[0], iT[1], wT);
+
+  Columns columns;
+  for (size_t c = 0; c < 8; ++c) {
+    size_t a = c >> 2, b = (c >> 1) & 1, d = c & 1;
+    columns.offset[c] = columnOffset(iLat[a], iLon[b], iT[d]);
+    columns.weight[c] = (a ? wLat : 1.0 - wLat) * (b ? wLon : 1.0 - wLon) *
+                        (d ? wT : 1.0 - wT);
+  }
+  return columns;
+}
+
+// offset in doubles of the node at the lowest level of a column
+size_t GriddedAtmosphereTable::columnOffset(size_t latitude, size_t longitude,
+                                            size_t time) const {
+  size_t blockShift = m_latitudeShift + m_longitudeShift + m_heightShift;
+  size_t latitudeMask = (size_t(1) << m_latitudeShift) - 1;
+  size_t longitudeMask = (size_t(1) << m_longitudeShift) - 1;
+
+  size_t block = (time * m_latitudeBlockCount + (latitude >> m_latitudeShift)) *
+                     m_longitudeBlockCount +
+                 (longitude >> m_longitudeShift);
+  size_t inBlock = ((latitude & latitudeMask) << m_longitudeShift) |
+                   (longitude & longitudeMask);
+  return 3 * (((block * m_heightBlockCount) << blockShift) + inBlock);
+}
+
+// requests the cache lines of the nodes of a level and the level above
+void GriddedAtmosphereTable::prefetch(const Columns& columns,
+                                      size_t level) const {
+  size_t lower = levelOffset(level);
+  size_t upper = levelOffset(level + 1);
+  for (size_t c = 0; c < 8; ++c) {
+    const double* column = m_nodes + columns.offset[c];
+    SPACETOOLKIT_PREFETCH(column + lower);
+    SPACETOOLKIT_PREFETCH(column + lower + 2);
+    SPACETOOLKIT_PREFETCH(column + upper);
+    SPACETOOLKIT_PREFETCH(column + upper + 2);
+  }
+}
+
+void GriddedAtmosphereTable::interpolate(const Columns& columns,
+                                         const Length* h, Temperature* T,
+                                         double* lnP, double* lnRho,
+                                         size_t n) const {
+  for (size_t i = 0; i < n; ++i) {
+    Node node = interpolate(columns, h[i]);
+    T[i] = Temperature(node.T);
+    lnP[i] = node.lnP;
+    lnRho[i] = node.lnRho;
+  }
+}
+
+GriddedAtmosphere::GriddedAtmosphere(const GriddedAtmosphereTable& table,
+                                     double latitude, double longitude, Time t)
+    : m_table(table), m_columns(table.columnsAt(latitude, longitude, t)) {}
+
+Temperature GriddedAtmosphere::getAtmosphereTemperatureByHeight(
+    Length h) const {
+  return Temperature(m_table.interpolate(m_columns, h).T);
+}
+
+Pressure GriddedAtmosphere::getAtmospherePressureByHeight(Length h) const {
+  return getAtmosphereStateByHeight(h).P;
+}
+
+Density GriddedAtmosphere::getAtmosphereDensityByHeight(Length h) const {
+  return getAtmosphereStateByHeight(h).rho;
+}
+
+void GriddedAtmosphere::getAtmosphereTemperatureByHeight(const Length* h,
+                                                         Temperature* T,
+                                                         size_t n) const {
+  checkHeights(h, n);
+  for (size_t i = 0; i < n; ++i)
+    T[i] = Temperature(m_table.interpolate(m_columns, h[i]).T);
+}
+
+void GriddedAtmosphere::getAtmospherePressureByHeight(const Length* h,
+                                                      Pressure* P,
+                                                      size_t n) const {
+  checkHeights(h, n);
+  Temperature T[CHUNK];
+  double lnP[CHUNK];
+  double lnRho[CHUNK];
+  for (size_t i = 0; i < n; i += CHUNK) {
+    size_t m = std::min(CHUNK, n - i);
+    m_table.interpolate(m_columns, h + i, T, lnP, lnRho, m);
+    pressureKernel(lnP, P + i, m);
+  }
+}
+
+void GriddedAtmosphere::getAtmosphereDensityByHeight(const Length* h,
+                                                     Density* rho,
+                                                     size_t n) const {
+  checkHeights(h, n);
+  Temperature T[CHUNK];
+  double lnP[CHUNK];
+  double lnRho[CHUNK];
+  for (size_t i = 0; i < n; i += CHUNK) {
+    size_t m = std::min(CHUNK, n - i);
+    m_table.interpolate(m_columns, h + i, T, lnP, lnRho, m);
+    densityKernel(lnRho, rho + i, m);
+  }
+}
+
+void GriddedAtmosphere::getAtmosphereStateByHeight(const Length* h,
+                                                   Temperature* T, Pressure* P,
+                                                   Density* rho,
+                                                   size_t n) const {
+  checkHeights(h, n);
+  double lnP[CHUNK];
+  double lnRho[CHUNK];
+  for (size_t i = 0; i < n; i += CHUNK) {
+    size_t m = std::min(CHUNK, n - i);
+    m_table.interpolate(m_columns, h + i, T + i, lnP, lnRho, m);
+    pressureKernel(lnP, P + i, m);
+    densityKernel(lnRho, rho + i, m);
+  }
+}
+
+Length GriddedAtmosphere::getBottomHeight() const {
+  return m_table.getBottomHeight();
+}
+
+Length GriddedAtmosphere::getTopHeight() const {
+  return m_table.getTopHeight();
+}
+
+void GriddedAtmosphere::checkHeights(const Length* h, size_t n) const {
+  if (countOutOfRange(h, n, getBottomHeight(), getTopHeight()) > 0)
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+}
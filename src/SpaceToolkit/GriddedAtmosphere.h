@@ -0,0 +1,222 @@
+#ifndef GRIDDEDATMOSPHERE_H_
+#define GRIDDEDATMOSPHERE_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "SpaceToolkit/AtmosphereModel.h"
+#include "SpaceToolkit/FastMath.h"
+#include "SpaceToolkit/SpaceToolkitException.h"
+#include "SpaceToolkit/UniformBuckets.h"
+
+namespace SpaceToolkit {
+// uniform axis of count values first + i * step with step > 0. An axis with a
+// single value is constant, any coordinate on it is accepted.
+struct GridAxis {
+  double first;
+  double step;
+  size_t count;
+};
+
+// grid of a GriddedAtmosphereTable. Latitude and longitude are in degrees
+// without wrap-around, time is in seconds from an epoch of the dataset. The
+// heights are the levels of the source in ascending order, e.g. the model
+// levels of a weather model, and need not be uniform.
+struct GriddedAtmosphereGrid {
+  GridAxis latitude;
+  GridAxis longitude;
+  GridAxis time;
+  std::vector<Length> heights;
+};
+
+// Site specific atmosphere data on a latitude, longitude, height and time
+// grid in a versioned binary file, which is mapped read-only. Opening reads
+// and checks the header and the height levels only, the queries read the
+// nodes in place and the page cache loads them on demand, so a large file
+// opens at once and processes mapping the same file share its pages.
+//
+// A node holds T, ln P and ln rho, the queries interpolate them
+// quadrilinearly and take exp of the logarithms. Pressure and density are
+// thus exact for an exponential profile between two levels. The nodes of a
+// time are stored in blocks of 4 x 4 x 8 nodes in latitude, longitude and
+// height, level by level, so the 8 nodes around a point at one time mostly lie
+// in 4 to 6 cache lines of one block rather than in 8 distant rows. Version 1
+// of the format is
+//
+//   header   128 bytes, see FileHeader in GriddedAtmosphere.cpp
+//   heights  one double per level
+//   blocks   at a multiple of 4096 bytes, three doubles per node
+//
+// in the byte order of the writing machine, which opening checks. Throws
+// errFileAccess if the file cannot be mapped and errFileFormat if it is not a
+// valid table of this version.
+class GriddedAtmosphereTable {
+ public:
+  explicit GriddedAtmosphereTable(const std::string& path);
+  ~GriddedAtmosphereTable();
+
+  GriddedAtmosphereTable(const GriddedAtmosphereTable&) = delete;
+  GriddedAtmosphereTable& operator=(const GriddedAtmosphereTable&) = delete;
+
+  // writes the states at the nodes of the grid to a table file, e.g. to
+  // convert a weather model export
+  static void write(const std::string& path, const GriddedAtmosphereGrid& grid,
+                    const std::function<AtmosphereState(
+                        double latitude, double longitude, Length h, Time t)>&
+                        state);
+
+  // state at a point, throws if a coordinate is out of range
+  AtmosphereState getAtmosphereState(double latitude, double longitude,
+                                     Length h, Time t) const;
+
+  // batch query of n points, which prefetches the nodes of groups of points
+  // so that their cache misses overlap. Works in chunks, if it throws the
+  // earlier chunks are written already.
+  void getAtmosphereState(const double* latitude, const double* longitude,
+                          const Length* h, const Time* t, Temperature* T,
+                          Pressure* P, Density* rho, size_t n) const;
+
+  GridAxis getLatitudeAxis() const;
+  GridAxis getLongitudeAxis() const;
+  GridAxis getTimeAxis() const;
+  size_t getHeightCount() const;
+  Length getBottomHeight() const;
+  Length getTopHeight() const;
+  // bytes of the mapping, the size of the file
+  size_t getMappedSize() const;
+
+ private:
+  friend class GriddedAtmosphere;
+
+  // offsets in doubles of the 8 node columns around a latitude, longitude
+  // and time, and their weights
+  struct Columns {
+    size_t offset[8];
+    double weight[8];
+  };
+
+  // interpolated T, ln P and ln rho
+  struct Node {
+    double T;
+    double lnP;
+    double lnRho;
+  };
+
+  void* m_map;
+  size_t m_mappedSize;
+  const double* m_heights;
+  const double* m_nodes;
+  GridAxis m_latitude;
+  GridAxis m_longitude;
+  GridAxis m_time;
+  size_t m_heightCount;
+  // log2 of the block size in latitude, longitude and height
+  unsigned m_latitudeShift;
+  unsigned m_longitudeShift;
+  unsigned m_heightShift;
+  size_t m_longitudeBlockCount;
+  size_t m_heightBlockCount;
+  size_t m_latitudeBlockCount;
+  UniformBuckets m_buckets;
+
+  void readHeader();
+  Columns columnsAt(double latitude, double longitude, Time t) const;
+  size_t columnOffset(size_t latitude, size_t longitude, size_t time) const;
+  size_t levelOffset(size_t level) const;
+  size_t levelOf(Length h) const;
+  Node interpolate(const Columns& columns, Length h) const;
+  // with the level k of h from levelOf
+  Node interpolate(const Columns& columns, Length h, size_t k) const;
+  void prefetch(const Columns& columns, size_t level) const;
+  void interpolate(const Columns& columns, const Length* h, Temperature* T,
+                   double* lnP, double* lnRho, size_t n) const;
+};
+
+// The atmosphere of a GriddedAtmosphereTable above one site at one time. The
+// weights of the site are computed once, a query costs a search of the
+// levels, 16 nodes and two exp. The table must outlive the atmosphere. The
+// scalar state query is inline, see AtmosphereModel.
+class GriddedAtmosphere final : public AtmosphereModel<GriddedAtmosphere> {
+ public:
+  // throws if the site or the time is out of the range of the table
+  GriddedAtmosphere(const GriddedAtmosphereTable& table, double latitude,
+                    double longitude, Time t);
+
+  Temperature getAtmosphereTemperatureByHeight(Length h) const;
+  Pressure getAtmospherePressureByHeight(Length h) const;
+  Density getAtmosphereDensityByHeight(Length h) const;
+  AtmosphereState getAtmosphereStateByHeight(Length h) const;
+
+  void getAtmosphereTemperatureByHeight(const Length* h, Temperature* T,
+                                        size_t n) const;
+  void getAtmospherePressureByHeight(const Length* h, Pressure* P,
+                                     size_t n) const;
+  void getAtmosphereDensityByHeight(const Length* h, Density* rho,
+                                    size_t n) const;
+  void getAtmosphereStateByHeight(const Length* h, Temperature* T, Pressure* P,
+                                  Density* rho, size_t n) const;
+
+  Length getBottomHeight() const;
+  Length getTopHeight() const;
+
+ private:
+  const GriddedAtmosphereTable& m_table;
+  GriddedAtmosphereTable::Columns m_columns;
+
+  void checkHeights(const Length* h, size_t n) const;
+};
+
+// offset in doubles of the node of a level from the start of its column
+inline size_t GriddedAtmosphereTable::levelOffset(size_t level) const {
+  size_t layerShift = m_latitudeShift + m_longitudeShift;
+  size_t mask = (size_t(1) << m_heightShift) - 1;
+  return 3 * (((level >> m_heightShift) << (layerShift + m_heightShift)) +
+              ((level & mask) << layerShift));
+}
+
+// level k with heights[k] <= h <= heights[k + 1], throws if h is out of range
+inline size_t GriddedAtmosphereTable::levelOf(Length h) const {
+  double x = h.getValue();
+  if (!(x >= m_heights[0] && x <= m_heights[m_heightCount - 1]))
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+  return m_buckets.intervalOf(m_heights, x);
+}
+
+inline GriddedAtmosphereTable::Node GriddedAtmosphereTable::interpolate(
+    const Columns& columns, Length h) const {
+  return interpolate(columns, h, levelOf(h));
+}
+
+inline GriddedAtmosphereTable::Node GriddedAtmosphereTable::interpolate(
+    const Columns& columns, Length h, size_t k) const {
+  double u = (h.getValue() - m_heights[k]) / (m_heights[k + 1] - m_heights[k]);
+  size_t lower = levelOffset(k);
+  size_t upper = levelOffset(k + 1);
+
+  // weighted sums of the nodes below and above h
+  double below[3] = {0.0, 0.0, 0.0};
+  double above[3] = {0.0, 0.0, 0.0};
+  for (size_t c = 0; c < 8; ++c) {
+    const double* column = m_nodes + columns.offset[c];
+    double w = columns.weight[c];
+    for (size_t j = 0; j < 3; ++j) {
+      below[j] += w * column[lower + j];
+      above[j] += w * column[upper + j];
+    }
+  }
+
+  return {below[0] + u * (above[0] - below[0]),
+          below[1] + u * (above[1] - below[1]),
+          below[2] + u * (above[2] - below[2])};
+}
+
+inline AtmosphereState GriddedAtmosphere::getAtmosphereStateByHeight(
+    Length h) const {
+  GriddedAtmosphereTable::Node node = m_table.interpolate(m_columns, h);
+  return {Temperature(node.T), Pressure(Fexp(Number(node.lnP)).getValue()),
+          Density(Fexp(Number(node.lnRho)).getValue())};
+}
+}  // namespace SpaceToolkit
+#endif  // GRIDDEDATMOSPHERE_H_
@@ -0,0 +1,283 @@
+#include "SpaceToolkit/Isentropic.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "SpaceToolkit/FastMath.h"
+#include "SpaceToolkit/Simd.h"
+#include "SpaceToolkit/SpaceToolkitException.h"
+
+using SpaceToolkit::IsentropicTable;
+using SpaceToolkit::MachBranch;
+using SpaceToolkit::SpaceToolkitException;
+
+namespace {
+// the batch queries are evaluated in chunks on the stack
+constexpr size_t CHUNK = 1024;
+
+constexpr int MAX_HALLEY_STEPS = 40;
+
+// the grid is refined from 16 segments by doubling, up to 2^20 segments
+constexpr size_t FIRST_SEGMENT_COUNT = 16;
+constexpr size_t MAX_SEGMENT_COUNT = size_t(1) << 20;
+
+void checkKappa(double kappa) {
+  if (!(kappa > 1.0))
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+}
+
+// ln(A / A*) and its first two derivatives by M. Near Mach 1 the two
+// logarithms cancel to O((M - 1)^2), so they are taken by log1p of M - 1,
+// which is exact there, to keep their errors at the size of the result.
+void logAreaRatio(double M, double k, double& g, double& g1, double& g2) {
+  double X = 1.0 + 0.5 * (k - 1.0) * M * M;
+  double d = M - 1.0;
+  double lnM = std::fabs(d) < 0.5 ? std::log1p(d) : std::log(M);
+  g = -lnM + (k + 1.0) / (2.0 * (k - 1.0)) *
+                 std::log1p((k - 1.0) / (k + 1.0) * d * (M + 1.0));
+
+  // g1 = (M^2 - 1) / (M X) = u / v
+  double u = M * M - 1.0;
+  double v = M * X;
+  double v1 = 1.0 + 1.5 * (k - 1.0) * M * M;
+  g1 = u / v;
+  g2 = (2.0 * M * v - u * v1) / (v * v);
+}
+
+// the grid position s / step of area ratios, s = sqrt(ln(A / A*)), with the
+// branch free Simd log and sqrt
+SPACETOOLKIT_TARGET_CLONES
+void positionKernel(const Number* areaRatio, double* x, size_t n,
+                    double invStep) {
+  for (size_t i = 0; i < n; ++i)
+    x[i] = SpaceToolkit::Simd::sqrt(
+               SpaceToolkit::Simd::log(areaRatio[i].getValue())) *
+           invStep;
+}
+
+// M of the interpolated ln M
+SPACETOOLKIT_TARGET_CLONES
+void machKernel(const double* y, Number* mach, size_t n) {
+  for (size_t i = 0; i < n; ++i)
+    mach[i] = Number(SpaceToolkit::Simd::exp(y[i]));
+}
+
+// M of ln(A / A*) = lnAreaRatio >= 0 on a branch
+double solveMach(double lnAreaRatio, double k, bool supersonic) {
+  if (lnAreaRatio == 0.0) return 1.0;
+
+  // Near Mach 1 ln(A / A*) = 2 / (k + 1) (M - 1)^2 + O((M - 1)^3), far from
+  // it A / A* follows a power of M on both branches
+  double e = (k + 1.0) / (2.0 * (k - 1.0));
+  double sonic = std::sqrt(0.5 * (k + 1.0) * lnAreaRatio);
+  double nearSonic = supersonic ? 1.0 + sonic : 1.0 - sonic;
+  double asymptotic =
+      supersonic
+          ? std::exp(0.5 * (k - 1.0) *
+                     (lnAreaRatio + e * std::log((k + 1.0) / (k - 1.0))))
+          : std::exp(e * std::log(2.0 / (k + 1.0)) - lnAreaRatio);
+
+  double g, g1, g2;
+  double M = asymptotic;
+  if (nearSonic > 0.0) {
+    logAreaRatio(nearSonic, k, g, g1, g2);
+    double residualNearSonic = std::fabs(g - lnAreaRatio);
+    logAreaRatio(asymptotic, k, g, g1, g2);
+    if (residualNearSonic < std::fabs(g - lnAreaRatio)) M = nearSonic;
+  }
+
+  for (int step = 0; step < MAX_HALLEY_STEPS; ++step) {
+    logAreaRatio(M, k, g, g1, g2);
+    g -= lnAreaRatio;
+    double next = M - 2.0 * g * g1 / (2.0 * g1 * g1 - g * g2);
+
+    // a step across Mach 1 or to M <= 0 goes halfway instead
+    if (supersonic ? !(next > 1.0) : !(next < 1.0)) next = 0.5 * (M + 1.0);
+    if (!(next > 0.0)) next = 0.5 * M;
+    if (std::fabs(next - M) <= 4e-16 * M) return next;
+    M = next;
+  }
+  return M;
+}
+}  // namespace
+
+namespace SpaceToolkit {
+namespace Isentropic {
+Number temperatureRatio(Number mach, Number kappa) {
+  double M = mach.getValue();
+  double k = kappa.getValue();
+  checkKappa(k);
+  if (!(M >= 0.0))
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+  return Number(1.0 / (1.0 + 0.5 * (k - 1.0) * M * M));
+}
+
+Number pressureRatio(Number mach, Number kappa) {
+  return Fpow(temperatureRatio(mach, kappa),
+              kappa / (kappa - Number(1.0)));
+}
+
+Number densityRatio(Number mach, Number kappa) {
+  return Fpow(temperatureRatio(mach, kappa),
+              Number(1.0) / (kappa - Number(1.0)));
+}
+
+Number areaRatio(Number mach, Number kappa) {
+  double M = mach.getValue();
+  double k = kappa.getValue();
+  checkKappa(k);
+  if (!(M > 0.0))
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+  return Fpow(Number(2.0 / (k + 1.0) * (1.0 + 0.5 * (k - 1.0) * M * M)),
+              Number((k + 1.0) / (2.0 * (k - 1.0)))) /
+         mach;
+}
+
+Number machFromPressureRatio(Number pressureRatio, Number kappa) {
+  double k = kappa.getValue();
+  checkKappa(k);
+  if (!(pressureRatio.getValue() > 0.0 && pressureRatio.getValue() <= 1.0))
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+  double temperatureTerm =
+      Fpow(pressureRatio, Number(-(k - 1.0) / k)).getValue();
+  return Number(std::sqrt(2.0 / (k - 1.0) * (temperatureTerm - 1.0)));
+}
+
+Number machFromAreaRatio(Number areaRatio, Number kappa, MachBranch branch) {
+  double k = kappa.getValue();
+  checkKappa(k);
+  if (!(areaRatio.getValue() >= 1.0 && areaRatio.getValue() < INFINITY))
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+  return Number(solveMach(std::log(areaRatio.getValue()), k,
+                          branch == MachBranch::SUPERSONIC));
+}
+}  // namespace Isentropic
+}  // namespace SpaceToolkit
+
+IsentropicTable::IsentropicTable(Number kappa, Number maximumAreaRatio,
+                                 double relativeError)
+    : m_kappa(kappa), m_maximumAreaRatio(maximumAreaRatio), m_invStep(0.0) {
+  double k = kappa.getValue();
+  checkKappa(k);
+  if (!(maximumAreaRatio.getValue() > 1.0 &&
+        maximumAreaRatio.getValue() < INFINITY) ||
+      !(relativeError > 0.0))
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+
+  // ln M and d ln M / ds = 2 s X / (M^2 - 1) at s, which tends to
+  // +-sqrt((k + 1) / 2) at Mach 1
+  auto node = [&](double s, bool supersonic, double& y, double& dy) {
+    double M = solveMach(s * s, k, supersonic);
+    y = std::log(M);
+    if (s == 0.0)
+      dy = (supersonic ? 1.0 : -1.0) * std::sqrt(0.5 * (k + 1.0));
+    else
+      dy = 2.0 * s * (1.0 + 0.5 * (k - 1.0) * M * M) /
+           ((M - 1.0) * (M + 1.0));
+  };
+
+  double sMax = std::sqrt(std::log(maximumAreaRatio.getValue()));
+  for (size_t count = FIRST_SEGMENT_COUNT;; count *= 2) {
+    if (count > MAX_SEGMENT_COUNT)
+      throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                  __LINE__);
+
+    double step = sMax / count;
+    bool withinBound = true;
+    for (int branch = 0; branch < 2; ++branch) {
+      bool supersonic = branch == 1;
+      std::vector<double>& c = supersonic ? m_supersonic : m_subsonic;
+      c.resize(4 * count);
+
+      double y0, dy0, y1, dy1;
+      node(0.0, supersonic, y0, dy0);
+      for (size_t j = 0; j < count; ++j) {
+        node((j + 1) * step, supersonic, y1, dy1);
+        double d0 = step * dy0;
+        double d1 = step * dy1;
+        c[4 * j] = y0;
+        c[4 * j + 1] = d0;
+        c[4 * j + 2] = 3.0 * (y1 - y0) - 2.0 * d0 - d1;
+        c[4 * j + 3] = 2.0 * (y0 - y1) + d0 + d1;
+
+        // the error of the Hermite interpolation is largest near the middle
+        double s = (j + 0.5) * step;
+        double M = solveMach(s * s, k, supersonic);
+        double interpolated = std::exp(
+            c[4 * j] +
+            0.5 * (c[4 * j + 1] + 0.5 * (c[4 * j + 2] + 0.5 * c[4 * j + 3])));
+        withinBound = withinBound &&
+                      std::fabs(interpolated - M) <= relativeError * M;
+        y0 = y1;
+        dy0 = dy1;
+      }
+    }
+    if (withinBound) {
+      m_invStep = 1.0 / step;
+      break;
+    }
+  }
+}
+
+Number IsentropicTable::getMach(Number areaRatio, MachBranch branch) const {
+  double x = areaRatio.getValue();
+  if (!(x >= 1.0 && x <= m_maximumAreaRatio.getValue()))
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+
+  double u;
+  size_t j = segmentOf(x, u);
+  const double* c = branch == MachBranch::SUPERSONIC ? &m_supersonic[4 * j]
+                                                     : &m_subsonic[4 * j];
+  return Number(std::exp(c[0] + u * (c[1] + u * (c[2] + u * c[3]))));
+}
+
+void IsentropicTable::getMach(const Number* areaRatio, Number* mach, size_t n,
+                              MachBranch branch) const {
+  double maximum = m_maximumAreaRatio.getValue();
+  for (size_t i = 0; i < n; ++i)
+    if (!(areaRatio[i].getValue() >= 1.0 &&
+          areaRatio[i].getValue() <= maximum))
+      throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                  __LINE__);
+
+  // the cubic with its gather of the coefficients between two kernels
+  const std::vector<double>& c =
+      branch == MachBranch::SUPERSONIC ? m_supersonic : m_subsonic;
+  size_t last = getSegmentCount() - 1;
+  double x[CHUNK];
+  for (size_t i = 0; i < n; i += CHUNK) {
+    size_t m = std::min(CHUNK, n - i);
+    positionKernel(areaRatio + i, x, m, m_invStep);
+    for (size_t l = 0; l < m; ++l) {
+      size_t j = std::min(static_cast<size_t>(x[l]), last);
+      double u = x[l] - static_cast<double>(j);
+      const double* c_j = &c[4 * j];
+      x[l] = c_j[0] + u * (c_j[1] + u * (c_j[2] + u * c_j[3]));
+    }
+    machKernel(x, mach + i, m);
+  }
+}
+
+Number IsentropicTable::getKappa() const { return m_kappa; }
+
+Number IsentropicTable::getMaximumAreaRatio() const {
+  return m_maximumAreaRatio;
+}
+
+size_t IsentropicTable::getSegmentCount() const {
+  return m_subsonic.size() / 4;
+}
+
+size_t IsentropicTable::segmentOf(double areaRatio, double& u) const {
+  double x = std::sqrt(std::log(areaRatio)) * m_invStep;
+  size_t j = std::min(static_cast<size_t>(x), getSegmentCount() - 1);
+  u = x - static_cast<double>(j);
+  return j;
+}
@@ -0,0 +1,72 @@
+#ifndef ISENTROPIC_H_
+#define ISENTROPIC_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "Physics/PhysicalUnit.h"
+
+using namespace Physics;
+
+namespace SpaceToolkit {
+// branch of the Mach number of an area ratio
+enum class MachBranch { SUBSONIC, SUPERSONIC };
+
+// Isentropic flow of a calorically perfect gas with the heat capacity ratio
+// kappa: the static to stagnation ratios and the area ratio A / A* to the
+// sonic throat at a Mach number, and their inverses. The functions throw if
+// kappa <= 1 or an argument is out of its range.
+namespace Isentropic {
+// T / T_0, p / p_0 and rho / rho_0
+Number temperatureRatio(Number mach, Number kappa);
+Number pressureRatio(Number mach, Number kappa);
+Number densityRatio(Number mach, Number kappa);
+
+// A / A*, which is 1 at Mach 1 and grows on both branches
+Number areaRatio(Number mach, Number kappa);
+
+// the inverse of pressureRatio in closed form, for 0 < p / p_0 <= 1
+Number machFromPressureRatio(Number pressureRatio, Number kappa);
+
+// The Mach number of an area ratio >= 1 on a branch, by Halley's method on
+// ln(A / A*) from a start near Mach 1 or the asymptote of the branch. It
+// converges in 2 to 4 steps to a few ulp, except close to Mach 1, where
+// dM / d(A / A*) is unbounded and the area ratio itself determines M to
+// only about the square root of its rounding.
+Number machFromAreaRatio(Number areaRatio, Number kappa, MachBranch branch);
+}  // namespace Isentropic
+
+// Mach numbers of area ratios for one kappa by interpolation instead of a
+// solver, e.g. for the exit states of many off-design points. Both branches
+// are tabulated as ln M over s = sqrt(ln(A / A*)), in which they are smooth
+// up to Mach 1, by piecewise cubic Hermite polynomials on a uniform grid.
+// The grid is refined at construction until the interpolation is within
+// relativeError of machFromAreaRatio at the segment midpoints.
+class IsentropicTable {
+ public:
+  // throws if kappa <= 1, maximumAreaRatio <= 1 or relativeError <= 0
+  IsentropicTable(Number kappa, Number maximumAreaRatio,
+                  double relativeError = 1e-12);
+
+  // Throw if an area ratio lies outside [1, maximumAreaRatio].
+  Number getMach(Number areaRatio, MachBranch branch) const;
+  void getMach(const Number* areaRatio, Number* mach, size_t n,
+               MachBranch branch) const;
+
+  Number getKappa() const;
+  Number getMaximumAreaRatio() const;
+  size_t getSegmentCount() const;
+
+ private:
+  Number m_kappa;
+  Number m_maximumAreaRatio;
+  double m_invStep;  // segments per unit of s
+  // cubic coefficients of ln M in u in [0, 1] of every segment
+  std::vector<double> m_subsonic;
+  std::vector<double> m_supersonic;
+
+  // the segment and u of an area ratio in range
+  size_t segmentOf(double areaRatio, double& u) const;
+};
+}  // namespace SpaceToolkit
+#endif  // ISENTROPIC_H_
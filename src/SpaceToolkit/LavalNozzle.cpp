@@ -1,53 +1,128 @@
 #include "SpaceToolkit/LavalNozzle.h"
-#include <iostream>
+
+#include <algorithm>
+#include <limits>
+
+#include "SpaceToolkit/FastMath.h"
+#include "SpaceToolkit/Simd.h"
 
 using namespace SpaceToolkit;
 
-LavalNozzle::LavalNozzle(Force desiredThrust, Number exhaustHeatCapacityRatio,
-                         Pressure chamberPressure, Pressure exitPressure)
-    : m_desiredThrust(desiredThrust),
-      m_exhaustHeatCapacityRatio(exhaustHeatCapacityRatio),
-      m_chamberPressure(chamberPressure),
-      m_exitPressure(exitPressure) {}
-
-Area LavalNozzle::throatCrossSectionalArea() {
-  Force F_th = m_desiredThrust;
-  Number kappa = m_exhaustHeatCapacityRatio;
-  Pressure p_c = m_chamberPressure;
-  Pressure p_e = m_exitPressure;
-
-  return (F_th /
-          (p_c * GAMMA() *
-           Psqrt(2 * (kappa / (kappa - Number(1.0)) *
-                      (Number(1.0) -
-                       Ppow(p_e / p_c, (kappa - Number(1.0)) / kappa))))));
-}
+namespace {
+// the batch design runs the kernels chunk by chunk, so the areas are still in
+// L1 when the diameters are taken
+constexpr size_t CHUNK = 1024;
 
-Area LavalNozzle::exitCrossSectionalArea() {
-  Force F_th = m_desiredThrust;
-  Number kappa = m_exhaustHeatCapacityRatio;
-  Pressure p_c = m_chamberPressure;
-  Pressure p_e = m_exitPressure;
-  Area A_t = throatCrossSectionalArea();
+// LavalNozzle::design on arrays, with the branch free Simd pow and sqrt. The
+// diameters are a separate kernel, eight arrays in one loop need more alias
+// checks than GCC versions a loop for.
+SPACETOOLKIT_TARGET_CLONES
+void areaKernel(const Force* F, const Number* kappa, const Pressure* p_c,
+                const Pressure* p_e, Area* A_t, Area* A_e, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    double k = kappa[i].getValue();
+    double p_c_i = p_c[i].getValue();
+    double gamma =
+        Simd::sqrt(k * Simd::pow(2.0 / (k + 1.0), (k + 1.0) / (k - 1.0)));
+    double pressureRatio = p_e[i].getValue() / p_c_i;
+    double pressureRatioTerm = Simd::pow(pressureRatio, (k - 1.0) / k);
+    // p_e >= p_c gives NaN as in the scalar design
+    double velocityTerm = Simd::sqrtOrNaN(2.0 * k / (k - 1.0) *
+                                          (1.0 - pressureRatioTerm));
+    double A_t_i = F[i].getValue() / (p_c_i * gamma * velocityTerm);
+    A_t[i] = Area(A_t_i);
+    A_e[i] = Area(A_t_i * gamma * (pressureRatioTerm / pressureRatio) /
+                  velocityTerm);
+  }
+}
 
-  return A_t * GAMMA() * Ppow(p_e / p_c, -1 / kappa) /
-         Psqrt(2 * kappa / (kappa - Number(1.0)) *
-               (Number(1.0) - Ppow(p_e / p_c, (kappa - Number(1.0)) / kappa)));
+SPACETOOLKIT_TARGET_CLONES
+void diameterKernel(const Area* A_t, const Area* A_e, Length* d_t,
+                    Length* d_e, size_t n) {
+  const double FOUR_PER_PI = 4.0 / PI.getValue();
+  for (size_t i = 0; i < n; ++i) {
+    d_t[i] = Length(Simd::sqrt(FOUR_PER_PI * A_t[i].getValue()));
+    d_e[i] = Length(Simd::sqrt(FOUR_PER_PI * A_e[i].getValue()));
+  }
 }
+}  // namespace
 
-Length LavalNozzle::throatDiameter() {
-  Area A_t = throatCrossSectionalArea();
-  return Psqrt(4 * A_t / PI);
+LavalNozzle::LavalNozzle(Force desiredThrust, Number exhaustHeatCapacityRatio,
+                         Pressure chamberPressure, Pressure exitPressure)
+    : m_design(design(desiredThrust, exhaustHeatCapacityRatio,
+                      chamberPressure, exitPressure)) {}
+
+Area LavalNozzle::throatCrossSectionalArea() const {
+  return m_design.throatCrossSectionalArea;
 }
 
-Length LavalNozzle::exitDiameter() {
-  Area A_e = exitCrossSectionalArea();
-  return Psqrt(4 * A_e / PI);
+Area LavalNozzle::exitCrossSectionalArea() const {
+  return m_design.exitCrossSectionalArea;
 }
 
+Length LavalNozzle::throatDiameter() const { return m_design.throatDiameter; }
+
+Length LavalNozzle::exitDiameter() const { return m_design.exitDiameter; }
+
+Number LavalNozzle::expansionRatio() const { return m_design.expansionRatio; }
+
+const NozzleDesign& LavalNozzle::getDesign() const { return m_design; }
+
 // see https://www.dglr.de/publikationen/2015/340191.pdf for this constant
-Number LavalNozzle::GAMMA() {
-  Number kappa = m_exhaustHeatCapacityRatio;
-  return Psqrt(kappa * (Ppow(2 / (kappa + Number(1.0)),
+Number LavalNozzle::GAMMA(Number exhaustHeatCapacityRatio) {
+  Number kappa = exhaustHeatCapacityRatio;
+  return Psqrt(kappa * (Fpow(2 / (kappa + Number(1.0)),
                              (kappa + Number(1.0)) / (kappa - Number(1.0)))));
 }
+
+NozzleDesign LavalNozzle::design(Force desiredThrust,
+                                 Number exhaustHeatCapacityRatio,
+                                 Pressure chamberPressure,
+                                 Pressure exitPressure) {
+  NozzleDesign d;
+  d.desiredThrust = desiredThrust;
+  d.exhaustHeatCapacityRatio = exhaustHeatCapacityRatio;
+  d.chamberPressure = chamberPressure;
+  d.exitPressure = exitPressure;
+
+  Number kappa = exhaustHeatCapacityRatio;
+  d.GAMMA = GAMMA(kappa);
+
+  d.pressureRatio = exitPressure / chamberPressure;
+  d.pressureRatioTerm = Fpow(d.pressureRatio, (kappa - Number(1.0)) / kappa);
+  // p_e >= p_c has no design, its terms are NaN instead of inf
+  Number velocitySquare = 2 * kappa / (kappa - Number(1.0)) *
+                          (Number(1.0) - d.pressureRatioTerm);
+  Number velocityTerm =
+      velocitySquare > Number(0.0)
+          ? Psqrt(velocitySquare)
+          : Number(std::numeric_limits<double>::quiet_NaN());
+  d.thrustCoefficient = d.GAMMA * velocityTerm;
+
+  // (p_e / p_c)^(-1 / kappa) = pressureRatioTerm / pressureRatio
+  d.expansionRatio =
+      d.GAMMA * (d.pressureRatioTerm / d.pressureRatio) / velocityTerm;
+  d.throatCrossSectionalArea =
+      desiredThrust / (chamberPressure * d.thrustCoefficient);
+  d.exitCrossSectionalArea = d.throatCrossSectionalArea * d.expansionRatio;
+  d.throatDiameter = Psqrt(4 * d.throatCrossSectionalArea / PI);
+  d.exitDiameter = Psqrt(4 * d.exitCrossSectionalArea / PI);
+  return d;
+}
+
+void LavalNozzle::design(const Force* desiredThrust,
+                         const Number* exhaustHeatCapacityRatio,
+                         const Pressure* chamberPressure,
+                         const Pressure* exitPressure,
+                         Area* throatCrossSectionalArea,
+                         Area* exitCrossSectionalArea, Length* throatDiameter,
+                         Length* exitDiameter, size_t n) {
+  for (size_t i = 0; i < n; i += CHUNK) {
+    size_t m = std::min(CHUNK, n - i);
+    areaKernel(desiredThrust + i, exhaustHeatCapacityRatio + i,
+               chamberPressure + i, exitPressure + i,
+               throatCrossSectionalArea + i, exitCrossSectionalArea + i, m);
+    diameterKernel(throatCrossSectionalArea + i, exitCrossSectionalArea + i,
+                   throatDiameter + i, exitDiameter + i, m);
+  }
+}
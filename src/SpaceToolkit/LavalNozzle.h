@@ -6,22 +6,63 @@
 using namespace Physics;
 
 namespace SpaceToolkit {
+// inputs and derived quantities of an ideal nozzle design
+struct NozzleDesign {
+  Force desiredThrust;
+  Number exhaustHeatCapacityRatio;
+  Pressure chamberPressure;
+  Pressure exitPressure;
+
+  // the Vandenkerckhove function of kappa
+  Number GAMMA;
+  // p_e / p_c and (p_e / p_c)^((kappa - 1) / kappa)
+  Number pressureRatio;
+  Number pressureRatioTerm;
+  // thrust coefficient of the momentum thrust, F / (p_c A_t)
+  Number thrustCoefficient;
+  // A_e / A_t
+  Number expansionRatio;
+  Area throatCrossSectionalArea;
+  Area exitCrossSectionalArea;
+  Length throatDiameter;
+  Length exitDiameter;
+};
+
+// Sizes the throat and exit of a nozzle for the desired thrust. The design is
+// computed at construction, the getters return cached values. An exit
+// pressure >= the chamber pressure has no design and gives NaN.
 class LavalNozzle {
  public:
   LavalNozzle(Force desiredThrust, Number exhaustHeatCapacityRatio,
               Pressure chamberPressure, Pressure exitPressure);
-  Area throatCrossSectionalArea();
-  Area exitCrossSectionalArea();
-  Length throatDiameter();
-  Length exitDiameter();
+  Area throatCrossSectionalArea() const;
+  Area exitCrossSectionalArea() const;
+  Length throatDiameter() const;
+  Length exitDiameter() const;
+  Number expansionRatio() const;
+  const NozzleDesign& getDesign() const;
 
- private:
-  Force m_desiredThrust;
-  Number m_exhaustHeatCapacityRatio;
-  Pressure m_chamberPressure;
-  Pressure m_exitPressure;
+  // the Vandenkerckhove function of kappa
+  static Number GAMMA(Number exhaustHeatCapacityRatio);
 
-  Number GAMMA();
+  // the design without a LavalNozzle, with two pow calls
+  static NozzleDesign design(Force desiredThrust,
+                             Number exhaustHeatCapacityRatio,
+                             Pressure chamberPressure, Pressure exitPressure);
+
+  // the geometry of n designs from structure of arrays inputs, in a
+  // vectorized kernel without a LavalNozzle per design. The results agree
+  // with the scalar design to a few ulp of the pow terms.
+  static void design(const Force* desiredThrust,
+                     const Number* exhaustHeatCapacityRatio,
+                     const Pressure* chamberPressure,
+                     const Pressure* exitPressure,
+                     Area* throatCrossSectionalArea,
+                     Area* exitCrossSectionalArea, Length* throatDiameter,
+                     Length* exitDiameter, size_t n);
+
+ private:
+  NozzleDesign m_design;
 };
 }  // namespace SpaceToolkit
 #endif  // LAVALNOZZLE_H_
@@ -0,0 +1,563 @@
+#include "SpaceToolkit/LayeredAtmosphere.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "SpaceToolkit/Simd.h"
+#include "SpaceToolkit/SpaceToolkitException.h"
+
+using SpaceToolkit::AtmosphereLayer;
+using SpaceToolkit::AtmosphereState;
+using SpaceToolkit::AtmosphereStatus;
+using SpaceToolkit::FloatLayerTable;
+using SpaceToolkit::LayeredAtmosphere;
+using SpaceToolkit::LayerTable;
+using SpaceToolkit::OutOfRangePolicy;
+using SpaceToolkit::SpaceToolkitException;
+namespace Simd = SpaceToolkit::Simd;
+
+namespace {
+constexpr size_t MAX_LAYER_COUNT = LayerTable::MAX_LAYER_COUNT;
+
+// branch free search for the layer k with h_b[k] < h <= h_b[k + 1] in the
+// batch kernels. Counting the boundaries below h compares against broadcast
+// constants, which vectorizes better than a binary search with its chain of
+// dependent gathers.
+inline size_t layerIndex(double h, const LayerTable& t) {
+  size_t k = 0;
+  for (size_t j = 1; j < MAX_LAYER_COUNT; ++j) k += h > t.h_b[j];
+  return k;
+}
+
+// R / (g * M) * ln(P_b / P), the same expression covers gradient layers
+// (ln(T / T_b) / L_b) and isothermal layers ((h - h_b) / T_b)
+inline double pressureExponent(double dh, double T, size_t k,
+                               const LayerTable& t) {
+  return t.invL_b[k] * Simd::log(T / t.T_b[k]) +
+         t.isothermal[k] * dh / t.T_b[k];
+}
+
+// temperature and pressure at height h in layer k, branch free for the batch
+// kernels
+inline void evaluateLayer(double h, size_t k, const LayerTable& t, double& T,
+                          double& P) {
+  double dh = h - t.h_b[k];
+  T = t.T_b[k] + t.L_b[k] * dh;
+  P = t.P_b[k] * Simd::exp(-t.gMPerR * pressureExponent(dh, T, k, t));
+}
+
+// The kernels take the layer table by value, as a local copy it cannot alias
+// the output array, which keeps the loops vectorizable.
+SPACETOOLKIT_TARGET_CLONES
+void temperatureKernel(const Length* h, Temperature* T, size_t n,
+                       LayerTable t) {
+  for (size_t i = 0; i < n; ++i) {
+    double h_i = h[i].getValue();
+    size_t k = layerIndex(h_i, t);
+    T[i] = Temperature(t.T_b[k] + t.L_b[k] * (h_i - t.h_b[k]));
+  }
+}
+
+SPACETOOLKIT_TARGET_CLONES
+void pressureKernel(const Length* h, Pressure* P, size_t n, LayerTable t) {
+  for (size_t i = 0; i < n; ++i) {
+    double h_i = h[i].getValue();
+    double T_i, P_i;
+    evaluateLayer(h_i, layerIndex(h_i, t), t, T_i, P_i);
+    P[i] = Pressure(P_i);
+  }
+}
+
+SPACETOOLKIT_TARGET_CLONES
+void densityKernel(const Length* h, Density* rho, size_t n, LayerTable t) {
+  for (size_t i = 0; i < n; ++i) {
+    double h_i = h[i].getValue();
+    double T_i, P_i;
+    evaluateLayer(h_i, layerIndex(h_i, t), t, T_i, P_i);
+    rho[i] = Density(P_i * t.MPerR / T_i);  // ideal gas law
+  }
+}
+
+SPACETOOLKIT_TARGET_CLONES
+void stateKernel(const Length* h, Temperature* T, Pressure* P, Density* rho,
+                 size_t n, LayerTable t) {
+  for (size_t i = 0; i < n; ++i) {
+    double h_i = h[i].getValue();
+    double T_i, P_i;
+    evaluateLayer(h_i, layerIndex(h_i, t), t, T_i, P_i);
+    T[i] = Temperature(T_i);
+    P[i] = Pressure(P_i);
+    rho[i] = Density(P_i * t.MPerR / T_i);  // ideal gas law
+  }
+}
+// stateKernel in single precision. 32 bit layer indices keep the gathers at
+// the width of the float lanes. Heights are clamped to [bottom, top], the
+// range check of the float heights is rounded to single precision.
+//
+// P = P_b (T / T_b)^-e is sensitive to T for exponents e up to 34, so the
+// ratio T / T_b = 1 + x is taken from x = L_b / T_b * (h - h_b) and ln(1 + x)
+// is corrected for the rounding of 1 + x.
+SPACETOOLKIT_TARGET_CLONES
+void floatStateKernel(const float* h, float* T, float* P, float* rho,
+                      size_t n, FloatLayerTable t, float bottom, float top) {
+  for (size_t i = 0; i < n; ++i) {
+    float h_i = h[i];
+    h_i = h_i > bottom ? h_i : bottom;
+    h_i = h_i < top ? h_i : top;
+    int k = 0;
+    for (size_t j = 1; j < MAX_LAYER_COUNT; ++j) k += h_i > t.h_b[j];
+
+    float dh = h_i - t.h_b[k];
+    float x = t.LPerT_b[k] * dh;
+    float u = 1.0f + x;
+    float lnRatio = u == 1.0f ? x : Simd::log(u) * (x / (u - 1.0f));
+    float T_i = t.T_b[k] * u;
+    float P_i = t.P_b[k] *
+                Simd::exp(-(t.exponent[k] * lnRatio + t.gMPerRT_b[k] * dh));
+    T[i] = T_i;
+    P[i] = P_i;
+    rho[i] = P_i * t.MPerR / T_i;  // ideal gas law
+  }
+}
+
+// layer k of a pressure or density x with base[k] >= x > base[k + 1]. The
+// base values decrease with height and unused entries are 0, so they are
+// never counted.
+inline size_t layerIndexByValue(double x, const double* base) {
+  size_t k = 0;
+  for (size_t j = 1; j < MAX_LAYER_COUNT; ++j) k += x < base[j];
+  return k;
+}
+
+// height in layer k at which pressure or density has fallen by the ratio
+// base[k] / x: T_b / L_b * (ratio^(1 / e) - 1) above h_b with the exponent e
+// of the quantity in gradient layers, T_b / (g * M / R) * ln(ratio) in
+// isothermal layers. Branch free for the batch kernels.
+inline double heightOfRatio(double lnRatio, size_t k,
+                            const double* invExponent, const LayerTable& t) {
+  return t.h_b[k] +
+         t.T_b[k] * (t.invL_b[k] * (Simd::exp(lnRatio * invExponent[k]) - 1.0) +
+                     t.isothermal[k] * lnRatio / t.gMPerR);
+}
+
+SPACETOOLKIT_TARGET_CLONES
+void pressureHeightKernel(const Pressure* P, Length* h, size_t n,
+                          LayerTable t) {
+  for (size_t i = 0; i < n; ++i) {
+    double P_i = P[i].getValue();
+    size_t k = layerIndexByValue(P_i, t.P_b);
+    h[i] = Length(heightOfRatio(Simd::log(t.P_b[k] / P_i), k, t.invExponent,
+                                t));
+  }
+}
+
+SPACETOOLKIT_TARGET_CLONES
+void densityHeightKernel(const Density* rho, Length* h, size_t n,
+                         LayerTable t) {
+  for (size_t i = 0; i < n; ++i) {
+    double rho_i = rho[i].getValue();
+    size_t k = layerIndexByValue(rho_i, t.Rho_b);
+    h[i] = Length(heightOfRatio(Simd::log(t.Rho_b[k] / rho_i), k,
+                                t.invDensityExponent, t));
+  }
+}
+
+// state kernel for inputs with heights out of range, which are evaluated at
+// the nearest valid height. NaN heights are evaluated at the bottom.
+SPACETOOLKIT_TARGET_CLONES
+void clampedStateKernel(const Length* h, Temperature* T, Pressure* P,
+                        Density* rho, size_t n, LayerTable t, double bottom,
+                        double top) {
+  for (size_t i = 0; i < n; ++i) {
+    double h_i = h[i].getValue();
+    h_i = h_i > bottom ? h_i : bottom;
+    h_i = h_i < top ? h_i : top;
+    double T_i, P_i;
+    evaluateLayer(h_i, layerIndex(h_i, t), t, T_i, P_i);
+    T[i] = Temperature(T_i);
+    P[i] = Pressure(P_i);
+    rho[i] = Density(P_i * t.MPerR / T_i);  // ideal gas law
+  }
+}
+// profiles: the truncation error of the quartic recurrence in a span, the
+// longest span, which bounds the drift from rounding, and the shortest one
+// worth the setup of the recurrence
+constexpr double PROFILE_TOLERANCE = 1e-13;
+constexpr size_t MAX_SPAN = 256;
+constexpr size_t MIN_SPAN = 8;
+
+// m profile points from index i on in a layer, starting at the exact
+// pressure P_0 of point i. With ln P_j = ln P_0 + p(j) and the forward
+// differences d of the quartic p at 0, P_j+1 = P_j exp(dp(j)) and
+// exp(d^k p(j + 1)) = exp(d^k p(j)) exp(d^k+1 p(j)). The factors are kept as
+// exp(.) - 1, which keeps their rounding errors from accumulating.
+void profileSpan(const double d[4], double P_0, size_t i, size_t m, double h0,
+                 double dh, double h_b, double T_b, double L_b, double MPerR,
+                 Temperature* T, Pressure* P, Density* rho) {
+  double r1 = std::expm1(d[0]);
+  double r2 = std::expm1(d[1]);
+  double r3 = std::expm1(d[2]);
+  double r4 = std::expm1(d[3]);
+  double p = P_0;
+  for (size_t j = i; j < i + m; ++j) {
+    double T_j = T_b + L_b * ((h0 + j * dh) - h_b);
+    T[j] = Temperature(T_j);
+    P[j] = Pressure(p);
+    rho[j] = Density(p * MPerR / T_j);
+
+    // (r1 + r2) + r1 r2 instead of r1 + (r2 + r1 r2), which shortens the
+    // dependency chain by one addition
+    p += p * r1;
+    r1 = (r1 + r2) + r1 * r2;
+    r2 = (r2 + r3) + r2 * r3;
+    r3 = (r3 + r4) + r3 * r4;
+  }
+}
+}  // namespace
+
+LayeredAtmosphere::LayeredAtmosphere(const std::vector<AtmosphereLayer>& layers,
+                                     Length topHeight,
+                                     Temperature baseTemperature,
+                                     Pressure basePressure,
+                                     MolarMass molarMass, Acceleration gravity)
+    : m_layerCount(layers.size()),
+      m_topHeight(topHeight),
+      m_molarMass(molarMass),
+      m_gravity(gravity) {
+  if (layers.empty() || layers.size() > MAX_LAYER_COUNT)
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+  for (size_t k = 0; k < layers.size(); ++k) {
+    Length h_top = k + 1 < layers.size() ? layers[k + 1].baseHeight : topHeight;
+    if (!(h_top > layers[k].baseHeight))
+      throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                  __LINE__);
+  }
+
+  m_table.gMPerR = (gravity * molarMass / R).getValue();
+  m_table.MPerR = (molarMass / R).getValue();
+
+  Temperature T_b = baseTemperature;
+  Pressure P_b = basePressure;
+  for (size_t k = 0; k < MAX_LAYER_COUNT; ++k) {
+    if (k >= layers.size()) {
+      // the search compares against h_b[k] only, the rest is never read
+      m_table.h_b[k] = std::numeric_limits<double>::infinity();
+      m_table.T_b[k] = m_table.L_b[k] = m_table.P_b[k] = m_table.Rho_b[k] =
+          m_table.exponent[k] = m_table.invL_b[k] = m_table.isothermal[k] =
+              m_table.invExponent[k] = m_table.invDensityExponent[k] = 0.0;
+      continue;
+    }
+
+    LapseRate L_b = layers[k].lapseRate;
+    bool isothermal = L_b == 0_Kpm;
+    Number exponent =
+        isothermal ? Number(0.0) : gravity * molarMass / (R * L_b);
+
+    m_table.h_b[k] = layers[k].baseHeight.getValue();
+    m_table.T_b[k] = T_b.getValue();
+    m_table.L_b[k] = L_b.getValue();
+    m_table.P_b[k] = P_b.getValue();
+    m_table.Rho_b[k] = (P_b * molarMass / (R * T_b)).getValue();
+    m_table.exponent[k] = exponent.getValue();
+    m_table.invL_b[k] = isothermal ? 0.0 : 1.0 / L_b.getValue();
+    m_table.isothermal[k] = isothermal ? 1.0 : 0.0;
+    m_table.invExponent[k] = isothermal ? 0.0 : 1.0 / exponent.getValue();
+    m_table.invDensityExponent[k] =
+        isothermal ? 0.0 : 1.0 / (exponent.getValue() + 1.0);
+
+    // carry the state at the top of this layer to the base of the next one
+    Length h_top = k + 1 < layers.size() ? layers[k + 1].baseHeight : topHeight;
+    Length dh = h_top - layers[k].baseHeight;
+    Temperature T_top = T_b + L_b * dh;
+    if (!(T_top > 0_K))
+      throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                  __LINE__);
+
+    P_b = P_b * (isothermal ? Pexp(-1 * gravity * molarMass * dh / (R * T_b))
+                            : Ppow(T_b / T_top, exponent));
+    T_b = T_top;
+  }
+
+  for (size_t k = 0; k < MAX_LAYER_COUNT; ++k) {
+    const LayerTable& t = m_table;
+    bool unused = k >= layers.size();
+    m_floatTable.h_b[k] = static_cast<float>(t.h_b[k]);
+    m_floatTable.T_b[k] = static_cast<float>(t.T_b[k]);
+    m_floatTable.P_b[k] = static_cast<float>(t.P_b[k]);
+    m_floatTable.LPerT_b[k] =
+        unused ? 0.0f : static_cast<float>(t.L_b[k] / t.T_b[k]);
+    m_floatTable.exponent[k] = static_cast<float>(t.exponent[k]);
+    m_floatTable.gMPerRT_b[k] =
+        unused ? 0.0f
+               : static_cast<float>(t.isothermal[k] * t.gMPerR / t.T_b[k]);
+  }
+  m_floatTable.MPerR = static_cast<float>(m_table.MPerR);
+
+  // by the scalar queries, so that their values at the top are in range of
+  // the inverse queries
+  m_topPressure = getAtmospherePressureByHeight(topHeight);
+  m_topDensity = getAtmosphereDensityByHeight(topHeight);
+}
+
+Temperature LayeredAtmosphere::getAtmosphereTemperatureByHeight(
+    Length h) const {
+  size_t k = layerOf(h);
+
+  return Temperature(m_table.T_b[k]) +
+         LapseRate(m_table.L_b[k]) * (h - Length(m_table.h_b[k]));
+}
+
+Pressure LayeredAtmosphere::getAtmospherePressureByHeight(
+    Length h) const {
+  Temperature T;
+  return pressureInLayer(h, layerOf(h), T);
+}
+
+Density LayeredAtmosphere::getAtmosphereDensityByHeight(
+    Length h) const {
+  size_t k = layerOf(h);
+  Length h_b = m_table.h_b[k];
+  Temperature T_b = m_table.T_b[k];
+  Density Rho_b = m_table.Rho_b[k];
+
+  if (m_table.isothermal[k] != 0.0)
+    return Rho_b * Fexp(-1 * m_gravity * m_molarMass * (h - h_b) / (R * T_b));
+
+  Temperature T = T_b + LapseRate(m_table.L_b[k]) * (h - h_b);
+  return Rho_b * Fpow(T_b / T, Number(1.0 + m_table.exponent[k]));
+}
+
+void LayeredAtmosphere::getAtmosphereTemperatureByHeight(const Length* h,
+                                                         Temperature* T,
+                                                         size_t n) const {
+  checkHeights(h, n);
+  temperatureKernel(h, T, n, m_table);
+}
+
+void LayeredAtmosphere::getAtmospherePressureByHeight(const Length* h,
+                                                      Pressure* P,
+                                                      size_t n) const {
+  checkHeights(h, n);
+  pressureKernel(h, P, n, m_table);
+}
+
+void LayeredAtmosphere::getAtmosphereDensityByHeight(const Length* h,
+                                                     Density* rho,
+                                                     size_t n) const {
+  checkHeights(h, n);
+  densityKernel(h, rho, n, m_table);
+}
+
+void LayeredAtmosphere::getAtmosphereStateByHeight(const Length* h,
+                                                   Temperature* T, Pressure* P,
+                                                   Density* rho,
+                                                   size_t n) const {
+  checkHeights(h, n);
+  stateKernel(h, T, P, rho, n, m_table);
+}
+
+void LayeredAtmosphere::getAtmosphereStateByHeight(const float* h, float* T,
+                                                   float* P, float* rho,
+                                                   size_t n) const {
+  float bottom = static_cast<float>(m_table.h_b[0]);
+  float top = static_cast<float>(m_topHeight.getValue());
+  if (countOutOfRange(h, n, bottom, top) > 0)
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+  floatStateKernel(h, T, P, rho, n, m_floatTable, bottom, top);
+}
+
+void LayeredAtmosphere::getAtmosphereProfile(Length bottom, Length step,
+                                             Temperature* T, Pressure* P,
+                                             Density* rho, size_t n) const {
+  if (n == 0) return;
+  Length top = bottom + double(n - 1) * step;
+  if (!(step > 0_m && bottom >= getBottomHeight() && top <= m_topHeight))
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+
+  double h0 = bottom.getValue(), dh = step.getValue();
+  for (size_t i = 0; i < n;) {
+    size_t k = layerSearch(Length(h0 + i * dh));
+    Length h_top = k + 1 < m_layerCount ? Length(m_table.h_b[k + 1])
+                                        : m_topHeight;
+    size_t end = std::max(countProfileUpTo(bottom, step, n, h_top), i + 1);
+    profileInLayer(k, h0, dh, i, end, T, P, rho);
+    i = end;
+  }
+}
+
+// the profile points begin ... end - 1 in layer k
+void LayeredAtmosphere::profileInLayer(size_t k, double h0, double dh,
+                                       size_t begin, size_t end,
+                                       Temperature* T, Pressure* P,
+                                       Density* rho) const {
+  double h_b = m_table.h_b[k], T_b = m_table.T_b[k], L_b = m_table.L_b[k];
+  double e = m_table.exponent[k];
+  bool isothermal = m_table.isothermal[k] != 0.0;
+
+  // the truncation error of the quartic is |e| (a m)^5 / 5 for a span of m
+  // points with a = L dh / T at its start
+  double aSpan =
+      isothermal ? 0.0 : std::pow(5.0 * PROFILE_TOLERANCE / std::fabs(e), 0.2);
+
+  for (size_t i = begin; i < end;) {
+    Temperature T_i;
+    Pressure P_i = pressureInLayer(Length(h0 + i * dh), k, T_i);
+
+    // Taylor coefficients of ln P_i+j - ln P_i = -e ln(1 + a j) in j, or of
+    // -g M dh j / (R T_b) in an isothermal layer
+    double c[4] = {-m_table.gMPerR * dh / T_b, 0.0, 0.0, 0.0};
+    double span = double(MAX_SPAN);
+    if (!isothermal) {
+      double a = L_b * dh / T_i.getValue();
+      c[0] = -e * a;
+      c[1] = e * a * a / 2.0;
+      c[2] = -e * a * a * a / 3.0;
+      c[3] = e * a * a * a * a / 4.0;
+      span = std::min(span, aSpan / std::fabs(a));
+    }
+    size_t m = std::min(static_cast<size_t>(span), end - i);
+
+    if (m < MIN_SPAN) {
+      T[i] = T_i;
+      P[i] = P_i;
+      rho[i] = P_i * m_molarMass / (R * T_i);
+      ++i;
+      continue;
+    }
+
+    // forward differences of the quartic at 0 by the Stirling numbers
+    double d[4] = {c[0] + c[1] + c[2] + c[3],
+                   2.0 * c[1] + 6.0 * c[2] + 14.0 * c[3],
+                   6.0 * c[2] + 36.0 * c[3], 24.0 * c[3]};
+    profileSpan(d, P_i.getValue(), i, m, h0, dh, h_b, T_b, L_b,
+                m_table.MPerR, T, P, rho);
+    i += m;
+  }
+}
+
+AtmosphereStatus LayeredAtmosphere::tryGetAtmosphereStateByHeight(
+    Length h, AtmosphereState& state, OutOfRangePolicy policy) const noexcept {
+  AtmosphereStatus status = AtmosphereStatus::Ok;
+  if (!(h >= getBottomHeight())) {
+    status = AtmosphereStatus::BelowRange;
+    h = getBottomHeight();
+  } else if (h > m_topHeight) {
+    status = AtmosphereStatus::AboveRange;
+    h = m_topHeight;
+  }
+
+  if (status != AtmosphereStatus::Ok && policy == OutOfRangePolicy::NaN) {
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    state = {Temperature(nan), Pressure(nan), Density(nan)};
+    return status;
+  }
+
+  Temperature T;
+  Pressure P = pressureInLayer(h, layerSearch(h), T);
+  state = {T, P, P * m_molarMass / (R * T)};
+  return status;
+}
+
+size_t LayeredAtmosphere::tryGetAtmosphereStateByHeight(
+    const Length* h, Temperature* T, Pressure* P, Density* rho, size_t n,
+    uint64_t* outOfRange, OutOfRangePolicy policy) const noexcept {
+  Length bottom = getBottomHeight();
+  if (countOutOfRange(h, n, bottom, m_topHeight) == 0) {
+    std::fill(outOfRange, outOfRange + (n + 63) / 64, 0);
+    stateKernel(h, T, P, rho, n, m_table);
+    return 0;
+  }
+
+  size_t count = markOutOfRange(h, n, bottom, m_topHeight, outOfRange);
+  clampedStateKernel(h, T, P, rho, n, m_table, bottom.getValue(),
+                     m_topHeight.getValue());
+  if (policy == OutOfRangePolicy::NaN) {
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    for (size_t i = 0; i < n; ++i) {
+      if (!(outOfRange[i / 64] >> (i % 64) & 1)) continue;
+      T[i] = Temperature(nan);
+      P[i] = Pressure(nan);
+      rho[i] = Density(nan);
+    }
+  }
+  return count;
+}
+
+Length LayeredAtmosphere::getHeightByPressure(Pressure P) const {
+  if (!(P >= m_topPressure && P <= getBottomPressure()))
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+
+  const double* P_b = m_table.P_b;
+  size_t k = std::partition_point(P_b + 1, P_b + m_layerCount,
+                                  [P](double b) { return P.getValue() < b; }) -
+             (P_b + 1);
+  return heightInLayer(P_b[k] / P.getValue(), k, m_table.invExponent[k]);
+}
+
+Length LayeredAtmosphere::getHeightByDensity(Density rho) const {
+  if (!(rho >= m_topDensity && rho <= getBottomDensity()))
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+
+  const double* Rho_b = m_table.Rho_b;
+  size_t k =
+      std::partition_point(Rho_b + 1, Rho_b + m_layerCount,
+                           [rho](double b) { return rho.getValue() < b; }) -
+      (Rho_b + 1);
+  return heightInLayer(Rho_b[k] / rho.getValue(), k,
+                       m_table.invDensityExponent[k]);
+}
+
+void LayeredAtmosphere::getHeightByPressure(const Pressure* P, Length* h,
+                                            size_t n) const {
+  if (countOutOfRange(P, n, m_topPressure, getBottomPressure()) > 0)
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+  pressureHeightKernel(P, h, n, m_table);
+}
+
+void LayeredAtmosphere::getHeightByDensity(const Density* rho, Length* h,
+                                           size_t n) const {
+  if (countOutOfRange(rho, n, m_topDensity, getBottomDensity()) > 0)
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+  densityHeightKernel(rho, h, n, m_table);
+}
+
+size_t LayeredAtmosphere::getLayerCount() const { return m_layerCount; }
+
+Pressure LayeredAtmosphere::getBottomPressure() const {
+  return Pressure(m_table.P_b[0]);
+}
+
+Pressure LayeredAtmosphere::getTopPressure() const { return m_topPressure; }
+
+Density LayeredAtmosphere::getBottomDensity() const {
+  return Density(m_table.Rho_b[0]);
+}
+
+Density LayeredAtmosphere::getTopDensity() const { return m_topDensity; }
+
+// height in layer k at which pressure or density has fallen by ratio, see
+// heightOfRatio
+Length LayeredAtmosphere::heightInLayer(double ratio, size_t k,
+                                        double invExponent) const {
+  Length h_b = m_table.h_b[k];
+  Temperature T_b = m_table.T_b[k];
+  if (m_table.isothermal[k] != 0.0)
+    return h_b + R * T_b / (m_gravity * m_molarMass) * std::log(ratio);
+
+  Temperature T = T_b * Fpow(Number(ratio), Number(invExponent));
+  return h_b + (T - T_b) / LapseRate(m_table.L_b[k]);
+}
+
+void LayeredAtmosphere::checkHeights(const Length* h, size_t n) const {
+  if (countOutOfRange(h, n, getBottomHeight(), m_topHeight) > 0)
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+}
@@ -0,0 +1,219 @@
+#ifndef LAYEREDATMOSPHERE_H_
+#define LAYEREDATMOSPHERE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "SpaceToolkit/AtmosphereModel.h"
+#include "SpaceToolkit/FastMath.h"
+#include "SpaceToolkit/SpaceToolkitException.h"
+
+namespace SpaceToolkit {
+// a layer with a linear temperature profile starting at baseHeight
+struct AtmosphereLayer {
+  Length baseHeight;
+  LapseRate lapseRate;
+};
+
+// base values of the layers of a LayeredAtmosphere. Unused entries have an
+// infinite base height, so the layer search never selects them.
+struct LayerTable {
+  static constexpr size_t MAX_LAYER_COUNT = 16;
+
+  double h_b[MAX_LAYER_COUNT];
+  double T_b[MAX_LAYER_COUNT];
+  double L_b[MAX_LAYER_COUNT];
+  double P_b[MAX_LAYER_COUNT];
+  double Rho_b[MAX_LAYER_COUNT];
+  double exponent[MAX_LAYER_COUNT];    // g * M / (R * L_b), 0 if isothermal
+  double invL_b[MAX_LAYER_COUNT];      // 1 / L_b, 0 in isothermal layers
+  double isothermal[MAX_LAYER_COUNT];  // 1 in isothermal layers, 0 otherwise
+  double gMPerR;                       // g * M / R
+  double MPerR;                        // M / R
+
+  // 1 / exponent and 1 / (exponent + 1) for the inverse queries, 0 in
+  // isothermal layers
+  double invExponent[MAX_LAYER_COUNT];
+  double invDensityExponent[MAX_LAYER_COUNT];
+};
+
+// base values of the layers for the float batch query. The products of
+// constants are formed in double precision and rounded once.
+struct FloatLayerTable {
+  static constexpr size_t MAX_LAYER_COUNT = LayerTable::MAX_LAYER_COUNT;
+
+  float h_b[MAX_LAYER_COUNT];
+  float T_b[MAX_LAYER_COUNT];
+  float P_b[MAX_LAYER_COUNT];
+  float LPerT_b[MAX_LAYER_COUNT];     // L_b / T_b
+  float exponent[MAX_LAYER_COUNT];    // g * M / (R * L_b), 0 if isothermal
+  float gMPerRT_b[MAX_LAYER_COUNT];   // g * M / (R * T_b) if isothermal, or 0
+  float MPerR;                        // M / R
+};
+
+// Atmosphere made of layers with linear temperature profiles in hydrostatic
+// equilibrium. The layer base values are computed once at construction, a
+// query costs a layer search and one pow or exp. The scalar state query is
+// inline, see AtmosphereModel.
+class LayeredAtmosphere final : public AtmosphereModel<LayeredAtmosphere> {
+ public:
+  LayeredAtmosphere(const std::vector<AtmosphereLayer>& layers,
+                    Length topHeight, Temperature baseTemperature,
+                    Pressure basePressure, MolarMass molarMass,
+                    Acceleration gravity);
+
+  Temperature getAtmosphereTemperatureByHeight(Length h) const;
+  Pressure getAtmospherePressureByHeight(Length h) const;
+  Density getAtmosphereDensityByHeight(Length h) const;
+  AtmosphereState getAtmosphereStateByHeight(Length h) const;
+
+  // the state and its derivatives by height from the same evaluation, by
+  // hydrostatic equilibrium dP / dh = -g rho and by the gas law drho / dh =
+  // rho (dP / P - L / T). At a layer boundary the lapse rate jumps, the
+  // derivatives are those of the layer below, i.e. the ones from below, and
+  // at the bottom those of the lowest layer.
+  AtmosphereState getAtmosphereStateByHeight(
+      Length h, AtmosphereDerivatives& derivatives) const;
+
+  void getAtmosphereTemperatureByHeight(const Length* h, Temperature* T,
+                                        size_t n) const;
+  void getAtmospherePressureByHeight(const Length* h, Pressure* P,
+                                     size_t n) const;
+  void getAtmosphereDensityByHeight(const Length* h, Density* rho,
+                                    size_t n) const;
+  void getAtmosphereStateByHeight(const Length* h, Temperature* T, Pressure* P,
+                                  Density* rho, size_t n) const;
+
+  // single precision batch query with heights and results in SI base units,
+  // e.g. for plots. Twice the SIMD width of the double query at a relative
+  // error of about 1e-6. Throws if a height is out of range.
+  void getAtmosphereStateByHeight(const float* h, float* T, float* P,
+                                  float* rho, size_t n) const;
+
+  // profile of the n heights bottom + i * step with step > 0, e.g. for plots
+  // or lookup tables. Pressure is advanced from point to point by
+  // multiplicative recurrences instead of one pow per point: a constant
+  // factor in isothermal layers and the forward differences of a quartic in
+  // ln P in the others. An exact evaluation re-anchors the recurrence at
+  // every layer and after spans short enough to keep the relative error
+  // below 1e-12. Throws if a height is out of range.
+  void getAtmosphereProfile(Length bottom, Length step, Temperature* T,
+                            Pressure* P, Density* rho, size_t n) const;
+
+  // non-throwing queries for hot loops, out of range heights are handled by
+  // policy and reported by the returned status
+  AtmosphereStatus tryGetAtmosphereStateByHeight(
+      Length h, AtmosphereState& state,
+      OutOfRangePolicy policy = OutOfRangePolicy::Clamp) const noexcept;
+
+  // bit i % 64 of outOfRange[i / 64] is set if h[i] is out of range, the
+  // caller provides (n + 63) / 64 words. Returns the number of heights out of
+  // range.
+  size_t tryGetAtmosphereStateByHeight(
+      const Length* h, Temperature* T, Pressure* P, Density* rho, size_t n,
+      uint64_t* outOfRange,
+      OutOfRangePolicy policy = OutOfRangePolicy::Clamp) const noexcept;
+
+  // inverse queries: the height of a pressure or density, by one log and one
+  // pow per value. Density has to decrease with height, which holds unless a
+  // lapse rate is below -g M / R. Throws if a value is out of the range of
+  // the model.
+  Length getHeightByPressure(Pressure P) const;
+  Length getHeightByDensity(Density rho) const;
+  void getHeightByPressure(const Pressure* P, Length* h, size_t n) const;
+  void getHeightByDensity(const Density* rho, Length* h, size_t n) const;
+
+  size_t getLayerCount() const;
+  Length getBottomHeight() const;
+  Length getTopHeight() const;
+
+  // pressure and density at the bottom and the top, the ranges of the
+  // inverse queries
+  Pressure getBottomPressure() const;
+  Pressure getTopPressure() const;
+  Density getBottomDensity() const;
+  Density getTopDensity() const;
+
+ private:
+  friend class AtmosphereCursor;
+
+  LayerTable m_table;
+  FloatLayerTable m_floatTable;
+  size_t m_layerCount;
+  Length m_topHeight;
+  MolarMass m_molarMass;
+  Acceleration m_gravity;
+  Pressure m_topPressure;
+  Density m_topDensity;
+
+  size_t layerOf(Length h) const;
+  size_t layerSearch(Length h) const noexcept;
+  Pressure pressureInLayer(Length h, size_t k, Temperature& T) const;
+  Length heightInLayer(double ratio, size_t k, double invExponent) const;
+  void profileInLayer(size_t k, double h0, double dh, size_t begin,
+                      size_t end, Temperature* T, Pressure* P,
+                      Density* rho) const;
+  void checkHeights(const Length* h, size_t n) const;
+};
+
+inline AtmosphereState LayeredAtmosphere::getAtmosphereStateByHeight(
+    Length h) const {
+  Temperature T;
+  Pressure P = pressureInLayer(h, layerOf(h), T);
+
+  return {T, P, P * m_molarMass / (R * T)};
+}
+
+inline AtmosphereState LayeredAtmosphere::getAtmosphereStateByHeight(
+    Length h, AtmosphereDerivatives& derivatives) const {
+  size_t k = layerOf(h);
+  Temperature T;
+  Pressure P = pressureInLayer(h, k, T);
+  Density rho = P * m_molarMass / (R * T);
+
+  LapseRate L(m_table.L_b[k]);
+  derivatives.dT = L;
+  derivatives.dP = -1 * m_gravity * rho;
+  derivatives.drho = rho * (derivatives.dP / P - L / T);
+  return {T, P, rho};
+}
+
+// layer of a single height, throws if the height is out of range
+inline size_t LayeredAtmosphere::layerOf(Length h) const {
+  if (!(h >= getBottomHeight() && h <= m_topHeight))
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+
+  return layerSearch(h);
+}
+
+// layer of a single height within the valid range
+inline size_t LayeredAtmosphere::layerSearch(Length h) const noexcept {
+  // binary search for the layer k with h_b[k] < h <= h_b[k + 1]
+  const double* h_b = m_table.h_b;
+  return std::lower_bound(h_b + 1, h_b + m_layerCount, h.getValue()) -
+         (h_b + 1);
+}
+
+// temperature and pressure of a single height in layer k
+inline Pressure LayeredAtmosphere::pressureInLayer(Length h, size_t k,
+                                                   Temperature& T) const {
+  Length h_b = m_table.h_b[k];
+  Temperature T_b = m_table.T_b[k];
+  Pressure P_b = m_table.P_b[k];
+
+  T = T_b + LapseRate(m_table.L_b[k]) * (h - h_b);
+  if (m_table.isothermal[k] != 0.0)
+    return P_b * Fexp(-1 * m_gravity * m_molarMass * (h - h_b) / (R * T_b));
+
+  return P_b * Fpow(T_b / T, Number(m_table.exponent[k]));
+}
+
+inline Length LayeredAtmosphere::getBottomHeight() const {
+  return m_table.h_b[0];
+}
+
+inline Length LayeredAtmosphere::getTopHeight() const { return m_topHeight; }
+}  // namespace SpaceToolkit
+#endif  // LAYEREDATMOSPHERE_H_
@@ -0,0 +1,179 @@
+#include "SpaceToolkit/NozzlePerformance.h"
+
+#include <algorithm>
+
+#include "SpaceToolkit/Simd.h"
+#include "SpaceToolkit/SpaceToolkitException.h"
+
+using SpaceToolkit::NozzleDesign;
+using SpaceToolkit::NozzlePerformance;
+using SpaceToolkit::SpaceToolkitException;
+
+namespace {
+// the batch runs the kernels chunk by chunk on stack buffers
+constexpr size_t CHUNK = 1024;
+
+// pressure of the US standard atmosphere 1976 at sea level
+constexpr Pressure SEA_LEVEL_PRESSURE = 101325_Pa;
+
+// The batch performance is split into small kernels, as a loop over more
+// arrays needs more alias checks than GCC versions a loop for. GAMMA, the
+// momentum thrust coefficient and the expansion ratio stay in chunk buffers.
+SPACETOOLKIT_TARGET_CLONES
+void gammaKernel(const Number* kappa, double* gamma, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    double k = kappa[i].getValue();
+    gamma[i] = SpaceToolkit::Simd::sqrt(
+        k * SpaceToolkit::Simd::pow(2.0 / (k + 1.0), (k + 1.0) / (k - 1.0)));
+  }
+}
+
+// the momentum thrust coefficient and expansion ratio of LavalNozzle::design
+SPACETOOLKIT_TARGET_CLONES
+void nozzleKernel(const Number* kappa, const Pressure* p_c,
+                  const Pressure* p_e, const double* gamma,
+                  double* momentumCoefficient, double* expansionRatio,
+                  size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    double k = kappa[i].getValue();
+    double pressureRatio = p_e[i].getValue() / p_c[i].getValue();
+    double pressureRatioTerm =
+        SpaceToolkit::Simd::pow(pressureRatio, (k - 1.0) / k);
+    // p_e >= p_c gives NaN as in LavalNozzle::design
+    double velocityTerm = SpaceToolkit::Simd::sqrtOrNaN(
+        2.0 * k / (k - 1.0) * (1.0 - pressureRatioTerm));
+    momentumCoefficient[i] = gamma[i] * velocityTerm;
+    expansionRatio[i] =
+        gamma[i] * (pressureRatioTerm / pressureRatio) / velocityTerm;
+  }
+}
+
+SPACETOOLKIT_TARGET_CLONES
+void characteristicVelocityKernel(const Temperature* T_c, const MolarMass* M,
+                                  const double* gamma, Speed* cStar,
+                                  size_t n) {
+  const double R_0 = R.getValue();
+  for (size_t i = 0; i < n; ++i)
+    cStar[i] = Speed(SpaceToolkit::Simd::sqrt(R_0 * T_c[i].getValue() /
+                                              M[i].getValue()) /
+                     gamma[i]);
+}
+
+// C_F = C_F,momentum + (p_e - p_a) / p_c * A_e / A_t
+SPACETOOLKIT_TARGET_CLONES
+void coefficientKernel(const Pressure* p_c, const Pressure* p_e,
+                       const Pressure* p_a, const double* momentumCoefficient,
+                       const double* expansionRatio, Number* C_F, size_t n) {
+  for (size_t i = 0; i < n; ++i)
+    C_F[i] = Number(momentumCoefficient[i] +
+                    (p_e[i].getValue() - p_a[i].getValue()) /
+                        p_c[i].getValue() * expansionRatio[i]);
+}
+
+// with p_c A_t = F / C_F,momentum, the mass flow is F / (C_F,momentum c*)
+SPACETOOLKIT_TARGET_CLONES
+void massFlowKernel(const Force* F, const double* momentumCoefficient,
+                    const Speed* cStar, MassFlowRate* mDot, size_t n) {
+  for (size_t i = 0; i < n; ++i)
+    mDot[i] = MassFlowRate(F[i].getValue() /
+                           (momentumCoefficient[i] * cStar[i].getValue()));
+}
+
+SPACETOOLKIT_TARGET_CLONES
+void thrustKernel(const Force* F, const double* momentumCoefficient,
+                  const Number* C_F, const Speed* cStar, Force* thrust,
+                  Time* I_sp, size_t n) {
+  const double G_0 = g_0.getValue();
+  for (size_t i = 0; i < n; ++i) {
+    double C_F_i = C_F[i].getValue();
+    thrust[i] = Force(F[i].getValue() * C_F_i / momentumCoefficient[i]);
+    I_sp[i] = Time(cStar[i].getValue() * C_F_i / G_0);
+  }
+}
+}  // namespace
+
+NozzlePerformance::NozzlePerformance(const NozzleDesign& design,
+                                     Temperature chamberTemperature,
+                                     MolarMass molarMass)
+    : m_design(design),
+      m_chamberTemperature(chamberTemperature),
+      m_molarMass(molarMass) {
+  if (!(chamberTemperature.getValue() > 0.0 && molarMass.getValue() > 0.0))
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+  m_characteristicVelocity =
+      characteristicVelocity(design.GAMMA, chamberTemperature, molarMass);
+  m_massFlowRate = design.chamberPressure * design.throatCrossSectionalArea /
+                   m_characteristicVelocity;
+}
+
+Speed NozzlePerformance::characteristicVelocity() const {
+  return m_characteristicVelocity;
+}
+
+MassFlowRate NozzlePerformance::massFlowRate() const { return m_massFlowRate; }
+
+Number NozzlePerformance::thrustCoefficient(Pressure ambientPressure) const {
+  return m_design.thrustCoefficient +
+         (m_design.exitPressure - ambientPressure) /
+             m_design.chamberPressure * m_design.expansionRatio;
+}
+
+Force NozzlePerformance::thrust(Pressure ambientPressure) const {
+  return m_design.desiredThrust + (m_design.exitPressure - ambientPressure) *
+                                      m_design.exitCrossSectionalArea;
+}
+
+Time NozzlePerformance::specificImpulse(Pressure ambientPressure) const {
+  return thrust(ambientPressure) / (m_massFlowRate * g_0);
+}
+
+Time NozzlePerformance::vacuumSpecificImpulse() const {
+  return specificImpulse(Pressure(0.0));
+}
+
+Time NozzlePerformance::seaLevelSpecificImpulse() const {
+  return specificImpulse(SEA_LEVEL_PRESSURE);
+}
+
+const NozzleDesign& NozzlePerformance::getDesign() const { return m_design; }
+
+Temperature NozzlePerformance::getChamberTemperature() const {
+  return m_chamberTemperature;
+}
+
+MolarMass NozzlePerformance::getMolarMass() const { return m_molarMass; }
+
+Speed NozzlePerformance::characteristicVelocity(
+    Number GAMMA, Temperature chamberTemperature, MolarMass molarMass) {
+  return Psqrt(R * chamberTemperature / molarMass) / GAMMA;
+}
+
+void NozzlePerformance::performance(
+    const Force* desiredThrust, const Number* exhaustHeatCapacityRatio,
+    const Pressure* chamberPressure, const Pressure* exitPressure,
+    const Temperature* chamberTemperature, const MolarMass* molarMass,
+    const Pressure* ambientPressure, Speed* characteristicVelocity,
+    MassFlowRate* massFlowRate, Number* thrustCoefficient, Force* thrust,
+    Time* specificImpulse, size_t n) {
+  double gamma[CHUNK];
+  double momentumCoefficient[CHUNK];
+  double expansionRatio[CHUNK];
+  for (size_t i = 0; i < n; i += CHUNK) {
+    size_t m = std::min(CHUNK, n - i);
+    gammaKernel(exhaustHeatCapacityRatio + i, gamma, m);
+    nozzleKernel(exhaustHeatCapacityRatio + i, chamberPressure + i,
+                 exitPressure + i, gamma, momentumCoefficient, expansionRatio,
+                 m);
+    characteristicVelocityKernel(chamberTemperature + i, molarMass + i, gamma,
+                                 characteristicVelocity + i, m);
+    coefficientKernel(chamberPressure + i, exitPressure + i,
+                      ambientPressure + i, momentumCoefficient,
+                      expansionRatio, thrustCoefficient + i, m);
+    massFlowKernel(desiredThrust + i, momentumCoefficient,
+                   characteristicVelocity + i, massFlowRate + i, m);
+    thrustKernel(desiredThrust + i, momentumCoefficient,
+                 thrustCoefficient + i, characteristicVelocity + i,
+                 thrust + i, specificImpulse + i, m);
+  }
+}
@@ -0,0 +1,75 @@
+#ifndef NOZZLEPERFORMANCE_H_
+#define NOZZLEPERFORMANCE_H_
+
+#include <cstddef>
+
+#include "Physics/PhysicalUnit.h"
+#include "SpaceToolkit/LavalNozzle.h"
+
+using namespace Physics;
+
+namespace SpaceToolkit {
+// Performance of an ideal nozzle design with the chamber temperature and the
+// molar mass of the exhaust. The design thrust is the momentum thrust, i.e.
+// the thrust at an ambient pressure equal to the exit pressure. Off design
+// the pressure thrust (p_e - p_a) A_e is added, flow separation of an
+// overexpanded nozzle is not modelled.
+//
+// The characteristic velocity c* = sqrt(R T_c / M) / GAMMA and the mass flow
+// p_c A_t / c* are computed at construction from the cached GAMMA of the
+// design, the thrust coefficient, thrust and specific impulse at an ambient
+// pressure are then linear in it and need no pow.
+class NozzlePerformance {
+ public:
+  // throws if chamberTemperature or molarMass is not positive
+  NozzlePerformance(const NozzleDesign& design, Temperature chamberTemperature,
+                    MolarMass molarMass);
+
+  Speed characteristicVelocity() const;
+  MassFlowRate massFlowRate() const;
+
+  // C_F = F / (p_c A_t), thrust and I_sp = c* C_F / g_0 at ambientPressure
+  Number thrustCoefficient(Pressure ambientPressure) const;
+  Force thrust(Pressure ambientPressure) const;
+  Time specificImpulse(Pressure ambientPressure) const;
+
+  // at an ambient pressure of 0 and of the standard sea level, 101325 Pa
+  Time vacuumSpecificImpulse() const;
+  Time seaLevelSpecificImpulse() const;
+
+  const NozzleDesign& getDesign() const;
+  Temperature getChamberTemperature() const;
+  MolarMass getMolarMass() const;
+
+  // c* of a GAMMA of kappa, e.g. LavalNozzle::GAMMA
+  static Speed characteristicVelocity(Number GAMMA,
+                                      Temperature chamberTemperature,
+                                      MolarMass molarMass);
+
+  // The performance of n designs at their ambient pressures from structure
+  // of arrays inputs, in vectorized kernels without a design per point.
+  // GAMMA and the pressure ratio term are taken once per point and shared
+  // by c* and the thrust coefficient. Points with exitPressure >=
+  // chamberPressure give NaN, the temperatures and molar masses must be
+  // positive.
+  static void performance(const Force* desiredThrust,
+                          const Number* exhaustHeatCapacityRatio,
+                          const Pressure* chamberPressure,
+                          const Pressure* exitPressure,
+                          const Temperature* chamberTemperature,
+                          const MolarMass* molarMass,
+                          const Pressure* ambientPressure,
+                          Speed* characteristicVelocity,
+                          MassFlowRate* massFlowRate,
+                          Number* thrustCoefficient, Force* thrust,
+                          Time* specificImpulse, size_t n);
+
+ private:
+  NozzleDesign m_design;
+  Temperature m_chamberTemperature;
+  MolarMass m_molarMass;
+  Speed m_characteristicVelocity;
+  MassFlowRate m_massFlowRate;
+};
+}  // namespace SpaceToolkit
+#endif  // NOZZLEPERFORMANCE_H_
@@ -0,0 +1,331 @@
+#include "SpaceToolkit/NozzleSweep.h"
+
+#include <algorithm>
+#include <mutex>
+
+#include "SpaceToolkit/LavalNozzle.h"
+#include "SpaceToolkit/NozzlePerformance.h"
+#include "SpaceToolkit/Simd.h"
+#include "SpaceToolkit/SpaceToolkitException.h"
+
+using SpaceToolkit::MinimumMassFlowReduction;
+using SpaceToolkit::NozzlePerformance;
+using SpaceToolkit::NozzleSweep;
+using SpaceToolkit::NozzleSweepBlock;
+using SpaceToolkit::NozzleSweepGrid;
+using SpaceToolkit::NozzleSweepPoint;
+using SpaceToolkit::NozzleSweepReduction;
+using SpaceToolkit::ParetoFrontReduction;
+using SpaceToolkit::SpaceToolkitException;
+
+namespace {
+// the point axes in the order of the index, thrust fastest
+constexpr size_t AXIS_COUNT = 6;
+
+uint64_t packRange(uint64_t begin, uint64_t end) {
+  return (end << 32) | begin;
+}
+
+uint64_t rangeBegin(uint64_t range) { return range & 0xFFFFFFFFu; }
+
+uint64_t rangeEnd(uint64_t range) { return range >> 32; }
+
+// mass flow and specific impulse from the characteristic velocity c*, with
+// m = p_c A_t / c* and I_sp = F / (m g_0)
+SPACETOOLKIT_TARGET_CLONES
+void performanceKernel(const Force* F, const Pressure* p_c, const Area* A_t,
+                       const Speed* cStar, Time* I_sp,
+                       MassFlowRate* mDot, size_t n) {
+  const double G_0 = g_0.getValue();
+  for (size_t i = 0; i < n; ++i) {
+    double mDot_i =
+        p_c[i].getValue() * A_t[i].getValue() / cStar[i].getValue();
+    mDot[i] = MassFlowRate(mDot_i);
+    I_sp[i] = Time(F[i].getValue() / (mDot_i * G_0));
+  }
+}
+
+void checkPerformance(const NozzleSweepBlock& block) {
+  if (block.specificImpulse == nullptr)
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+}
+}  // namespace
+
+constexpr size_t NozzleSweep::CHUNK;
+
+bool NozzleSweepGrid::hasPerformance() const {
+  return chamberTemperature.count > 0 && molarMass.count > 0;
+}
+
+size_t NozzleSweepGrid::getPointCount() const {
+  size_t count = desiredThrust.count * exhaustHeatCapacityRatio.count *
+                 chamberPressure.count * exitPressure.count;
+  return hasPerformance() ? count * chamberTemperature.count * molarMass.count
+                          : count;
+}
+
+std::unique_ptr<NozzleSweepReduction> ParetoFrontReduction::clone() const {
+  return std::unique_ptr<NozzleSweepReduction>(new ParetoFrontReduction);
+}
+
+void ParetoFrontReduction::reduce(const NozzleSweepBlock& block) {
+  checkPerformance(block);
+  for (size_t i = 0; i < block.n; ++i)
+    insert({block.first + i, block.exitDiameter[i], block.specificImpulse[i],
+            block.massFlowRate[i]});
+}
+
+void ParetoFrontReduction::merge(const NozzleSweepReduction& partial) {
+  for (const NozzleSweepPoint& point :
+       static_cast<const ParetoFrontReduction&>(partial).m_front)
+    insert(point);
+}
+
+const std::vector<NozzleSweepPoint>& ParetoFrontReduction::getFront() const {
+  return m_front;
+}
+
+// The front is sorted by strictly ascending exit diameter and specific
+// impulse. A point is beaten by the last point with an exit diameter not
+// above its own, and beats the following points up to a higher specific
+// impulse.
+void ParetoFrontReduction::insert(const NozzleSweepPoint& point) {
+  double d = point.exitDiameter.getValue();
+  double I = point.specificImpulse.getValue();
+  if (!(d > 0.0 && I > 0.0)) return;  // NaN of an invalid design
+
+  auto next = std::upper_bound(m_front.begin(), m_front.end(), d,
+                               [](double d, const NozzleSweepPoint& p) {
+                                 return d < p.exitDiameter.getValue();
+                               });
+  if (next != m_front.begin()) {
+    const NozzleSweepPoint& last = *(next - 1);
+    double I_last = last.specificImpulse.getValue();
+    if (I_last > I ||
+        (I_last == I && (last.exitDiameter.getValue() < d ||
+                         last.index < point.index)))
+      return;
+    if (last.exitDiameter.getValue() == d) --next;
+  }
+
+  auto end = next;
+  while (end != m_front.end() && end->specificImpulse.getValue() <= I) ++end;
+  next = m_front.erase(next, end);
+  m_front.insert(next, point);
+}
+
+MinimumMassFlowReduction::MinimumMassFlowReduction(Force minimumThrust,
+                                                   Length maximumExitDiameter)
+    : m_minimumThrust(minimumThrust),
+      m_maximumExitDiameter(maximumExitDiameter),
+      m_hasMinimum(false),
+      m_minimum() {}
+
+std::unique_ptr<NozzleSweepReduction> MinimumMassFlowReduction::clone() const {
+  return std::unique_ptr<NozzleSweepReduction>(
+      new MinimumMassFlowReduction(m_minimumThrust, m_maximumExitDiameter));
+}
+
+void MinimumMassFlowReduction::reduce(const NozzleSweepBlock& block) {
+  checkPerformance(block);
+  for (size_t i = 0; i < block.n; ++i)
+    if (block.desiredThrust[i] >= m_minimumThrust &&
+        block.exitDiameter[i] <= m_maximumExitDiameter)
+      update({block.first + i, block.exitDiameter[i],
+              block.specificImpulse[i], block.massFlowRate[i]});
+}
+
+void MinimumMassFlowReduction::merge(const NozzleSweepReduction& partial) {
+  const MinimumMassFlowReduction& other =
+      static_cast<const MinimumMassFlowReduction&>(partial);
+  if (other.m_hasMinimum) update(other.m_minimum);
+}
+
+bool MinimumMassFlowReduction::hasMinimum() const { return m_hasMinimum; }
+
+const NozzleSweepPoint& MinimumMassFlowReduction::getMinimum() const {
+  return m_minimum;
+}
+
+void MinimumMassFlowReduction::update(const NozzleSweepPoint& point) {
+  double mDot = point.massFlowRate.getValue();
+  if (!(mDot > 0.0)) return;  // NaN of an invalid design
+
+  double mDot_min = m_minimum.massFlowRate.getValue();
+  if (!m_hasMinimum || mDot < mDot_min ||
+      (mDot == mDot_min && point.index < m_minimum.index)) {
+    m_minimum = point;
+    m_hasMinimum = true;
+  }
+}
+
+NozzleSweep::NozzleSweep(size_t threadCount) : m_pool(threadCount) {
+  m_ranges.reset(new Range[getThreadCount()]);
+  for (size_t i = 0; i < getThreadCount(); ++i) {
+    m_ranges[i].blocks = 0;
+    m_buffers.emplace_back(new Buffers);
+    Buffers& buffers = *m_buffers.back();
+    buffers.F.resize(CHUNK);
+    buffers.kappa.resize(CHUNK);
+    buffers.cStar.resize(CHUNK);
+    buffers.p_c.resize(CHUNK);
+    buffers.p_e.resize(CHUNK);
+    buffers.T_c.resize(CHUNK);
+    buffers.M.resize(CHUNK);
+    buffers.A_t.resize(CHUNK);
+    buffers.A_e.resize(CHUNK);
+    buffers.d_t.resize(CHUNK);
+    buffers.d_e.resize(CHUNK);
+    buffers.I_sp.resize(CHUNK);
+    buffers.mDot.resize(CHUNK);
+  }
+}
+
+size_t NozzleSweep::getThreadCount() const { return m_pool.getThreadCount(); }
+
+void NozzleSweep::sweep(const NozzleSweepGrid& grid, NozzleSweepSink* sink,
+                        const std::vector<NozzleSweepReduction*>& reductions) {
+  size_t n = grid.getPointCount();
+  size_t blockCount = (n + CHUNK - 1) / CHUNK;
+  if (n == 0 || blockCount > 0xFFFFFFFFu)
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+
+  bool performance = grid.hasPerformance();
+  size_t counts[AXIS_COUNT] = {
+      grid.desiredThrust.count,      grid.exhaustHeatCapacityRatio.count,
+      grid.chamberPressure.count,    grid.exitPressure.count,
+      performance ? grid.chamberTemperature.count : 1,
+      performance ? grid.molarMass.count : 1};
+  std::vector<Number> GAMMA(grid.exhaustHeatCapacityRatio.count);
+  for (size_t k = 0; k < GAMMA.size(); ++k)
+    GAMMA[k] = LavalNozzle::GAMMA(grid.exhaustHeatCapacityRatio[k]);
+
+  for (std::unique_ptr<Buffers>& buffers : m_buffers) {
+    buffers->partials.clear();
+    for (NozzleSweepReduction* reduction : reductions)
+      buffers->partials.push_back(reduction->clone());
+  }
+  std::mutex sinkMutex;
+
+  Work work = [&](size_t block, Buffers& b) {
+    size_t first = block * CHUNK;
+    size_t m = std::min(CHUNK, n - first);
+
+    // the axis indices of the first point, then counted up point by point
+    size_t index[AXIS_COUNT];
+    size_t rest = first;
+    for (size_t a = 0; a < AXIS_COUNT; ++a) {
+      index[a] = rest % counts[a];
+      rest /= counts[a];
+    }
+    for (size_t i = 0; i < m; ++i) {
+      b.F[i] = grid.desiredThrust[index[0]];
+      b.kappa[i] = grid.exhaustHeatCapacityRatio[index[1]];
+      b.p_c[i] = grid.chamberPressure[index[2]];
+      b.p_e[i] = grid.exitPressure[index[3]];
+      if (performance) {
+        b.T_c[i] = grid.chamberTemperature[index[4]];
+        b.M[i] = grid.molarMass[index[5]];
+        // c* only changes with kappa and the outer axes
+        b.cStar[i] =
+            i > 0 && index[0] > 0
+                ? b.cStar[i - 1]
+                : NozzlePerformance::characteristicVelocity(
+                      GAMMA[index[1]], b.T_c[i], b.M[i]);
+      }
+      for (size_t a = 0; a < AXIS_COUNT && ++index[a] == counts[a]; ++a)
+        index[a] = 0;
+    }
+
+    LavalNozzle::design(b.F.data(), b.kappa.data(), b.p_c.data(),
+                        b.p_e.data(), b.A_t.data(), b.A_e.data(),
+                        b.d_t.data(), b.d_e.data(), m);
+    if (performance)
+      performanceKernel(b.F.data(), b.p_c.data(), b.A_t.data(),
+                        b.cStar.data(), b.I_sp.data(), b.mDot.data(), m);
+
+    NozzleSweepBlock results = {first,
+                                m,
+                                b.F.data(),
+                                b.kappa.data(),
+                                b.p_c.data(),
+                                b.p_e.data(),
+                                performance ? b.T_c.data() : nullptr,
+                                performance ? b.M.data() : nullptr,
+                                b.A_t.data(),
+                                b.A_e.data(),
+                                b.d_t.data(),
+                                b.d_e.data(),
+                                performance ? b.I_sp.data() : nullptr,
+                                performance ? b.mDot.data() : nullptr};
+    if (sink != nullptr) {
+      std::lock_guard<std::mutex> lock(sinkMutex);
+      sink->consume(results);
+    }
+    for (std::unique_ptr<NozzleSweepReduction>& partial : b.partials)
+      partial->reduce(results);
+  };
+  try {
+    run(blockCount, work);
+  } catch (...) {
+    for (std::unique_ptr<Buffers>& buffers : m_buffers)
+      buffers->partials.clear();
+    throw;
+  }
+
+  for (std::unique_ptr<Buffers>& buffers : m_buffers) {
+    for (size_t r = 0; r < reductions.size(); ++r)
+      reductions[r]->merge(*buffers->partials[r]);
+    buffers->partials.clear();
+  }
+}
+
+// the threads take blocks until none is left or a block failed
+void NozzleSweep::run(size_t blockCount, const Work& work) {
+  // contiguous ranges of about the same size
+  size_t threadCount = getThreadCount();
+  for (size_t i = 0; i < threadCount; ++i)
+    m_ranges[i].blocks = packRange(blockCount * i / threadCount,
+                                   blockCount * (i + 1) / threadCount);
+
+  m_pool.run([&](size_t index) {
+    size_t block;
+    while (!m_pool.hasFailed() && takeBlock(index, block))
+      work(block, *m_buffers[index]);
+  });
+}
+
+// The next block of the own range, else the middle block of another range,
+// whose upper half becomes the own range. Only the owner stores to an empty
+// range, and a range never comes back to an earlier value, so the compare
+// and swap of a thief cannot succeed on a stale range.
+bool NozzleSweep::takeBlock(size_t index, size_t& block) {
+  std::atomic<uint64_t>& own = m_ranges[index].blocks;
+  uint64_t range = own.load();
+  while (rangeBegin(range) < rangeEnd(range)) {
+    if (own.compare_exchange_weak(
+            range, packRange(rangeBegin(range) + 1, rangeEnd(range)))) {
+      block = rangeBegin(range);
+      return true;
+    }
+  }
+
+  size_t threadCount = getThreadCount();
+  for (size_t i = 1; i < threadCount; ++i) {
+    std::atomic<uint64_t>& victim = m_ranges[(index + i) % threadCount].blocks;
+    range = victim.load();
+    while (rangeBegin(range) < rangeEnd(range)) {
+      uint64_t middle =
+          rangeBegin(range) + (rangeEnd(range) - rangeBegin(range)) / 2;
+      if (victim.compare_exchange_weak(range,
+                                       packRange(rangeBegin(range), middle))) {
+        own.store(packRange(middle + 1, rangeEnd(range)));
+        block = middle;
+        return true;
+      }
+    }
+  }
+  return false;
+}
@@ -0,0 +1,211 @@
+#ifndef NOZZLESWEEP_H_
+#define NOZZLESWEEP_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "Physics/PhysicalUnit.h"
+#include "SpaceToolkit/ThreadPool.h"
+
+using namespace Physics;
+
+namespace SpaceToolkit {
+// the count values first + i * step of a design parameter
+template <class T>
+struct SweepAxis {
+  T first;
+  T step;
+  size_t count;
+
+  T operator[](size_t i) const {
+    return first + static_cast<double>(i) * step;
+  }
+};
+
+// Grid of a nozzle design space. The point index runs over the thrust
+// fastest, then kappa, chamber pressure, exit pressure, chamber temperature
+// and molar mass. The last two are optional: with a count of 0 the sweep
+// only sizes the nozzles and leaves out the specific impulse and mass flow.
+struct NozzleSweepGrid {
+  SweepAxis<Force> desiredThrust;
+  SweepAxis<Number> exhaustHeatCapacityRatio;
+  SweepAxis<Pressure> chamberPressure;
+  SweepAxis<Pressure> exitPressure;
+  SweepAxis<Temperature> chamberTemperature;
+  SweepAxis<MolarMass> molarMass;
+
+  bool hasPerformance() const;
+  size_t getPointCount() const;
+};
+
+// The designs of the points first to first + n - 1 of a grid, structure of
+// arrays valid during a call of a sink or reduction. Without performance
+// axes, chamberTemperature, molarMass, specificImpulse and massFlowRate are
+// null. Points with exitPressure >= chamberPressure give NaN.
+struct NozzleSweepBlock {
+  size_t first;
+  size_t n;
+  const Force* desiredThrust;
+  const Number* exhaustHeatCapacityRatio;
+  const Pressure* chamberPressure;
+  const Pressure* exitPressure;
+  const Temperature* chamberTemperature;
+  const MolarMass* molarMass;
+  const Area* throatCrossSectionalArea;
+  const Area* exitCrossSectionalArea;
+  const Length* throatDiameter;
+  const Length* exitDiameter;
+  // at the design point, where the ambient pressure is the exit pressure
+  const Time* specificImpulse;
+  const MassFlowRate* massFlowRate;
+};
+
+// receives all designs of a sweep. The calls are serialized, but the blocks
+// arrive in no particular order.
+class NozzleSweepSink {
+ public:
+  virtual ~NozzleSweepSink() = default;
+
+  virtual void consume(const NozzleSweepBlock& block) = 0;
+};
+
+// A reduction of a sweep, so the designs need not be stored. Every thread
+// reduces into its own partial, an empty clone of the reduction, without
+// locking. The partials are merged into the reduction when the sweep ends,
+// and the result must not depend on the order of the merges.
+class NozzleSweepReduction {
+ public:
+  virtual ~NozzleSweepReduction() = default;
+
+  virtual std::unique_ptr<NozzleSweepReduction> clone() const = 0;
+  virtual void reduce(const NozzleSweepBlock& block) = 0;
+  virtual void merge(const NozzleSweepReduction& partial) = 0;
+};
+
+// a design of a reduction, by its point index in the grid
+struct NozzleSweepPoint {
+  size_t index;
+  Length exitDiameter;
+  Time specificImpulse;
+  MassFlowRate massFlowRate;
+};
+
+// The designs of the grid which no other design beats in both exit diameter
+// and specific impulse, by ascending exit diameter. Of equal designs the one
+// with the lowest index is kept. Throws without the performance axes.
+class ParetoFrontReduction : public NozzleSweepReduction {
+ public:
+  std::unique_ptr<NozzleSweepReduction> clone() const;
+  void reduce(const NozzleSweepBlock& block);
+  void merge(const NozzleSweepReduction& partial);
+
+  const std::vector<NozzleSweepPoint>& getFront() const;
+
+ private:
+  std::vector<NozzleSweepPoint> m_front;
+
+  void insert(const NozzleSweepPoint& point);
+};
+
+// The design with the lowest propellant mass flow rate that delivers at least
+// minimumThrust within an exit diameter of maximumExitDiameter, i.e. the
+// minimum propellant mass for a burn time in the envelope. Of equal designs
+// the one with the lowest index is kept. Throws without the performance
+// axes.
+class MinimumMassFlowReduction : public NozzleSweepReduction {
+ public:
+  MinimumMassFlowReduction(Force minimumThrust, Length maximumExitDiameter);
+
+  std::unique_ptr<NozzleSweepReduction> clone() const;
+  void reduce(const NozzleSweepBlock& block);
+  void merge(const NozzleSweepReduction& partial);
+
+  // false if no design lies in the envelope
+  bool hasMinimum() const;
+  const NozzleSweepPoint& getMinimum() const;
+
+ private:
+  Force m_minimumThrust;
+  Length m_maximumExitDiameter;
+  bool m_hasMinimum;
+  NozzleSweepPoint m_minimum;
+
+  void update(const NozzleSweepPoint& point);
+};
+
+// Evaluates the designs of a NozzleSweepGrid on a pool of threads, e.g. for
+// engine trade studies over 10^9 points, and streams them to a sink and to
+// reductions instead of storing them. The grid is split into blocks of CHUNK
+// points, which are sized by LavalNozzle::design on arrays and, with the
+// performance axes, get their specific impulse and mass flow in a second
+// kernel. GAMMA, which depends on kappa only, is taken once per axis value,
+// so the second kernel needs no pow.
+//
+// Every thread starts on its own contiguous range of blocks, a thread which
+// runs out steals the upper half of the rest of another range. This keeps
+// the threads on consecutive points without a shared counter, and balances
+// uneven sink and reduction costs. The calling thread takes part in a sweep,
+// a pool of one thread evaluates serially. If a sink or reduction throws,
+// the sweep stops and rethrows the first exception, the reductions are then
+// left unchanged. One sweep runs at a time per pool.
+class NozzleSweep {
+ public:
+  static constexpr size_t CHUNK = 1024;
+
+  // threadCount threads including the caller, 0 for one per hardware thread
+  explicit NozzleSweep(size_t threadCount = 0);
+
+  NozzleSweep(const NozzleSweep&) = delete;
+  NozzleSweep& operator=(const NozzleSweep&) = delete;
+
+  size_t getThreadCount() const;
+
+  // sweeps the grid into the sink, if not null, and the reductions. Throws
+  // if an axis of the design is empty or the grid has 2^32 blocks or more.
+  void sweep(const NozzleSweepGrid& grid, NozzleSweepSink* sink,
+             const std::vector<NozzleSweepReduction*>& reductions = {});
+
+ private:
+  // block buffers of a thread
+  struct Buffers {
+    std::vector<Force> F;
+    std::vector<Number> kappa;
+    std::vector<Speed> cStar;
+    std::vector<Pressure> p_c;
+    std::vector<Pressure> p_e;
+    std::vector<Temperature> T_c;
+    std::vector<MolarMass> M;
+    std::vector<Area> A_t;
+    std::vector<Area> A_e;
+    std::vector<Length> d_t;
+    std::vector<Length> d_e;
+    std::vector<Time> I_sp;
+    std::vector<MassFlowRate> mDot;
+    std::vector<std::unique_ptr<NozzleSweepReduction>> partials;
+  };
+
+  // the blocks [begin, end) left to a thread, packed into one word so that
+  // the owner and thieves update it by compare and swap. Padded to a cache
+  // line, the ranges are written by every block.
+  struct Range {
+    std::atomic<uint64_t> blocks;
+    char padding[64 - sizeof(std::atomic<uint64_t>)];
+  };
+
+  using Work = std::function<void(size_t block, Buffers& buffers)>;
+
+  // buffers and ranges of the caller first, then of the workers
+  std::vector<std::unique_ptr<Buffers>> m_buffers;
+  std::unique_ptr<Range[]> m_ranges;
+  // last, so that the workers stop before the buffers go
+  ThreadPool m_pool;
+
+  void run(size_t blockCount, const Work& work);
+  bool takeBlock(size_t index, size_t& block);
+};
+}  // namespace SpaceToolkit
+#endif  // NOZZLESWEEP_H_
@@ -0,0 +1,65 @@
+#ifndef RANDOM_H_
+#define RANDOM_H_
+
+#include <cmath>
+#include <cstdint>
+
+namespace SpaceToolkit {
+// Counter based random numbers: Philox4x32-10 of Salmon et al., "Parallel
+// random numbers: as easy as 1, 2, 3" (SC11). The numbers are a function of a
+// counter and a key instead of a state, so any number of a stream is
+// available at once and threads need no shared generator. The results match
+// the known answers of the Random123 library.
+namespace Random {
+struct Philox4x32 {
+  uint32_t x[4];
+};
+
+constexpr uint32_t PHILOX_M0 = 0xD2511F53;
+constexpr uint32_t PHILOX_M1 = 0xCD9E8D57;
+constexpr uint32_t PHILOX_W0 = 0x9E3779B9;  // golden ratio
+constexpr uint32_t PHILOX_W1 = 0xBB67AE85;  // sqrt(3) - 1
+
+inline Philox4x32 philox(Philox4x32 counter, uint32_t key0, uint32_t key1) {
+  uint32_t* c = counter.x;
+  for (int round = 0; round < 10; ++round) {
+    uint64_t p0 = static_cast<uint64_t>(PHILOX_M0) * c[0];
+    uint64_t p1 = static_cast<uint64_t>(PHILOX_M1) * c[2];
+    uint32_t c1 = c[1];
+    c[0] = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ key0;
+    c[1] = static_cast<uint32_t>(p1);
+    c[2] = static_cast<uint32_t>(p0 >> 32) ^ c[3] ^ key1;
+    c[3] = static_cast<uint32_t>(p0);
+    key0 += PHILOX_W0;
+    key1 += PHILOX_W1;
+  }
+  return counter;
+}
+
+// two independent standard normal numbers, pair of the stream of the key
+// seed and the index stream, by the Box-Muller transform of two uniform
+// numbers with 53 bits
+inline void normalPair(uint64_t seed, uint64_t stream, uint64_t pair,
+                       double& z0, double& z1) {
+  constexpr double TWO_PI = 6.28318530717958647693;
+  constexpr double EPSILON = 1.0 / 9007199254740992.0;  // 2^-53
+
+  Philox4x32 r = philox({{static_cast<uint32_t>(pair),
+                          static_cast<uint32_t>(pair >> 32),
+                          static_cast<uint32_t>(stream),
+                          static_cast<uint32_t>(stream >> 32)}},
+                        static_cast<uint32_t>(seed),
+                        static_cast<uint32_t>(seed >> 32));
+  uint64_t a = (static_cast<uint64_t>(r.x[0]) << 32) | r.x[1];
+  uint64_t b = (static_cast<uint64_t>(r.x[2]) << 32) | r.x[3];
+
+  // u in (0, 1], so the logarithm is finite
+  double u = ((a >> 11) + 1) * EPSILON;
+  double v = (b >> 11) * EPSILON;
+  double radius = std::sqrt(-2.0 * std::log(u));
+  z0 = radius * std::cos(TWO_PI * v);
+  z1 = radius * std::sin(TWO_PI * v);
+}
+}  // namespace Random
+}  // namespace SpaceToolkit
+#endif  // RANDOM_H_
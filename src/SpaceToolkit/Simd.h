@@ -0,0 +1,183 @@
+#ifndef SIMD_H_
+#define SIMD_H_
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+// Batch kernels are written as plain loops the compiler can vectorize. On
+// x86-64 with GCC/Clang they are additionally compiled for AVX2 and AVX-512,
+// the best clone is selected at load time and the default clone is the scalar
+// fallback.
+#if defined(__x86_64__) && defined(__linux__) && defined(__has_attribute)
+#if __has_attribute(target_clones)
+#define SPACETOOLKIT_TARGET_CLONES \
+  __attribute__((target_clones("avx512f", "avx2", "default")))
+#endif
+#endif
+
+#ifndef SPACETOOLKIT_TARGET_CLONES
+#define SPACETOOLKIT_TARGET_CLONES
+#endif
+
+namespace SpaceToolkit {
+// Branch free exp, log and sqrt which vectorize inside the batch kernels,
+// unlike the libm calls. All are accurate to a few ulp; exp expects arguments
+// in [-708, 709], log and sqrt expect normal positive numbers. The float
+// versions of exp and log for the single precision kernels take arguments in
+// [-87, 88] and normal positive numbers.
+namespace Simd {
+inline uint64_t bitsOf(double x) {
+  uint64_t i;
+  std::memcpy(&i, &x, sizeof(i));
+  return i;
+}
+
+inline double doubleOf(uint64_t i) {
+  double x;
+  std::memcpy(&x, &i, sizeof(x));
+  return x;
+}
+
+constexpr double LN2_HI = 6.93147180369123816490e-01;
+constexpr double LN2_LO = 1.90821492927058770002e-10;
+constexpr double LOG2E = 1.44269504088896338700e+00;
+constexpr double ROUND = 6755399441055744.0;  // 1.5 * 2^52
+constexpr double SQRT2 = 1.41421356237309504880e+00;
+
+// minimax coefficients of exp and log from fdlibm
+constexpr double EXP_P1 = 1.66666666666666019037e-01;
+constexpr double EXP_P2 = -2.77777777770155933842e-03;
+constexpr double EXP_P3 = 6.61375632143793436117e-05;
+constexpr double EXP_P4 = -1.65339022054652515390e-06;
+constexpr double EXP_P5 = 4.13813679705723846039e-08;
+constexpr double LOG_LG1 = 6.666666666666735130e-01;
+constexpr double LOG_LG2 = 3.999999999940941908e-01;
+constexpr double LOG_LG3 = 2.857142874366239149e-01;
+constexpr double LOG_LG4 = 2.222219843214978396e-01;
+constexpr double LOG_LG5 = 1.818357216161805012e-01;
+constexpr double LOG_LG6 = 1.531383769920937332e-01;
+constexpr double LOG_LG7 = 1.479819860511658591e-01;
+
+inline double exp(double x) {
+  // x = k ln2 + r with |r| <= ln2 / 2, k is held in the low mantissa bits of t
+  double t = x * LOG2E + ROUND;
+  double k = t - ROUND;
+  double r = (x - k * LN2_HI) - k * LN2_LO;
+
+  // exp(r) = 1 + r + r c / (2 - c) with the minimax polynomial c of fdlibm,
+  // its error is below 2^-59
+  double r2 = r * r;
+  double c = EXP_P5;
+  c = c * r2 + EXP_P4;
+  c = c * r2 + EXP_P3;
+  c = c * r2 + EXP_P2;
+  c = c * r2 + EXP_P1;
+  c = r - r2 * c;
+  double p = 1.0 + (r + r * c / (2.0 - c));
+
+  // p * 2^k by adding k to the exponent field
+  return doubleOf(bitsOf(p) + ((bitsOf(t) - bitsOf(ROUND)) << 52));
+}
+
+inline double log(double x) {
+  // x = 2^e * m with m in [sqrt(2) / 2, sqrt(2)), the offset moves the
+  // mantissa range so that e and m follow without a branch
+  uint64_t bits = bitsOf(x) + (bitsOf(1.0) - bitsOf(SQRT2 / 2));
+  double e = doubleOf((bits >> 52) | bitsOf(4503599627370496.0)) -
+             (4503599627370496.0 + 1023.0);
+  double m = doubleOf((bits & 0x000fffffffffffffULL) + bitsOf(SQRT2 / 2));
+
+  // log(m) = 2 atanh(s) = 2 s + s R(s^2) with s = (m - 1) / (m + 1),
+  // |s| <= 0.1716, and the minimax polynomial R of fdlibm, its error is below
+  // 2^-58
+  double s = (m - 1.0) / (m + 1.0);
+  double s2 = s * s;
+  double p = LOG_LG7;
+  p = p * s2 + LOG_LG6;
+  p = p * s2 + LOG_LG5;
+  p = p * s2 + LOG_LG4;
+  p = p * s2 + LOG_LG3;
+  p = p * s2 + LOG_LG2;
+  p = p * s2 + LOG_LG1;
+  double R = s2 * p;
+
+  return e * LN2_HI + (2.0 * s + (s * R + e * LN2_LO));
+}
+
+// x^y = exp(y log(x)) for x > 0, the error of log(x) is scaled by y log(x)
+inline double pow(double x, double y) { return exp(y * log(x)); }
+
+inline double sqrt(double x) {
+  // 1 / sqrt(x) from the halved exponent to about 3.5 %, three Newton steps
+  // reach 3e-11
+  double y = doubleOf(0x5fe6eb50c7b537a9ULL - (bitsOf(x) >> 1));
+  y = y * (1.5 - 0.5 * x * y * y);
+  y = y * (1.5 - 0.5 * x * y * y);
+  y = y * (1.5 - 0.5 * x * y * y);
+
+  // one Newton step on sqrt(x) itself gives the last bits
+  double r = x * y;
+  return r + 0.5 * y * (x - r * r);
+}
+
+// sqrt(x) for x > 0 and NaN otherwise, e.g. to invalidate a point of a batch
+// without a real solution, where sqrt alone returns a finite bogus value
+inline double sqrtOrNaN(double x) {
+  double r = sqrt(x);
+  return x > 0.0 ? r : std::numeric_limits<double>::quiet_NaN();
+}
+
+inline uint32_t bitsOf(float x) {
+  uint32_t i;
+  std::memcpy(&i, &x, sizeof(i));
+  return i;
+}
+
+inline float floatOf(uint32_t i) {
+  float x;
+  std::memcpy(&x, &i, sizeof(x));
+  return x;
+}
+
+constexpr float LN2_HI_F = 6.93359375e-01f;  // exact in 9 bits
+constexpr float LN2_LO_F = -2.12194440e-04f;
+constexpr float ROUND_F = 12582912.0f;  // 1.5 * 2^23
+
+inline float exp(float x) {
+  float t = x * static_cast<float>(LOG2E) + ROUND_F;
+  float k = t - ROUND_F;
+  float r = (x - k * LN2_HI_F) - k * LN2_LO_F;
+
+  // Taylor series of exp(r), the remainder is below 6e-9
+  float p = 1.0f / 5040.0f;
+  p = p * r + 1.0f / 720.0f;
+  p = p * r + 1.0f / 120.0f;
+  p = p * r + 1.0f / 24.0f;
+  p = p * r + 1.0f / 6.0f;
+  p = p * r + 0.5f;
+  p = p * r + 1.0f;
+  p = p * r + 1.0f;
+
+  return floatOf(bitsOf(p) + ((bitsOf(t) - bitsOf(ROUND_F)) << 23));
+}
+
+inline float log(float x) {
+  const float sqrtHalf = static_cast<float>(SQRT2 / 2);
+  uint32_t bits = bitsOf(x) + (bitsOf(1.0f) - bitsOf(sqrtHalf));
+  float e = floatOf((bits >> 23) | bitsOf(8388608.0f)) - (8388608.0f + 127.0f);
+  float m = floatOf((bits & 0x007fffffU) + bitsOf(sqrtHalf));
+
+  float s = (m - 1.0f) / (m + 1.0f);
+  float s2 = s * s;
+  float p = 1.0f / 9.0f;
+  p = p * s2 + 1.0f / 7.0f;
+  p = p * s2 + 1.0f / 5.0f;
+  p = p * s2 + 1.0f / 3.0f;
+
+  return e * LN2_HI_F + (2.0f * s + (2.0f * s * s2 * p + e * LN2_LO_F));
+}
+}  // namespace Simd
+}  // namespace SpaceToolkit
+
+#endif  // SIMD_H_
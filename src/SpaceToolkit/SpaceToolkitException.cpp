@@ -5,6 +5,14 @@ using SpaceToolkit::SpaceToolkitException;
 using std::cout;
 using std::endl;
 
+const map<string, string> SpaceToolkitException::m_errors = {
+    {"errUnknown", "Unknown error."},
+    {"errInputParameterOutOfRange",
+     "One or more input parameter are out of range."},
+    {"errFileAccess", "The file cannot be opened or mapped."},
+    {"errFileFormat", "The file is not a valid table of a supported version."},
+};
+
 SpaceToolkitException::SpaceToolkitException(const string& errorId,
                                              const string file, int line)
     : m_errorId(errorId), m_file(file), m_line(line) {}
@@ -12,8 +20,11 @@ SpaceToolkitException::SpaceToolkitException(const string& errorId,
 SpaceToolkitException::~SpaceToolkitException() throw() {}
 
 void SpaceToolkitException::handle() {
+  auto error = m_errors.find(m_errorId);
+  if (error == m_errors.end()) error = m_errors.find("errUnknown");
+
   cout << "----------------------------------------" << endl;
-  cout << "Error message: " << m_errors[m_errorId] << endl;
+  cout << "Error message: " << error->second << endl;
   cout << "File:          " << m_file << endl;
   cout << "Line:          " << m_line << endl;
   cout << "----------------------------------------" << endl;
@@ -18,11 +18,8 @@ class SpaceToolkitException {
   void handle();
 
  private:
-  map<string, string> m_errors = {
-      {"errUnknown", "Unknown error."},
-      {"errInputParameterOutOfRange",
-       "One or more input parameter are out of range."},
-  };
+  // shared by all instances, so throwing does not build the map each time
+  static const map<string, string> m_errors;
 
   string m_errorId;
   string m_errorMessage;
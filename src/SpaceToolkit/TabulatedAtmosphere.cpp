@@ -0,0 +1,176 @@
+#include "SpaceToolkit/TabulatedAtmosphere.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "SpaceToolkit/SpaceToolkitException.h"
+
+using SpaceToolkit::Atmosphere;
+using SpaceToolkit::AtmosphereState;
+using SpaceToolkit::SpaceToolkitException;
+using SpaceToolkit::TabulatedAtmosphere;
+
+namespace {
+// the error is tested against half the bound between the test points, which
+// leaves a margin for the maximum error between two of them
+constexpr size_t TEST_POINT_COUNT = 32;
+constexpr double SAFETY_FACTOR = 0.5;
+
+// coefficients of the cubic through f at u = 0, 1/3, 2/3 and 1, from the
+// Newton form in t = 3u
+void fitCubic(const double f[4], double c[4]) {
+  double d1 = f[1] - f[0];
+  double d2 = f[2] - 2.0 * f[1] + f[0];
+  double d3 = f[3] - 3.0 * f[2] + 3.0 * f[1] - f[0];
+
+  c[0] = f[0];
+  c[1] = 3.0 * (d1 - d2 / 2.0 + d3 / 3.0);
+  c[2] = 9.0 * (d2 - d3) / 2.0;
+  c[3] = 27.0 * d3 / 6.0;
+}
+
+bool withinBound(double interpolated, double exact, double relativeError) {
+  return std::fabs(interpolated - exact) <= relativeError * std::fabs(exact);
+}
+}  // namespace
+
+TabulatedAtmosphere::TabulatedAtmosphere(
+    const Atmosphere& source, Length bottomHeight, Length topHeight,
+    double relativeError, const std::vector<Length>& breakpoints)
+    : m_bottomHeight(bottomHeight), m_topHeight(topHeight) {
+  if (!(topHeight > bottomHeight) || !(relativeError > 0.0))
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+
+  // initial segments between the breakpoints, refined from the top down so
+  // that the pending segments are in ascending order when popped
+  std::vector<double> pending = {topHeight.getValue()};
+  std::vector<Length> inner = breakpoints;
+  std::sort(inner.begin(), inner.end());
+  for (auto h = inner.rbegin(); h != inner.rend(); ++h)
+    if (*h > bottomHeight && *h < topHeight) pending.push_back(h->getValue());
+  pending.push_back(bottomHeight.getValue());
+
+  // a segment that cannot meet the bound at this width is a discontinuity
+  double minWidth = 1e-9 * (topHeight - bottomHeight).getValue();
+  double bound = SAFETY_FACTOR * relativeError;
+
+  double h_0 = pending.back();
+  pending.pop_back();
+  while (!pending.empty()) {
+    double h_1 = pending.back();
+    double width = h_1 - h_0;
+
+    Segment segment;
+    segment.h_0 = h_0;
+    segment.invWidth = 1.0 / width;
+    double T[4], P[4], rho[4];
+    for (size_t i = 0; i < 4; ++i) {
+      AtmosphereState state = source.getAtmosphereStateByHeight(
+          Length(i < 3 ? h_0 + width * i / 3.0 : h_1));
+      T[i] = state.T.getValue();
+      P[i] = state.P.getValue();
+      rho[i] = state.rho.getValue();
+    }
+    fitCubic(T, segment.T);
+    fitCubic(P, segment.P);
+    fitCubic(rho, segment.rho);
+
+    bool accurate = true;
+    for (size_t i = 0; i < TEST_POINT_COUNT && accurate; ++i) {
+      double u = (2.0 * i + 1.0) / (2.0 * TEST_POINT_COUNT);
+      AtmosphereState state =
+          source.getAtmosphereStateByHeight(Length(h_0 + width * u));
+      accurate = withinBound(evaluateCubic(segment.T, u),
+                             state.T.getValue(), bound) &&
+                 withinBound(evaluateCubic(segment.P, u),
+                             state.P.getValue(), bound) &&
+                 withinBound(evaluateCubic(segment.rho, u),
+                             state.rho.getValue(), bound);
+    }
+
+    if (!accurate) {
+      if (width < minWidth)
+        throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                    __LINE__);
+      pending.push_back(h_0 + width / 2.0);
+      continue;
+    }
+
+    m_segments.push_back(segment);
+    m_starts.push_back(h_0);
+    h_0 = h_1;
+    pending.pop_back();
+  }
+  m_starts.push_back(topHeight.getValue());
+  m_buckets = UniformBuckets(m_starts.data(), m_starts.size());
+}
+
+Temperature TabulatedAtmosphere::getAtmosphereTemperatureByHeight(
+    Length h) const {
+  checkHeights(&h, 1);
+  return evaluate(h).T;
+}
+
+Pressure TabulatedAtmosphere::getAtmospherePressureByHeight(Length h) const {
+  checkHeights(&h, 1);
+  return evaluate(h).P;
+}
+
+Density TabulatedAtmosphere::getAtmosphereDensityByHeight(Length h) const {
+  checkHeights(&h, 1);
+  return evaluate(h).rho;
+}
+
+void TabulatedAtmosphere::getAtmosphereTemperatureByHeight(const Length* h,
+                                                           Temperature* T,
+                                                           size_t n) const {
+  checkHeights(h, n);
+  for (size_t i = 0; i < n; ++i) T[i] = evaluate(h[i]).T;
+}
+
+void TabulatedAtmosphere::getAtmospherePressureByHeight(const Length* h,
+                                                        Pressure* P,
+                                                        size_t n) const {
+  checkHeights(h, n);
+  for (size_t i = 0; i < n; ++i) P[i] = evaluate(h[i]).P;
+}
+
+void TabulatedAtmosphere::getAtmosphereDensityByHeight(const Length* h,
+                                                       Density* rho,
+                                                       size_t n) const {
+  checkHeights(h, n);
+  for (size_t i = 0; i < n; ++i) rho[i] = evaluate(h[i]).rho;
+}
+
+void TabulatedAtmosphere::getAtmosphereStateByHeight(const Length* h,
+                                                     Temperature* T,
+                                                     Pressure* P, Density* rho,
+                                                     size_t n) const {
+  checkHeights(h, n);
+  for (size_t i = 0; i < n; ++i) {
+    AtmosphereState state = evaluate(h[i]);
+    T[i] = state.T;
+    P[i] = state.P;
+    rho[i] = state.rho;
+  }
+}
+
+size_t TabulatedAtmosphere::getSegmentCount() const {
+  return m_segments.size();
+}
+
+size_t TabulatedAtmosphere::getMemoryFootprint() const {
+  return m_segments.size() * sizeof(Segment) +
+         m_starts.size() * sizeof(double) + m_buckets.getMemoryFootprint();
+}
+
+Length TabulatedAtmosphere::getBottomHeight() const { return m_bottomHeight; }
+
+Length TabulatedAtmosphere::getTopHeight() const { return m_topHeight; }
+
+void TabulatedAtmosphere::checkHeights(const Length* h, size_t n) const {
+  if (countOutOfRange(h, n, m_bottomHeight, m_topHeight) > 0)
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+}
@@ -0,0 +1,94 @@
+#ifndef TABULATEDATMOSPHERE_H_
+#define TABULATEDATMOSPHERE_H_
+
+#include <vector>
+
+#include "SpaceToolkit/AtmosphereModel.h"
+#include "SpaceToolkit/SpaceToolkitException.h"
+#include "SpaceToolkit/UniformBuckets.h"
+
+namespace SpaceToolkit {
+// Samples another atmosphere once at construction and answers queries by
+// piecewise cubic interpolation, without pow or exp calls.
+//
+// The segments are refined by bisection until the interpolated temperature,
+// pressure and density are within half the relative error bound of the source
+// at 32 test points per segment. Kinks of the source, e.g. the layer
+// boundaries of a LayeredAtmosphere, should be passed as breakpoints,
+// otherwise the segments around them become very short. The scalar state
+// query is inline, see AtmosphereModel.
+class TabulatedAtmosphere final : public AtmosphereModel<TabulatedAtmosphere> {
+ public:
+  TabulatedAtmosphere(const Atmosphere& source, Length bottomHeight,
+                      Length topHeight, double relativeError,
+                      const std::vector<Length>& breakpoints = {});
+
+  Temperature getAtmosphereTemperatureByHeight(Length h) const;
+  Pressure getAtmospherePressureByHeight(Length h) const;
+  Density getAtmosphereDensityByHeight(Length h) const;
+  AtmosphereState getAtmosphereStateByHeight(Length h) const;
+
+  void getAtmosphereTemperatureByHeight(const Length* h, Temperature* T,
+                                        size_t n) const;
+  void getAtmospherePressureByHeight(const Length* h, Pressure* P,
+                                     size_t n) const;
+  void getAtmosphereDensityByHeight(const Length* h, Density* rho,
+                                    size_t n) const;
+  void getAtmosphereStateByHeight(const Length* h, Temperature* T, Pressure* P,
+                                  Density* rho, size_t n) const;
+
+  size_t getSegmentCount() const;
+  // bytes used by the segments and the lookup table
+  size_t getMemoryFootprint() const;
+  Length getBottomHeight() const;
+  Length getTopHeight() const;
+
+ private:
+  // cubic polynomials in u = (h - h_0) / width, u in [0, 1]
+  struct Segment {
+    double h_0;
+    double invWidth;
+    double T[4];
+    double P[4];
+    double rho[4];
+  };
+
+  std::vector<Segment> m_segments;
+  std::vector<double> m_starts;  // h_0 of every segment and the top height
+  UniformBuckets m_buckets;
+  Length m_bottomHeight;
+  Length m_topHeight;
+
+  static double evaluateCubic(const double c[4], double u) {
+    return c[0] + u * (c[1] + u * (c[2] + u * c[3]));
+  }
+
+  size_t segmentOf(Length h) const;
+  AtmosphereState evaluate(Length h) const;
+  void checkHeights(const Length* h, size_t n) const;
+};
+
+inline AtmosphereState TabulatedAtmosphere::getAtmosphereStateByHeight(
+    Length h) const {
+  if (!(h >= m_bottomHeight && h <= m_topHeight))
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+  return evaluate(h);
+}
+
+// segment k with h_0[k] <= h < h_0[k + 1], the top height belongs to the last
+// segment
+inline size_t TabulatedAtmosphere::segmentOf(Length h) const {
+  return m_buckets.intervalOf(m_starts.data(), h.getValue());
+}
+
+inline AtmosphereState TabulatedAtmosphere::evaluate(Length h) const {
+  const Segment& segment = m_segments[segmentOf(h)];
+  double u = (h.getValue() - segment.h_0) * segment.invWidth;
+
+  return {Temperature(evaluateCubic(segment.T, u)),
+          Pressure(evaluateCubic(segment.P, u)),
+          Density(evaluateCubic(segment.rho, u))};
+}
+}  // namespace SpaceToolkit
+#endif  // TABULATEDATMOSPHERE_H_
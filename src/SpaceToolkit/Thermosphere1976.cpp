@@ -0,0 +1,457 @@
+#include "SpaceToolkit/Thermosphere1976.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "SpaceToolkit/Simd.h"
+
+using SpaceToolkit::AtmosphereDerivatives;
+using SpaceToolkit::AtmosphereState;
+using SpaceToolkit::Thermosphere1976;
+namespace Simd = SpaceToolkit::Simd;
+
+namespace {
+// constants of the standard, molar masses in kg / kmol
+constexpr double R_STAR = 8314.32;    // J / (kmol K)
+constexpr double K_B = 1.380622e-23;  // J / K
+constexpr double N_A = 6.022169e26;   // 1 / kmol
+constexpr double G_0 = 9.80665;       // m / s^2
+constexpr double R_0 = 6356766.0;     // effective earth radius, m
+constexpr double M_0 = 28.9644;
+
+// temperature regions, Z is the geometric altitude in m
+constexpr double Z_7 = 86000.0, T_7 = 186.8673;
+constexpr double Z_8 = 91000.0, T_C = 263.1905, A = -76.3232, a = -19942.9;
+constexpr double Z_9 = 110000.0, T_9 = 240.0, L_9 = 0.012;
+constexpr double Z_10 = 120000.0, T_10 = 360.0;
+constexpr double T_INF = 1000.0, LAMBDA = 0.01875e-3;
+constexpr double Z_TOP = 1000000.0;
+
+constexpr double GRID = 1000.0;  // node spacing of the tables
+constexpr size_t STEPS = 100;    // integration steps per segment
+
+// N2, O, O2, Ar and He are integrated from 86 km, H is added above 150 km
+enum Species { N2, O, O2, AR, HE, SPECIES_COUNT };
+constexpr double M[SPECIES_COUNT] = {28.0134, 15.9994, 31.9988, 39.948,
+                                     4.0026};
+constexpr double N_7[SPECIES_COUNT] = {1.129794e20, 8.6e16, 3.030898e19,
+                                       1.3514e18, 7.5817e14};
+
+// diffusion coefficients a / n (T / 273.15)^b, thermal diffusion factors and
+// the vertical flux terms Q (Z - U)^2 exp(-W (Z - U)^3), Z and U in km
+constexpr double DIFF_A[SPECIES_COUNT] = {0.0, 6.986e20, 4.863e20, 4.487e20,
+                                          1.7e21};
+constexpr double DIFF_B[SPECIES_COUNT] = {0.0, 0.75, 0.75, 0.87, 0.691};
+constexpr double ALPHA[SPECIES_COUNT] = {0.0, 0.0, 0.0, 0.0, -0.4};
+constexpr double FLUX_Q[SPECIES_COUNT] = {0.0, -5.809644e-4, 1.366212e-4,
+                                          9.434079e-5, -2.457369e-4};
+constexpr double FLUX_U[SPECIES_COUNT] = {0.0, 56.90311, 86.0, 86.0, 86.0};
+constexpr double FLUX_W[SPECIES_COUNT] = {0.0, 2.70624e-5, 8.333333e-5,
+                                          8.333333e-5, 6.666667e-4};
+// second flux term of O below 97 km
+constexpr double FLUX_Q_O = -3.416248e-3, FLUX_U_O = 97.0,
+                 FLUX_W_O = 5.008765e-4;
+
+// hydrogen with its upward flux PHI, fixed by the density at 500 km
+constexpr double M_H = 1.00797;
+constexpr double DIFF_A_H = 3.305e21, DIFF_B_H = 0.5, ALPHA_H = -0.25;
+constexpr double PHI = 7.2e11;  // 1 / (m^2 s)
+constexpr double Z_H = 150000.0, Z_11 = 500000.0, N_H_11 = 8.0e10;
+
+double geometricOf(double h) { return R_0 * h / (R_0 - h); }
+
+double geopotentialOf(double Z) { return R_0 * Z / (R_0 + Z); }
+
+double gravity(double Z) {
+  double r = R_0 / (R_0 + Z);
+  return G_0 * r * r;
+}
+
+// the region is chosen by zRegion, which keeps integration steps and one
+// sided derivatives at the boundaries on one side
+size_t region(double zRegion) {
+  return (zRegion > Z_8) + (zRegion > Z_9) + (zRegion > Z_10);
+}
+
+void temperature(double Z, size_t k, double& T, double& dT) {
+  switch (k) {
+    case 0:
+      T = T_7;
+      dT = 0.0;
+      return;
+    case 1: {
+      double x = (Z - Z_8) / a;
+      double root = std::sqrt(1.0 - x * x);
+      T = T_C + A * root;
+      dT = -A / a * x / root;
+      return;
+    }
+    case 2:
+      T = T_9 + L_9 * (Z - Z_9);
+      dT = L_9;
+      return;
+    default: {
+      double r = (R_0 + Z_10) / (R_0 + Z);
+      double e = std::exp(-LAMBDA * (Z - Z_10) * r);
+      T = T_INF - (T_INF - T_10) * e;
+      dT = LAMBDA * (T_INF - T_10) * r * r * e;
+    }
+  }
+}
+
+// eddy diffusion coefficient in m^2 / s
+double eddyDiffusion(double Z) {
+  double z = Z / 1000.0;
+  if (z < 95.0) return 120.0;
+  if (z < 115.0) return 120.0 * std::exp(1.0 - 400.0 / (400.0 - (z - 95.0) *
+                                                               (z - 95.0)));
+  return 0.0;
+}
+
+// d ln(n_i) / dZ of the integrated species
+void derivatives(double Z, double zRegion, const double y[SPECIES_COUNT],
+                 double dy[SPECIES_COUNT]) {
+  double T, dT;
+  temperature(Z, region(zRegion), T, dT);
+  double g = gravity(Z);
+  double K = eddyDiffusion(Z);
+  double z = Z / 1000.0;
+
+  double n[SPECIES_COUNT];
+  for (size_t i = 0; i < SPECIES_COUNT; ++i) n[i] = std::exp(y[i]);
+
+  // N2 follows the mixed atmosphere up to 100 km
+  double M_mix = zRegion < 100000.0 ? M_0 : M[N2];
+  dy[N2] = -M_mix * g / (R_STAR * T) - dT / T;
+
+  for (size_t i = O; i < SPECIES_COUNT; ++i) {
+    double nDiff = i <= O2 ? n[N2] : n[N2] + n[O] + n[O2];
+    double D = DIFF_A[i] / nDiff * std::pow(T / 273.15, DIFF_B[i]);
+    double f = g / (R_STAR * T) *
+               ((D * M[i] + K * M_mix) / (D + K) +
+                D / (D + K) * ALPHA[i] * R_STAR * dT / g);
+
+    double dz = z - FLUX_U[i];
+    double flux = FLUX_Q[i] * dz * dz * std::exp(-FLUX_W[i] * dz * dz * dz);
+    if (i == O && zRegion < FLUX_U_O * 1000.0) {
+      double du = FLUX_U_O - z;
+      flux += FLUX_Q_O * du * du * std::exp(-FLUX_W_O * du * du * du);
+    }
+    dy[i] = -f - flux / 1000.0 - dT / T;
+  }
+}
+
+// diffusion coefficient of H, which diffuses through all other species
+double diffusionH(double T, const double y[SPECIES_COUNT]) {
+  double n = 0.0;
+  for (size_t i = 0; i < SPECIES_COUNT; ++i) n += std::exp(y[i]);
+  return DIFF_A_H / n * std::pow(T / 273.15, DIFF_B_H);
+}
+
+// integrands of tau and J
+double tauIntegrand(double Z, double zRegion) {
+  double T, dT;
+  temperature(Z, region(zRegion), T, dT);
+  return M_H * gravity(Z) / (R_STAR * T);
+}
+
+double jIntegrand(double Z, double zRegion, const double y[SPECIES_COUNT],
+                  double T_11, double tau) {
+  double T, dT;
+  temperature(Z, region(zRegion), T, dT);
+  return 1.0 / diffusionH(T, y) * std::pow(T / T_11, 1.0 + ALPHA_H) *
+         std::exp(tau);
+}
+
+// cubic in u on [0, 1] with values y and slopes dy * width at both ends
+void fitHermite(double y0, double y1, double dy0, double dy1, double c[4]) {
+  double m0 = dy0 * GRID, m1 = dy1 * GRID;
+  c[0] = y0;
+  c[1] = m0;
+  c[2] = 3.0 * (y1 - y0) - 2.0 * m0 - m1;
+  c[3] = 2.0 * (y0 - y1) + m0 + m1;
+}
+
+inline double evaluateCubic(const double c[4], double u) {
+  return c[0] + u * (c[1] + u * (c[2] + u * c[3]));
+}
+
+// geometric altitude at which a table of ln P or ln rho, which decrease with
+// height, takes the value y. Newton's method starts at the linear
+// interpolation of the segment, which is close since ln P and ln rho are
+// nearly linear over 1 km.
+double altitudeOf(const double* table, double y) {
+  // the last segment k with a start value >= y, or the first one
+  size_t k = 0, end = Thermosphere1976::SEGMENT_COUNT;
+  while (end - k > 1) {
+    size_t mid = (k + end) / 2;
+    if (table[4 * mid] >= y)
+      k = mid;
+    else
+      end = mid;
+  }
+
+  const double* c = table + 4 * k;
+  double u = (c[0] - y) / (c[0] - evaluateCubic(c, 1.0));
+  for (int i = 0; i < 3; ++i) {
+    u = std::min(std::max(u, 0.0), 1.0);
+    u -= (evaluateCubic(c, u) - y) / (c[1] + u * (2.0 * c[2] + 3.0 * u * c[3]));
+  }
+  u = std::min(std::max(u, 0.0), 1.0);
+  return Z_7 + (k + u) * GRID;
+}
+
+// branch free temperature for the batch kernel, T_C + A sqrt(1 - x^2) is
+// evaluated for all heights with x clamped to its domain
+inline double batchTemperature(double Z) {
+  double x = (Z - Z_8) / a;
+  double x2 = x * x;
+  x2 = x2 < 1.0 ? x2 : 1.0;
+  double elliptical = T_C + A * std::sqrt(1.0 - x2);
+  double linear = T_9 + L_9 * (Z - Z_9);
+  double exponential =
+      T_INF -
+      (T_INF - T_10) * Simd::exp(-LAMBDA * (Z - Z_10) * (R_0 + Z_10) /
+                                 (R_0 + Z));
+
+  double T = Z > Z_10 ? exponential : linear;
+  T = Z > Z_9 ? T : elliptical;
+  return Z > Z_8 ? T : T_7;
+}
+
+SPACETOOLKIT_TARGET_CLONES
+void stateAboveKernel(const Length* h, Temperature* T, Pressure* P,
+                      Density* rho, size_t n, const double* lnP,
+                      const double* lnRho, double lowest, double top) {
+  for (size_t i = 0; i < n; ++i) {
+    double h_i = h[i].getValue();
+    // the heights at and below lowest are masked below, but are still
+    // evaluated. Clamped to [lowest, top], which also sends NaN to lowest,
+    // they stay within the table.
+    double hc = h_i > lowest ? (h_i < top ? h_i : top) : lowest;
+    double Z = R_0 * hc / (R_0 - hc);
+    double x = (Z - Z_7) / GRID;
+    int k = static_cast<int>(x);
+    k = k < int(Thermosphere1976::SEGMENT_COUNT) - 1
+            ? k
+            : int(Thermosphere1976::SEGMENT_COUNT) - 1;
+    k = k > 0 ? k : 0;
+    double u = x - k;
+
+    int j = 4 * k;
+    double lnP_i =
+        lnP[j] + u * (lnP[j + 1] + u * (lnP[j + 2] + u * lnP[j + 3]));
+    double lnRho_i =
+        lnRho[j] + u * (lnRho[j + 1] + u * (lnRho[j + 2] + u * lnRho[j + 3]));
+    double T_i = batchTemperature(Z);
+    double P_i = Simd::exp(lnP_i);
+    double rho_i = Simd::exp(lnRho_i);
+
+    if (h_i > lowest) {
+      T[i] = Temperature(T_i);
+      P[i] = Pressure(P_i);
+      rho[i] = Density(rho_i);
+    }
+  }
+}
+}  // namespace
+
+const Thermosphere1976& Thermosphere1976::instance() {
+  static const Thermosphere1976 thermosphere;
+  return thermosphere;
+}
+
+Thermosphere1976::Thermosphere1976() {
+  constexpr size_t NODE_COUNT = SEGMENT_COUNT + 1;
+
+  // ln n of the integrated species and their one sided derivatives at the
+  // nodes, SPECIES_COUNT values per node. They are kept off the stack, which
+  // may be small on the thread that constructs the first model.
+  std::vector<double> y(NODE_COUNT * SPECIES_COUNT);
+  std::vector<double> dyBelow(NODE_COUNT * SPECIES_COUNT);
+  std::vector<double> dyAbove(NODE_COUNT * SPECIES_COUNT);
+
+  // tau = int M_H g / (R* T) dZ and J = int 1 / D_H (T / T_11)^(1 + alpha_H)
+  // exp(tau) dZ from 150 km, which give the H density relative to 500 km
+  std::vector<double> tau(NODE_COUNT), J(NODE_COUNT);
+  double T_11, dT_11;
+  temperature(Z_11, region(Z_11), T_11, dT_11);
+
+  double state[SPECIES_COUNT];
+  for (size_t i = 0; i < SPECIES_COUNT; ++i) state[i] = std::log(N_7[i]);
+
+  const double dZ = GRID / STEPS;
+  double tauZ = 0.0, JZ = 0.0;
+  for (size_t k = 0; k < NODE_COUNT; ++k) {
+    double Z_k = Z_7 + k * GRID;
+    std::copy(state, state + SPECIES_COUNT, &y[k * SPECIES_COUNT]);
+    tau[k] = tauZ;
+    J[k] = JZ;
+    derivatives(Z_k, Z_k - GRID / 2, state, &dyBelow[k * SPECIES_COUNT]);
+    derivatives(Z_k, Z_k + GRID / 2, state, &dyAbove[k * SPECIES_COUNT]);
+    if (k == SEGMENT_COUNT) break;
+
+    // classic Runge-Kutta through the segment, the integrals of H by the
+    // trapezoidal rule
+    double zRegion = Z_k + GRID / 2;
+    bool withH = Z_k >= Z_H;
+    for (size_t s = 0; s < STEPS; ++s) {
+      double Z = Z_k + s * dZ;
+      double dTau0 = 0.0, dJ0 = 0.0;
+      if (withH) {
+        dTau0 = tauIntegrand(Z, zRegion);
+        dJ0 = jIntegrand(Z, zRegion, state, T_11, tauZ);
+      }
+
+      double k1[SPECIES_COUNT], k2[SPECIES_COUNT], k3[SPECIES_COUNT],
+          k4[SPECIES_COUNT], tmp[SPECIES_COUNT];
+      derivatives(Z, zRegion, state, k1);
+      for (size_t i = 0; i < SPECIES_COUNT; ++i)
+        tmp[i] = state[i] + dZ / 2 * k1[i];
+      derivatives(Z + dZ / 2, zRegion, tmp, k2);
+      for (size_t i = 0; i < SPECIES_COUNT; ++i)
+        tmp[i] = state[i] + dZ / 2 * k2[i];
+      derivatives(Z + dZ / 2, zRegion, tmp, k3);
+      for (size_t i = 0; i < SPECIES_COUNT; ++i) tmp[i] = state[i] + dZ * k3[i];
+      derivatives(Z + dZ, zRegion, tmp, k4);
+      for (size_t i = 0; i < SPECIES_COUNT; ++i)
+        state[i] += dZ / 6 * (k1[i] + 2 * k2[i] + 2 * k3[i] + k4[i]);
+
+      if (withH) {
+        tauZ += dZ / 2 * (dTau0 + tauIntegrand(Z + dZ, zRegion));
+        JZ += dZ / 2 * (dJ0 + jIntegrand(Z + dZ, zRegion, state, T_11, tauZ));
+      }
+    }
+  }
+
+  const size_t k_11 = static_cast<size_t>((Z_11 - Z_7) / GRID);
+  const size_t k_H = static_cast<size_t>((Z_H - Z_7) / GRID);
+
+  // ln P, ln rho and their derivatives at node k, with H above 150 km
+  auto nodeState = [&](size_t k, const double dy[SPECIES_COUNT], bool withH,
+                       double zRegion, double& lnP, double& lnRho,
+                       double& dLnP, double& dLnRho) {
+    double Z = Z_7 + k * GRID;
+    double T, dT;
+    temperature(Z, region(zRegion), T, dT);
+
+    double n = 0.0, nDn = 0.0, rho = 0.0, rhoDn = 0.0;
+    for (size_t i = 0; i < SPECIES_COUNT; ++i) {
+      double n_i = std::exp(y[k * SPECIES_COUNT + i]);
+      n += n_i;
+      nDn += n_i * dy[i];
+      rho += n_i * M[i];
+      rhoDn += n_i * M[i] * dy[i];
+    }
+
+    if (withH) {
+      double tau_k = tau[k] - tau[k_11];
+      double I = std::exp(-tau[k_11]) * (J[k] - J[k_11]);
+      double n_H = (N_H_11 - PHI * I) * std::pow(T_11 / T, 1.0 + ALPHA_H) *
+                   std::exp(-tau_k);
+      double dy_H = -PHI / (diffusionH(T, &y[k * SPECIES_COUNT]) * n_H) -
+                    (1.0 + ALPHA_H) * dT / T -
+                    M_H * gravity(Z) / (R_STAR * T);
+      n += n_H;
+      nDn += n_H * dy_H;
+      rho += n_H * M_H;
+      rhoDn += n_H * M_H * dy_H;
+    }
+
+    lnP = std::log(n * K_B * T);
+    lnRho = std::log(rho / N_A);
+    dLnP = nDn / n + dT / T;
+    dLnRho = rhoDn / rho;
+  };
+
+  for (size_t k = 0; k < SEGMENT_COUNT; ++k) {
+    bool withH = k >= k_H;
+    double Z_k = Z_7 + k * GRID;
+    double lnP0, lnRho0, dLnP0, dLnRho0, lnP1, lnRho1, dLnP1, dLnRho1;
+    nodeState(k, &dyAbove[k * SPECIES_COUNT], withH, Z_k + GRID / 2, lnP0,
+              lnRho0, dLnP0, dLnRho0);
+    nodeState(k + 1, &dyBelow[(k + 1) * SPECIES_COUNT], withH, Z_k + GRID / 2,
+              lnP1, lnRho1, dLnP1, dLnRho1);
+    fitHermite(lnP0, lnP1, dLnP0, dLnP1, m_lnP + 4 * k);
+    fitHermite(lnRho0, lnRho1, dLnRho0, dLnRho1, m_lnRho + 4 * k);
+  }
+}
+
+Temperature Thermosphere1976::getTemperature(Length h) const {
+  double Z = geometricOf(h.getValue());
+  double T, dT;
+  temperature(Z, region(Z), T, dT);
+  return Temperature(T);
+}
+
+AtmosphereState Thermosphere1976::getState(Length h) const {
+  double Z = geometricOf(h.getValue());
+  double x = (Z - Z_7) / GRID;
+  size_t k = std::min(static_cast<size_t>(x), SEGMENT_COUNT - 1);
+  double u = x - k;
+
+  double T, dT;
+  temperature(Z, region(Z), T, dT);
+  return {Temperature(T),
+          Pressure(std::exp(evaluateCubic(m_lnP + 4 * k, u))),
+          Density(std::exp(evaluateCubic(m_lnRho + 4 * k, u)))};
+}
+
+AtmosphereState Thermosphere1976::getState(
+    Length h, AtmosphereDerivatives& derivatives) const {
+  double Z = geometricOf(h.getValue());
+  double x = (Z - Z_7) / GRID;
+  size_t k = std::min(static_cast<size_t>(x), SEGMENT_COUNT - 1);
+  double u = x - k;
+  if (u == 0.0 && k > 0) {
+    // on a node, the end of the segment below
+    --k;
+    u = 1.0;
+  }
+
+  double T, dT;
+  temperature(Z, region(Z), T, dT);
+  const double* lnP = m_lnP + 4 * k;
+  const double* lnRho = m_lnRho + 4 * k;
+  double P = std::exp(evaluateCubic(lnP, u));
+  double rho = std::exp(evaluateCubic(lnRho, u));
+
+  // d / dh = dZ / dh d / dZ with dZ / dh = (r_0 / (r_0 - h))^2
+  double r = R_0 / (R_0 - h.getValue());
+  double dZdh = r * r;
+  double dLnP = (lnP[1] + u * (2.0 * lnP[2] + 3.0 * u * lnP[3])) / GRID;
+  double dLnRho =
+      (lnRho[1] + u * (2.0 * lnRho[2] + 3.0 * u * lnRho[3])) / GRID;
+  derivatives.dT = LapseRate(dT * dZdh);
+  derivatives.dP = PressureGradient(P * dLnP * dZdh);
+  derivatives.drho = DensityGradient(rho * dLnRho * dZdh);
+  return {Temperature(T), Pressure(P), Density(rho)};
+}
+
+void Thermosphere1976::getStateAbove(const Length* h, Temperature* T,
+                                     Pressure* P, Density* rho, size_t n,
+                                     Length lowest) const {
+  stateAboveKernel(h, T, P, rho, n, m_lnP, m_lnRho, lowest.getValue(),
+                   getTopHeight().getValue());
+}
+
+Length Thermosphere1976::getHeightByPressure(Pressure P) const {
+  return Length(geopotentialOf(altitudeOf(m_lnP, std::log(P.getValue()))));
+}
+
+Length Thermosphere1976::getHeightByDensity(Density rho) const {
+  return Length(geopotentialOf(altitudeOf(m_lnRho, std::log(rho.getValue()))));
+}
+
+size_t Thermosphere1976::regionOf(Length h) const {
+  return region(geometricOf(h.getValue()));
+}
+
+Length Thermosphere1976::getBottomHeight() const {
+  return Length(geopotentialOf(Z_7));
+}
+
+Length Thermosphere1976::getTopHeight() const {
+  return Length(geopotentialOf(Z_TOP));
+}
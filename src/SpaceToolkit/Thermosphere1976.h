@@ -0,0 +1,60 @@
+#ifndef THERMOSPHERE1976_H_
+#define THERMOSPHERE1976_H_
+
+#include "SpaceToolkit/Atmosphere.h"
+
+namespace SpaceToolkit {
+// The 86 km ... 1000 km part of the US standard atmosphere 1976, used by
+// USStandardAtmosphere1976 above its lower layers.
+//
+// The temperature follows the standard's isothermal, elliptical, linear and
+// exponential regions. Pressure and density come from the number densities of
+// N2, O, O2, Ar, He and H, which are integrated once on first use. ln P and
+// ln rho are stored as cubic Hermite polynomials on a 1 km grid, so a query
+// costs no integration.
+//
+// Heights are geopotential like in the rest of the model and are not checked,
+// the caller keeps them within [getBottomHeight(), getTopHeight()].
+class Thermosphere1976 {
+ public:
+  static constexpr size_t REGION_COUNT = 4;
+  static constexpr size_t SEGMENT_COUNT = 914;
+
+  // the tables are built on the first call
+  static const Thermosphere1976& instance();
+
+  Temperature getTemperature(Length h) const;
+  AtmosphereState getState(Length h) const;
+
+  // the state and its derivatives by geopotential height, the slopes of the
+  // tables and of the temperature profile. At a node of the tables and at a
+  // region boundary they are the derivatives from below.
+  AtmosphereState getState(Length h, AtmosphereDerivatives& derivatives) const;
+
+  // overwrites the states of the heights above lowest, heights above the top
+  // are evaluated at the top
+  void getStateAbove(const Length* h, Temperature* T, Pressure* P,
+                     Density* rho, size_t n, Length lowest) const;
+
+  // inverses of getState, the height of a pressure or density. A search for
+  // the segment and a few Newton steps on its polynomial, values beyond the
+  // tables give the bottom or top height.
+  Length getHeightByPressure(Pressure P) const;
+  Length getHeightByDensity(Density rho) const;
+
+  // 0: isothermal, 1: elliptical, 2: linear, 3: exponential temperature
+  size_t regionOf(Length h) const;
+
+  Length getBottomHeight() const;
+  Length getTopHeight() const;
+
+ private:
+  // coefficients 4 k ... 4 k + 3 are the Hermite polynomial of segment k in
+  // u = (Z - Z_k) / 1 km
+  double m_lnP[4 * SEGMENT_COUNT];
+  double m_lnRho[4 * SEGMENT_COUNT];
+
+  Thermosphere1976();
+};
+}  // namespace SpaceToolkit
+#endif  // THERMOSPHERE1976_H_
@@ -0,0 +1,78 @@
+#include "SpaceToolkit/ThreadPool.h"
+
+#include <algorithm>
+
+using SpaceToolkit::ThreadPool;
+
+ThreadPool::ThreadPool(size_t threadCount)
+    : m_task(nullptr),
+      m_generation(0),
+      m_busyWorkers(0),
+      m_stop(false),
+      m_failed(false) {
+  if (threadCount == 0)
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+  for (size_t i = 1; i < threadCount; ++i)
+    m_workers.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_wake.notify_all();
+  for (std::thread& worker : m_workers) worker.join();
+}
+
+size_t ThreadPool::getThreadCount() const { return m_workers.size() + 1; }
+
+void ThreadPool::run(const Task& task) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_task = &task;
+    m_failed = false;
+    m_error = nullptr;
+    m_busyWorkers = m_workers.size();
+    ++m_generation;
+  }
+  m_wake.notify_all();
+
+  execute(0);
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_done.wait(lock, [&] { return m_busyWorkers == 0; });
+  m_task = nullptr;
+  if (m_error) std::rethrow_exception(m_error);
+}
+
+bool ThreadPool::hasFailed() const { return m_failed; }
+
+void ThreadPool::workerLoop(size_t index) {
+  size_t generation = 0;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_wake.wait(lock, [&] { return m_stop || m_generation != generation; });
+      if (m_stop) return;
+      generation = m_generation;
+    }
+
+    execute(index);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (--m_busyWorkers == 0) m_done.notify_one();
+  }
+}
+
+// calls the task and keeps the first exception of the run
+void ThreadPool::execute(size_t index) {
+  try {
+    (*m_task)(index);
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_error) m_error = std::current_exception();
+    m_failed = true;
+  }
+}
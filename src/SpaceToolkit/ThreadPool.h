@@ -0,0 +1,57 @@
+#ifndef THREADPOOL_H_
+#define THREADPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SpaceToolkit {
+// The persistent threads of AtmosphereSweep and NozzleSweep. A run calls the
+// task once on every thread of the pool, with the index of the thread, 0 for
+// the calling thread, and returns when all calls have returned. How the work
+// is split is up to the task: it takes work until none is left or
+// hasFailed().
+//
+// If a call throws, the run rethrows the first exception once all calls
+// have returned. One run takes place at a time per pool.
+class ThreadPool {
+ public:
+  using Task = std::function<void(size_t index)>;
+
+  // threadCount threads including the caller, 0 for one per hardware thread
+  explicit ThreadPool(size_t threadCount = 0);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  size_t getThreadCount() const;
+
+  void run(const Task& task);
+
+  // whether a call of the current run has thrown
+  bool hasFailed() const;
+
+ private:
+  std::vector<std::thread> m_workers;
+
+  std::mutex m_mutex;
+  std::condition_variable m_wake;
+  std::condition_variable m_done;
+  const Task* m_task;
+  size_t m_generation;
+  size_t m_busyWorkers;
+  bool m_stop;
+  std::exception_ptr m_error;
+  std::atomic<bool> m_failed;
+
+  void workerLoop(size_t index);
+  void execute(size_t index);
+};
+}  // namespace SpaceToolkit
+#endif  // THREADPOOL_H_
@@ -1,145 +1,412 @@
 #include "SpaceToolkit/USStandardAtmosphere1976.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "SpaceToolkit/Simd.h"
 #include "SpaceToolkit/SpaceToolkitException.h"
 
+using SpaceToolkit::AtmosphereLayer;
+using SpaceToolkit::AtmosphereState;
+using SpaceToolkit::AtmosphereStatus;
+using SpaceToolkit::ConstexprLayeredAtmosphere;
+using SpaceToolkit::LayeredAtmosphere;
+using SpaceToolkit::OutOfRangePolicy;
 using SpaceToolkit::SpaceToolkitException;
+using SpaceToolkit::Thermosphere1976;
 using SpaceToolkit::USStandardAtmosphere1976;
 
-// standard atmosphere data at sea level
-constexpr Temperature T_0 = 288.15_K;
-constexpr Pressure P_0 = 101325_Pa;
-constexpr Density Rho_0 = 1.2250_kgpm3;
+// the layers up to 85 km, evaluated at compile time
+constexpr ConstexprLayeredAtmosphere<7> LOWER =
+    USStandardAtmosphere1976::constexprLowerAtmosphere();
+
+constexpr Length H_LOWER_TOP = LOWER.getTopHeight();
+constexpr Length Z_TOP = 1000000_m;  // geometric altitude of the top
+
+// effective earth radius of the geopotential height
+constexpr double R_0 = 6356766.0;
+
+// batch queries are evaluated in chunks, which keeps the masks on the stack
+constexpr size_t CHUNK = 1024;
+
+namespace {
+SPACETOOLKIT_TARGET_CLONES
+size_t countAbove(const Length* h, size_t n, Length lowest) {
+  size_t count = 0;
+  for (size_t i = 0; i < n; ++i) count += h[i] > lowest;
+  return count;
+}
+
+SPACETOOLKIT_TARGET_CLONES
+size_t countAbove(const float* h, size_t n, float lowest) {
+  size_t count = 0;
+  for (size_t i = 0; i < n; ++i) count += h[i] > lowest;
+  return count;
+}
+
+// geopotential heights of geometric altitudes, rounding at the top is clamped
+// so that the heights stay in range
+SPACETOOLKIT_TARGET_CLONES
+void geopotentialKernel(const Length* z, Length* h, size_t n, double top) {
+  for (size_t i = 0; i < n; ++i) {
+    double z_i = z[i].getValue();
+    double h_i = R_0 * z_i / (R_0 + z_i);
+    h[i] = Length(h_i < top ? h_i : top);
+  }
+}
+
+// heights of pressures or densities x, which are in range. The layers take
+// the chunk with the values below the junction raised to it, and the
+// thermosphere overwrites the heights of these values.
+template <typename Unit, typename Layers, typename Upper>
+void heightsOf(const Unit* x, Length* h, size_t n, Unit junction,
+               Layers layers, Upper upper) {
+  Unit clamped[CHUNK];
+  for (size_t i = 0; i < n; i += CHUNK) {
+    size_t m = std::min(CHUNK, n - i);
+    size_t below = 0;
+    for (size_t j = 0; j < m; ++j) {
+      below += x[i + j] < junction;
+      clamped[j] = x[i + j] < junction ? junction : x[i + j];
+    }
 
-constexpr MolarMass M_a =
-    0.0289644_kgpmol;  // molar mass of the atmosphere up tp 85 km
+    layers(clamped, h + i, m);
+    if (below == 0) continue;
+    for (size_t j = 0; j < m; ++j) {
+      if (x[i + j] < junction)
+        h[i + j] = std::max(upper(x[i + j]), H_LOWER_TOP);
+    }
+  }
+}
+}  // namespace
+
+USStandardAtmosphere1976::USStandardAtmosphere1976()
+    : m_lower(LOWER.toLayeredAtmosphere()),
+      m_upper(Thermosphere1976::instance()),
+      m_topHeight(m_upper.getTopHeight()),
+      m_topPressure(m_upper.getState(m_topHeight).P),
+      m_topDensity(m_upper.getState(m_topHeight).rho) {}
 
 Temperature USStandardAtmosphere1976::getAtmosphereTemperatureByHeight(
-    Length h) {
-  Temperature ret = 0_K;
-
-  if (h >= 0_m && h <= 11000_m)
-    ret = -1 * 0.0065_Kpm * h + T_0;
-  else if (h > 11000_m && h <= 20000_m)
-    ret = 216.65_K;
-  else if (h > 20000_m && h <= 32000_m)
-    ret = 0.001 * kelvin / metre * h + 196.65_K;
-  else if (h > 32000_m && h <= 47000_m)
-    ret = 0.0028 * kelvin / metre * h + 139.05_K;
-  else if (h > 47000_m && h <= 51000_m)
-    ret = 270.65_K;
-  else if (h > 51000_m && h <= 71000_m)
-    ret = -1 * 0.0028 * kelvin / metre * h + 413.45_K;
-  else if (h > 71000_m && h <= 85000_m)
-    ret = -1 * 0.002 * kelvin / metre * h + 356.65_K;
-  else
+    Length h) const {
+  checkHeights(&h, 1);
+  if (h <= H_LOWER_TOP) return m_lower.getAtmosphereTemperatureByHeight(h);
+  return m_upper.getTemperature(h);
+}
+
+Pressure USStandardAtmosphere1976::getAtmospherePressureByHeight(
+    Length h) const {
+  checkHeights(&h, 1);
+  if (h <= H_LOWER_TOP) return m_lower.getAtmospherePressureByHeight(h);
+  return m_upper.getState(h).P;
+}
+
+Density USStandardAtmosphere1976::getAtmosphereDensityByHeight(
+    Length h) const {
+  checkHeights(&h, 1);
+  if (h <= H_LOWER_TOP) return m_lower.getAtmosphereDensityByHeight(h);
+  return m_upper.getState(h).rho;
+}
+
+void USStandardAtmosphere1976::getAtmosphereTemperatureByHeight(
+    const Length* h, Temperature* T, size_t n) const {
+  checkHeights(h, n);
+  if (countAbove(h, n, H_LOWER_TOP) == 0) {
+    m_lower.getAtmosphereTemperatureByHeight(h, T, n);
+    return;
+  }
+
+  Pressure P[CHUNK];
+  Density rho[CHUNK];
+  for (size_t i = 0; i < n; i += CHUNK)
+    evaluate(h + i, T + i, P, rho, std::min(CHUNK, n - i));
+}
+
+void USStandardAtmosphere1976::getAtmospherePressureByHeight(const Length* h,
+                                                             Pressure* P,
+                                                             size_t n) const {
+  checkHeights(h, n);
+  if (countAbove(h, n, H_LOWER_TOP) == 0) {
+    m_lower.getAtmospherePressureByHeight(h, P, n);
+    return;
+  }
+
+  Temperature T[CHUNK];
+  Density rho[CHUNK];
+  for (size_t i = 0; i < n; i += CHUNK)
+    evaluate(h + i, T, P + i, rho, std::min(CHUNK, n - i));
+}
+
+void USStandardAtmosphere1976::getAtmosphereDensityByHeight(const Length* h,
+                                                            Density* rho,
+                                                            size_t n) const {
+  checkHeights(h, n);
+  if (countAbove(h, n, H_LOWER_TOP) == 0) {
+    m_lower.getAtmosphereDensityByHeight(h, rho, n);
+    return;
+  }
+
+  Temperature T[CHUNK];
+  Pressure P[CHUNK];
+  for (size_t i = 0; i < n; i += CHUNK)
+    evaluate(h + i, T, P, rho + i, std::min(CHUNK, n - i));
+}
+
+void USStandardAtmosphere1976::getAtmosphereStateByHeight(const Length* h,
+                                                          Temperature* T,
+                                                          Pressure* P,
+                                                          Density* rho,
+                                                          size_t n) const {
+  checkHeights(h, n);
+  evaluate(h, T, P, rho, n);
+}
+
+void USStandardAtmosphere1976::getAtmosphereStateByHeight(const float* h,
+                                                          float* T, float* P,
+                                                          float* rho,
+                                                          size_t n) const {
+  float bottom = static_cast<float>(getBottomHeight().getValue());
+  float top = static_cast<float>(getTopHeight().getValue());
+  if (countOutOfRange(h, n, bottom, top) > 0)
     throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
                                 __LINE__);
 
-  return ret;
-}
-
-Pressure USStandardAtmosphere1976::getAtmospherePressureByHeight(Length h) {
-  Pressure ret = 0_Pa;
-
-  if (h >= 0_m && h <= 11000_m) {
-    Length h_b = 0_m;
-    LapseRate L_b = -1 * 0.0065_Kpm;
-    Pressure P_b = P_0;
-    Temperature T_b = getAtmosphereTemperatureByHeight(h_b);
-    ret = P_b * Ppow(T_b / (T_b + L_b * (h - h_b)), g_0 * M_a / (R * L_b));
-  } else if (h > 11000_m && h <= 20000_m) {
-    Length h_b = 11000_m;
-    Pressure P_b = getAtmospherePressureByHeight(h_b);
-    Temperature T_b = getAtmosphereTemperatureByHeight(h_b);
-    ret = P_b * Pexp(-1 * g_0 * M_a * (h - h_b) / (R * T_b));
-  } else if (h > 20000_m && h <= 32000_m) {
-    Length h_b = 20000_m;
-    LapseRate L_b = 0.001_Kpm;
-    Pressure P_b = getAtmospherePressureByHeight(h_b);
-    Temperature T_b = getAtmosphereTemperatureByHeight(h_b);
-    ret = P_b * Ppow(T_b / (T_b + L_b * (h - h_b)), g_0 * M_a / (R * L_b));
-  } else if (h > 32000_m && h <= 47000_m) {
-    Length h_b = 32000_m;
-    LapseRate L_b = 0.0028_Kpm;
-    Pressure P_b = getAtmospherePressureByHeight(h_b);
-    Temperature T_b = getAtmosphereTemperatureByHeight(h_b);
-    ret = P_b * Ppow(T_b / (T_b + L_b * (h - h_b)), g_0 * M_a / (R * L_b));
-  } else if (h > 47000_m && h <= 51000_m) {
-    Length h_b = 47000_m;
-    Pressure P_b = getAtmospherePressureByHeight(h_b);
-    Temperature T_b = getAtmosphereTemperatureByHeight(h_b);
-    ret = P_b * Pexp(-1 * g_0 * M_a * (h - h_b) / (R * T_b));
-  } else if (h > 51000_m && h <= 71000_m) {
-    Length h_b = 51000_m;
-    LapseRate L_b = -1 * 0.0028_Kpm;
-    Pressure P_b = getAtmospherePressureByHeight(h_b);
-    Temperature T_b = getAtmosphereTemperatureByHeight(h_b);
-    ret = P_b * Ppow(T_b / (T_b + L_b * (h - h_b)), g_0 * M_a / (R * L_b));
-  } else if (h > 71000_m && h <= 85000_m) {
-    Length h_b = 71000_m;
-    LapseRate L_b = -1 * 0.002_Kpm;
-    Pressure P_b = getAtmospherePressureByHeight(h_b);
-    Temperature T_b = getAtmosphereTemperatureByHeight(h_b);
-    ret = P_b * Ppow(T_b / (T_b + L_b * (h - h_b)), g_0 * M_a / (R * L_b));
-  } else {
+  const float lowerTop = static_cast<float>(H_LOWER_TOP.getValue());
+  if (countAbove(h, n, lowerTop) == 0) {
+    m_lower.getAtmosphereStateByHeight(h, T, P, rho, n);
+    return;
+  }
+
+  // the lower layers take the chunk with the heights above 85 km lowered to
+  // it, the thermosphere overwrites the states of these heights
+  float lowered[CHUNK];
+  Length h_upper[CHUNK];
+  Temperature T_upper[CHUNK];
+  Pressure P_upper[CHUNK];
+  Density rho_upper[CHUNK];
+  for (size_t i = 0; i < n; i += CHUNK) {
+    size_t m = std::min(CHUNK, n - i);
+    size_t above = 0;
+    for (size_t j = 0; j < m; ++j) {
+      above += h[i + j] > lowerTop;
+      lowered[j] = h[i + j] < lowerTop ? h[i + j] : lowerTop;
+    }
+
+    m_lower.getAtmosphereStateByHeight(lowered, T + i, P + i, rho + i, m);
+    if (above == 0) continue;
+
+    for (size_t j = 0; j < m; ++j) h_upper[j] = Length(h[i + j]);
+    m_upper.getStateAbove(h_upper, T_upper, P_upper, rho_upper, m,
+                          H_LOWER_TOP);
+    for (size_t j = 0; j < m; ++j) {
+      if (!(h[i + j] > lowerTop)) continue;
+      T[i + j] = static_cast<float>(T_upper[j].getValue());
+      P[i + j] = static_cast<float>(P_upper[j].getValue());
+      rho[i + j] = static_cast<float>(rho_upper[j].getValue());
+    }
+  }
+}
+
+void USStandardAtmosphere1976::getAtmosphereProfile(Length bottom,
+                                                    Length step,
+                                                    Temperature* T,
+                                                    Pressure* P, Density* rho,
+                                                    size_t n) const {
+  if (n == 0) return;
+  Length top = bottom + double(n - 1) * step;
+  if (!(step > 0_m && bottom >= getBottomHeight() && top <= m_topHeight))
     throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
                                 __LINE__);
+
+  size_t lower = countProfileUpTo(bottom, step, n, H_LOWER_TOP);
+  m_lower.getAtmosphereProfile(bottom, step, T, P, rho, lower);
+
+  Length h[CHUNK];
+  for (size_t i = lower; i < n; i += CHUNK) {
+    size_t m = std::min(CHUNK, n - i);
+    for (size_t j = 0; j < m; ++j)
+      h[j] = Length(bottom.getValue() + (i + j) * step.getValue());
+    m_upper.getStateAbove(h, T + i, P + i, rho + i, m, H_LOWER_TOP);
   }
+}
 
-  return ret;
-}
-
-Density USStandardAtmosphere1976::getAtmosphereDensityByHeight(Length h) {
-  Density ret = 0_kgpm3;
-
-  if (h >= 0_m && h <= 11000_m) {
-    Length h_b = 0_m;
-    LapseRate L_b = -1 * 0.0065_Kpm;
-    Density Rho_b = Rho_0;
-    Temperature T_b = getAtmosphereTemperatureByHeight(h_b);
-    ret = Rho_0 * Ppow(T_b / (T_b + L_b * (h - h_b)),
-                       (Number)1.0 + g_0 * M_a / (R * L_b));
-  } else if (h > 11000_m && h <= 20000_m) {
-    Length h_b = 11000_m;
-    Density Rho_0 = getAtmosphereDensityByHeight(h_b);
-    Temperature T_b = getAtmosphereTemperatureByHeight(h_b);
-    ret = Rho_0 * Pexp(-1 * g_0 * M_a * (h - h_b) / (R * T_b));
-  } else if (h > 20000_m && h <= 32000_m) {
-    Length h_b = 20000_m;
-    LapseRate L_b = 0.001_Kpm;
-    Density Rho_0 = getAtmosphereDensityByHeight(h_b);
-    Temperature T_b = getAtmosphereTemperatureByHeight(h_b);
-    ret = Rho_0 * Ppow(T_b / (T_b + L_b * (h - h_b)),
-                       (Number)1.0 + g_0 * M_a / (R * L_b));
-  } else if (h > 32000_m && h <= 47000_m) {
-    Length h_b = 32000_m;
-    LapseRate L_b = 0.0028_Kpm;
-    Density Rho_0 = getAtmosphereDensityByHeight(h_b);
-    Temperature T_b = getAtmosphereTemperatureByHeight(h_b);
-    ret = Rho_0 * Ppow(T_b / (T_b + L_b * (h - h_b)),
-                       (Number)1.0 + g_0 * M_a / (R * L_b));
-  } else if (h > 47000_m && h <= 51000_m) {
-    Length h_b = 47000_m;
-    Density Rho_0 = getAtmosphereDensityByHeight(h_b);
-    Temperature T_b = getAtmosphereTemperatureByHeight(h_b);
-    ret = Rho_0 * Pexp(-1 * g_0 * M_a * (h - h_b) / (R * T_b));
-  } else if (h > 51000_m && h <= 71000_m) {
-    Length h_b = 51000_m;
-    LapseRate L_b = -1 * 0.0028_Kpm;
-    Density Rho_0 = getAtmosphereDensityByHeight(h_b);
-    Temperature T_b = getAtmosphereTemperatureByHeight(h_b);
-    ret = Rho_0 * Ppow(T_b / (T_b + L_b * (h - h_b)),
-                       (Number)1.0 + g_0 * M_a / (R * L_b));
-  } else if (h > 71000_m && h <= 85000_m) {
-    Length h_b = 71000_m;
-    LapseRate L_b = -1 * 0.002_Kpm;
-    Density Rho_0 = getAtmosphereDensityByHeight(h_b);
-    Temperature T_b = getAtmosphereTemperatureByHeight(h_b);
-    ret = Rho_0 * Ppow(T_b / (T_b + L_b * (h - h_b)),
-                       (Number)1.0 + g_0 * M_a / (R * L_b));
-  } else {
+AtmosphereState USStandardAtmosphere1976::getAtmosphereStateByAltitude(
+    Length z) const {
+  if (!(z >= 0_m && z <= Z_TOP))
     throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
                                 __LINE__);
+
+  return evaluate(std::min(toGeopotentialHeight(z), getTopHeight()));
+}
+
+void USStandardAtmosphere1976::getAtmosphereStateByAltitude(const Length* z,
+                                                            Temperature* T,
+                                                            Pressure* P,
+                                                            Density* rho,
+                                                            size_t n) const {
+  if (countOutOfRange(z, n, 0_m, Z_TOP) > 0)
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+
+  // the heights of a chunk stay in the L1 cache between conversion and
+  // evaluation
+  Length h[CHUNK];
+  for (size_t i = 0; i < n; i += CHUNK) {
+    size_t m = std::min(CHUNK, n - i);
+    geopotentialKernel(z + i, h, m, getTopHeight().getValue());
+    evaluate(h, T + i, P + i, rho + i, m);
   }
+}
+
+Length USStandardAtmosphere1976::getHeightByPressure(Pressure P) const {
+  if (!(P >= m_topPressure && P <= m_lower.getBottomPressure()))
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+
+  // the pressure jumps slightly at the junction, pressures in the gap give
+  // the junction height
+  if (P >= m_lower.getTopPressure()) return m_lower.getHeightByPressure(P);
+  return std::max(m_upper.getHeightByPressure(P), H_LOWER_TOP);
+}
+
+Length USStandardAtmosphere1976::getHeightByDensity(Density rho) const {
+  if (!(rho >= m_topDensity && rho <= m_lower.getBottomDensity()))
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+
+  if (rho >= m_lower.getTopDensity()) return m_lower.getHeightByDensity(rho);
+  return std::max(m_upper.getHeightByDensity(rho), H_LOWER_TOP);
+}
+
+void USStandardAtmosphere1976::getHeightByPressure(const Pressure* P,
+                                                   Length* h,
+                                                   size_t n) const {
+  if (countOutOfRange(P, n, m_topPressure, m_lower.getBottomPressure()) > 0)
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+
+  heightsOf(
+      P, h, n, m_lower.getTopPressure(),
+      [this](const Pressure* x, Length* y, size_t m) {
+        m_lower.getHeightByPressure(x, y, m);
+      },
+      [this](Pressure x) { return m_upper.getHeightByPressure(x); });
+}
 
-  return ret;
+void USStandardAtmosphere1976::getHeightByDensity(const Density* rho,
+                                                  Length* h, size_t n) const {
+  if (countOutOfRange(rho, n, m_topDensity, m_lower.getBottomDensity()) > 0)
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+
+  heightsOf(
+      rho, h, n, m_lower.getTopDensity(),
+      [this](const Density* x, Length* y, size_t m) {
+        m_lower.getHeightByDensity(x, y, m);
+      },
+      [this](Density x) { return m_upper.getHeightByDensity(x); });
+}
+
+AtmosphereStatus USStandardAtmosphere1976::tryGetAtmosphereStateByHeight(
+    Length h, AtmosphereState& state, OutOfRangePolicy policy) const noexcept {
+  AtmosphereStatus status = AtmosphereStatus::Ok;
+  if (!(h >= getBottomHeight())) {
+    status = AtmosphereStatus::BelowRange;
+    h = getBottomHeight();
+  } else if (h > getTopHeight()) {
+    status = AtmosphereStatus::AboveRange;
+    h = getTopHeight();
+  }
+
+  if (status != AtmosphereStatus::Ok && policy == OutOfRangePolicy::NaN) {
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    state = {Temperature(nan), Pressure(nan), Density(nan)};
+    return status;
+  }
+
+  state = evaluate(h);
+  return status;
+}
+
+size_t USStandardAtmosphere1976::tryGetAtmosphereStateByHeight(
+    const Length* h, Temperature* T, Pressure* P, Density* rho, size_t n,
+    uint64_t* outOfRange, OutOfRangePolicy policy) const noexcept {
+  size_t count = markOutOfRange(h, n, getBottomHeight(), getTopHeight(),
+                                outOfRange);
+
+  // heights below the range are clamped by the lower layers, heights above
+  // by the thermosphere
+  evaluate(h, T, P, rho, n);
+  if (count > 0 && policy == OutOfRangePolicy::NaN) {
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    for (size_t i = 0; i < n; ++i) {
+      if (!(outOfRange[i / 64] >> (i % 64) & 1)) continue;
+      T[i] = Temperature(nan);
+      P[i] = Pressure(nan);
+      rho[i] = Density(nan);
+    }
+  }
+  return count;
+}
+
+Length USStandardAtmosphere1976::toGeopotentialHeight(Length z) {
+  return Length(R_0 * z.getValue() / (R_0 + z.getValue()));
+}
+
+Length USStandardAtmosphere1976::toGeometricAltitude(Length h) {
+  return Length(R_0 * h.getValue() / (R_0 - h.getValue()));
+}
+
+const LayeredAtmosphere& USStandardAtmosphere1976::getLowerAtmosphere() const {
+  return m_lower;
+}
+
+const Thermosphere1976& USStandardAtmosphere1976::getThermosphere() const {
+  return m_upper;
+}
+
+std::vector<AtmosphereLayer> USStandardAtmosphere1976::layers() {
+  std::vector<AtmosphereLayer> layers;
+  for (size_t k = 0; k < LOWER.getLayerCount(); ++k)
+    layers.push_back(LOWER.getLayer(k));
+  return layers;
+}
+
+LayeredAtmosphere USStandardAtmosphere1976::withTemperatureOffset(
+    Temperature offset) {
+  return LayeredAtmosphere(layers(), H_LOWER_TOP,
+                           LOWER.getBaseTemperature() + offset,
+                           LOWER.getBasePressure(), LOWER.getMolarMass(),
+                           LOWER.getGravity());
+}
+
+// state of a height in range, or clamped to it
+AtmosphereState USStandardAtmosphere1976::evaluate(Length h) const noexcept {
+  if (h > H_LOWER_TOP) return m_upper.getState(std::min(h, getTopHeight()));
+
+  AtmosphereState state;
+  m_lower.tryGetAtmosphereStateByHeight(h, state);
+  return state;
+}
+
+// states of heights in range, or clamped to it
+void USStandardAtmosphere1976::evaluate(const Length* h, Temperature* T,
+                                        Pressure* P, Density* rho,
+                                        size_t n) const noexcept {
+  uint64_t outOfRange[CHUNK / 64];
+  for (size_t i = 0; i < n; i += CHUNK) {
+    size_t m = std::min(CHUNK, n - i);
+    size_t above = countAbove(h + i, m, H_LOWER_TOP);
+    if (above < m)
+      m_lower.tryGetAtmosphereStateByHeight(h + i, T + i, P + i, rho + i, m,
+                                            outOfRange);
+    if (above > 0)
+      m_upper.getStateAbove(h + i, T + i, P + i, rho + i, m, H_LOWER_TOP);
+  }
+}
+
+void USStandardAtmosphere1976::checkHeights(const Length* h, size_t n) const {
+  if (countOutOfRange(h, n, getBottomHeight(), getTopHeight()) > 0)
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
 }
@@ -1,14 +1,162 @@
 #ifndef USSTANDARDATMOSPHERE1976_H_
 #define USSTANDARDATMOSPHERE1976_H_
 
-#include "SpaceToolkit/Atmosphere.h"
+#include <vector>
+
+#include "SpaceToolkit/AtmosphereModel.h"
+#include "SpaceToolkit/ConstexprLayeredAtmosphere.h"
+#include "SpaceToolkit/LayeredAtmosphere.h"
+#include "SpaceToolkit/SpaceToolkitException.h"
+#include "SpaceToolkit/Thermosphere1976.h"
 
 namespace SpaceToolkit {
-class USStandardAtmosphere1976 : Atmosphere {
+// US standard atmosphere 1976 from sea level to 1000 km geometric altitude.
+// Heights h are geopotential, altitudes z geometric, see toGeopotentialHeight.
+// The layers with linear temperature profiles reach
+// up to 85 km, above that the thermosphere model takes over. Temperature
+// differs by 0.2 K at the junction since the lower layers give the molecular
+// scale temperature. The scalar state query is inline, see AtmosphereModel.
+class USStandardAtmosphere1976 final
+    : public AtmosphereModel<USStandardAtmosphere1976> {
  public:
-  Temperature getAtmosphereTemperatureByHeight(Length h);
-  Pressure getAtmospherePressureByHeight(Length h);
-  Density getAtmosphereDensityByHeight(Length h);
+  USStandardAtmosphere1976();
+
+  Temperature getAtmosphereTemperatureByHeight(Length h) const;
+  Pressure getAtmospherePressureByHeight(Length h) const;
+  Density getAtmosphereDensityByHeight(Length h) const;
+  AtmosphereState getAtmosphereStateByHeight(Length h) const;
+
+  // the state and its derivatives by geopotential height from the same
+  // evaluation, e.g. for implicit integrators, see LayeredAtmosphere and
+  // Thermosphere1976. At a boundary of the layers or of the thermosphere
+  // regions the derivatives are the ones from below, up to the junction at
+  // 85 km, which belongs to the lower layers.
+  AtmosphereState getAtmosphereStateByHeight(
+      Length h, AtmosphereDerivatives& derivatives) const;
+
+  void getAtmosphereTemperatureByHeight(const Length* h, Temperature* T,
+                                        size_t n) const;
+  void getAtmospherePressureByHeight(const Length* h, Pressure* P,
+                                     size_t n) const;
+  void getAtmosphereDensityByHeight(const Length* h, Density* rho,
+                                    size_t n) const;
+  void getAtmosphereStateByHeight(const Length* h, Temperature* T, Pressure* P,
+                                  Density* rho, size_t n) const;
+
+  // single precision batch query, see LayeredAtmosphere. Above 85 km the
+  // thermosphere is evaluated in double precision and rounded.
+  void getAtmosphereStateByHeight(const float* h, float* T, float* P,
+                                  float* rho, size_t n) const;
+
+  // profile of the n heights bottom + i * step with step > 0, by the
+  // recurrences of LayeredAtmosphere up to 85 km and the thermosphere batch
+  // evaluation above. Throws if a height is out of range.
+  void getAtmosphereProfile(Length bottom, Length step, Temperature* T,
+                            Pressure* P, Density* rho, size_t n) const;
+
+  // queries by geometric altitude, the conversion to geopotential height is
+  // part of the evaluation
+  AtmosphereState getAtmosphereStateByAltitude(Length z) const;
+  void getAtmosphereStateByAltitude(const Length* z, Temperature* T,
+                                    Pressure* P, Density* rho,
+                                    size_t n) const;
+
+  // inverse queries, the height of a pressure or density: closed form in the
+  // layers up to 85 km, see LayeredAtmosphere, and a few Newton steps on the
+  // thermosphere tables above. Throws if a value is out of range.
+  Length getHeightByPressure(Pressure P) const;
+  Length getHeightByDensity(Density rho) const;
+  void getHeightByPressure(const Pressure* P, Length* h, size_t n) const;
+  void getHeightByDensity(const Density* rho, Length* h, size_t n) const;
+
+  // non-throwing queries, see LayeredAtmosphere
+  AtmosphereStatus tryGetAtmosphereStateByHeight(
+      Length h, AtmosphereState& state,
+      OutOfRangePolicy policy = OutOfRangePolicy::Clamp) const noexcept;
+  size_t tryGetAtmosphereStateByHeight(
+      const Length* h, Temperature* T, Pressure* P, Density* rho, size_t n,
+      uint64_t* outOfRange,
+      OutOfRangePolicy policy = OutOfRangePolicy::Clamp) const noexcept;
+
+  Length getBottomHeight() const;
+  Length getTopHeight() const;
+
+  // h = r_0 z / (r_0 + z) with the effective earth radius r_0 = 6356766 m of
+  // the standard, and the inverse
+  static Length toGeopotentialHeight(Length z);
+  static Length toGeometricAltitude(Length h);
+
+  // the layers up to 85 km and the thermosphere above
+  const LayeredAtmosphere& getLowerAtmosphere() const;
+  const Thermosphere1976& getThermosphere() const;
+
+  // layers of the 0 ... 85 km model
+  static std::vector<AtmosphereLayer> layers();
+
+  // the 0 ... 85 km model for compile-time evaluation, the data of the
+  // standard is defined here
+  static constexpr ConstexprLayeredAtmosphere<7> constexprLowerAtmosphere();
+
+  // hot or cold day profile of the 0 ... 85 km model: the standard
+  // temperature profile shifted by a constant offset at the standard sea
+  // level pressure
+  static LayeredAtmosphere withTemperatureOffset(Temperature offset);
+
+ private:
+  LayeredAtmosphere m_lower;
+  const Thermosphere1976& m_upper;
+  Length m_topHeight;
+  Pressure m_topPressure;
+  Density m_topDensity;
+
+  AtmosphereState evaluate(Length h) const noexcept;
+  void evaluate(const Length* h, Temperature* T, Pressure* P, Density* rho,
+                size_t n) const noexcept;
+  void checkHeights(const Length* h, size_t n) const;
 };
+
+inline AtmosphereState USStandardAtmosphere1976::getAtmosphereStateByHeight(
+    Length h) const {
+  if (!(h >= getBottomHeight() && h <= m_topHeight))
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+  if (h <= m_lower.getTopHeight()) return m_lower.getAtmosphereStateByHeight(h);
+  return m_upper.getState(h);
+}
+
+inline AtmosphereState USStandardAtmosphere1976::getAtmosphereStateByHeight(
+    Length h, AtmosphereDerivatives& derivatives) const {
+  if (!(h >= getBottomHeight() && h <= m_topHeight))
+    throw SpaceToolkitException("errInputParameterOutOfRange", __FILE__,
+                                __LINE__);
+  if (h <= m_lower.getTopHeight())
+    return m_lower.getAtmosphereStateByHeight(h, derivatives);
+  return m_upper.getState(h, derivatives);
+}
+
+constexpr ConstexprLayeredAtmosphere<7>
+USStandardAtmosphere1976::constexprLowerAtmosphere() {
+  return ConstexprLayeredAtmosphere<7>(
+      {
+          {0_m, -1 * 0.0065_Kpm},
+          {11000_m, 0_Kpm},
+          {20000_m, 0.001_Kpm},
+          {32000_m, 0.0028_Kpm},
+          {47000_m, 0_Kpm},
+          {51000_m, -1 * 0.0028_Kpm},
+          {71000_m, -1 * 0.002_Kpm},
+      },
+      85000_m, 288.15_K, 101325_Pa,
+      0.0289644_kgpmol,  // molar mass of the atmosphere up tp 85 km
+      g_0);
+}
+
+inline Length USStandardAtmosphere1976::getBottomHeight() const {
+  return m_lower.getBottomHeight();
+}
+
+inline Length USStandardAtmosphere1976::getTopHeight() const {
+  return m_topHeight;
+}
 }  // namespace SpaceToolkit
 #endif  // USSTANDARDATMOSPHERE1976_H_
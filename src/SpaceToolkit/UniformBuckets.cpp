@@ -0,0 +1,33 @@
+#include "SpaceToolkit/UniformBuckets.h"
+
+#include <cmath>
+
+using SpaceToolkit::UniformBuckets;
+
+constexpr size_t UniformBuckets::MAX_BUCKET_COUNT;
+
+UniformBuckets::UniformBuckets()
+    : m_bottom(0.0), m_invBucketWidth(0.0), m_intervalCount(0) {}
+
+UniformBuckets::UniformBuckets(const double* x, size_t count)
+    : m_bottom(x[0]), m_intervalCount(count - 1) {
+  double range = x[count - 1] - x[0];
+  double shortest = range;
+  for (size_t k = 0; k < m_intervalCount; ++k)
+    shortest = std::min(shortest, x[k + 1] - x[k]);
+  size_t bucketCount = static_cast<size_t>(
+      std::min(double(MAX_BUCKET_COUNT), std::ceil(range / shortest)));
+  m_invBucketWidth = bucketCount / range;
+
+  m_first.resize(bucketCount);
+  size_t k = 0;
+  for (size_t b = 0; b < bucketCount; ++b) {
+    double v = x[0] + b / m_invBucketWidth;
+    while (k + 1 < m_intervalCount && x[k + 1] <= v) ++k;
+    m_first[b] = static_cast<uint32_t>(k);
+  }
+}
+
+size_t UniformBuckets::getMemoryFootprint() const {
+  return m_first.size() * sizeof(uint32_t);
+}
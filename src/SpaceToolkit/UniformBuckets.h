@@ -0,0 +1,47 @@
+#ifndef UNIFORMBUCKETS_H_
+#define UNIFORMBUCKETS_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SpaceToolkit {
+// Lookup of the interval of a coordinate among ascending breakpoints
+// x_0 < ... < x_n, e.g. the segments of a TabulatedAtmosphere or the levels
+// of a GriddedAtmosphereTable. A uniform grid of buckets over [x_0, x_n]
+// holds the first interval of every bucket. The buckets are no wider than
+// the shortest interval, up to MAX_BUCKET_COUNT of them, so a lookup mostly
+// finds its interval in the first one of its bucket. The breakpoints are
+// passed to every lookup rather than kept, they must be the same as at
+// construction.
+class UniformBuckets {
+ public:
+  static constexpr size_t MAX_BUCKET_COUNT = 1 << 16;
+
+  UniformBuckets();
+  // count >= 2 breakpoints
+  UniformBuckets(const double* x, size_t count);
+
+  // interval k with x[k] <= v < x[k + 1], x_n belongs to the last interval.
+  // v must lie in [x_0, x_n].
+  size_t intervalOf(const double* x, double v) const;
+
+  // bytes of the buckets
+  size_t getMemoryFootprint() const;
+
+ private:
+  std::vector<uint32_t> m_first;
+  double m_bottom;
+  double m_invBucketWidth;
+  size_t m_intervalCount;
+};
+
+inline size_t UniformBuckets::intervalOf(const double* x, double v) const {
+  size_t b = static_cast<size_t>((v - m_bottom) * m_invBucketWidth);
+  size_t k = m_first[std::min(b, m_first.size() - 1)];
+  while (k + 1 < m_intervalCount && v >= x[k + 1]) ++k;
+  return k;
+}
+}  // namespace SpaceToolkit
+#endif  // UNIFORMBUCKETS_H_
@@ -0,0 +1,50 @@
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace Benchmark {
+// registers a benchmark which is run by main()
+struct Registration {
+  Registration(const std::string& name, std::function<void()> function);
+};
+
+// calls f repeatedly for at least 0.2 s and returns the seconds per call
+template <typename F>
+double measure(F f) {
+  using Clock = std::chrono::steady_clock;
+  f();  // warm up
+
+  size_t calls = 0;
+  auto start = Clock::now();
+  std::chrono::duration<double> elapsed(0.0);
+  do {
+    f();
+    ++calls;
+    elapsed = Clock::now() - start;
+  } while (elapsed.count() < 0.2);
+
+  return elapsed.count() / calls;
+}
+
+// prints time per element and throughput of a benchmark which processed
+// elements in seconds
+void report(const std::string& name, size_t elements, double seconds);
+
+// keeps the optimizer from discarding a result
+void doNotOptimize(double value);
+
+// returns p, which the optimizer cannot see through, e.g. to keep it from
+// devirtualizing calls on an object whose type it knows
+const void* opaque(const void* p);
+}  // namespace Benchmark
+
+#define BENCHMARK(name)                                                \
+  static void name();                                                  \
+  static Benchmark::Registration name##Registration(#name, name);      \
+  static void name()
+
+#endif  // BENCHMARK_H_
@@ -0,0 +1,31 @@
+#include "Benchmark.h"
+#include "SpaceToolkit/AtmosphereCursor.h"
+#include "SpaceToolkit/USStandardAtmosphere1976.h"
+
+using SpaceToolkit::AtmosphereCursor;
+using SpaceToolkit::USStandardAtmosphere1976;
+
+namespace {
+constexpr size_t STEPS = 10000000;
+}  // namespace
+
+// a 10^7 step ascent from the ground to the top of the model
+BENCHMARK(AtmosphereCursorAscent) {
+  USStandardAtmosphere1976 atmosphere;
+  const Length dh = 85000_m / double(STEPS);
+
+  Benchmark::report("stateless state query", STEPS, Benchmark::measure([&] {
+                      double sum = 0.0;
+                      for (size_t i = 0; i <= STEPS; ++i)
+                        sum += atmosphere.getAtmosphereStateByHeight(i * dh)
+                                   .P.getValue();
+                      Benchmark::doNotOptimize(sum);
+                    }));
+  Benchmark::report("cursor", STEPS, Benchmark::measure([&] {
+                      AtmosphereCursor cursor(atmosphere);
+                      double sum = 0.0;
+                      for (size_t i = 0; i <= STEPS; ++i)
+                        sum += cursor.moveTo(i * dh).P.getValue();
+                      Benchmark::doNotOptimize(sum);
+                    }));
+}
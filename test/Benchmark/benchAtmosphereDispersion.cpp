@@ -0,0 +1,61 @@
+#include <vector>
+
+#include "Benchmark.h"
+#include "SpaceToolkit/AtmosphereDispersion.h"
+#include "SpaceToolkit/USStandardAtmosphere1976.h"
+
+using SpaceToolkit::AtmosphereDispersion;
+using SpaceToolkit::DispersedAtmosphere;
+using SpaceToolkit::DispersionParameters;
+using SpaceToolkit::USStandardAtmosphere1976;
+
+namespace {
+constexpr size_t SAMPLES = 100000;
+constexpr size_t HEIGHTS = 1000;
+constexpr size_t BATCH_SAMPLES = 256;
+}  // namespace
+
+BENCHMARK(AtmosphereDispersionThroughput) {
+  USStandardAtmosphere1976 standard;
+  DispersionParameters parameters = {Temperature(5.0), 0.05, 0.02, 5000_m,
+                                     1000_m};
+
+  Benchmark::report("generate samples", SAMPLES, Benchmark::measure([&] {
+                      AtmosphereDispersion dispersion(standard, 0_m, 80000_m,
+                                                      parameters, 1, SAMPLES);
+                      Benchmark::doNotOptimize(dispersion.getSampleCount());
+                    }));
+
+  AtmosphereDispersion dispersion(standard, 0_m, 80000_m, parameters, 1,
+                                  SAMPLES);
+  Benchmark::report("take sample", SAMPLES, Benchmark::measure([&] {
+                      for (size_t s = 0; s < SAMPLES; s += 97)
+                        Benchmark::doNotOptimize(
+                            dispersion.getSample(s).getLogDensityScale());
+                    }) * 97);
+
+  std::vector<Length> h(HEIGHTS);
+  for (size_t i = 0; i < HEIGHTS; ++i)
+    h[i] = 80000_m * (double(i) / (HEIGHTS - 1));
+  std::vector<Temperature> T(HEIGHTS * BATCH_SAMPLES);
+  std::vector<Pressure> P(HEIGHTS * BATCH_SAMPLES);
+  std::vector<Density> rho(HEIGHTS * BATCH_SAMPLES);
+
+  Benchmark::report("state by sample, per sample batch",
+                    HEIGHTS * BATCH_SAMPLES, Benchmark::measure([&] {
+                      for (size_t s = 0; s < BATCH_SAMPLES; ++s) {
+                        DispersedAtmosphere sample = dispersion.getSample(s);
+                        sample.getAtmosphereStateByHeight(
+                            h.data(), &T[s * HEIGHTS], &P[s * HEIGHTS],
+                            &rho[s * HEIGHTS], HEIGHTS);
+                      }
+                      Benchmark::doNotOptimize(rho[HEIGHTS / 2].getValue());
+                    }));
+  Benchmark::report("state by sample, shared base", HEIGHTS * BATCH_SAMPLES,
+                    Benchmark::measure([&] {
+                      dispersion.getAtmosphereStateBySample(
+                          h.data(), HEIGHTS, 0, BATCH_SAMPLES, T.data(),
+                          P.data(), rho.data());
+                      Benchmark::doNotOptimize(rho[HEIGHTS / 2].getValue());
+                    }));
+}
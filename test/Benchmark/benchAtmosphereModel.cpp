@@ -0,0 +1,58 @@
+#include <algorithm>
+#include <vector>
+
+#include "Benchmark.h"
+#include "SpaceToolkit/LayeredAtmosphere.h"
+#include "SpaceToolkit/TabulatedAtmosphere.h"
+#include "SpaceToolkit/USStandardAtmosphere1976.h"
+
+using SpaceToolkit::Atmosphere;
+using SpaceToolkit::AtmosphereLayer;
+using SpaceToolkit::AtmosphereState;
+using SpaceToolkit::LayeredAtmosphere;
+using SpaceToolkit::TabulatedAtmosphere;
+using SpaceToolkit::USStandardAtmosphere1976;
+
+namespace {
+constexpr size_t STEPS = 1 << 20;
+
+// ballistic descent from 80 km with drag, semi-implicit Euler steps of 1 ms.
+// Instantiated on a model the queries are inlined, on Atmosphere they go
+// through the vtable.
+template <typename A>
+double descent(const A& atmosphere) {
+  const double g = 9.80665, dragPerMass = 1e-3, dt = 1e-3;
+  double h = 80000.0, v = 0.0;
+  for (size_t i = 0; i < STEPS; ++i) {
+    AtmosphereState state = atmosphere.getAtmosphereStateByHeight(Length(h));
+    v += (0.5 * dragPerMass * state.rho.getValue() * v * v - g) * dt;
+    h = std::max(h + v * dt, 0.0);
+  }
+  return v;
+}
+
+template <typename A>
+void compare(const std::string& name, const A& model) {
+  const Atmosphere& erased =
+      *static_cast<const Atmosphere*>(Benchmark::opaque(&model));
+
+  Benchmark::report(name + " virtual", STEPS, Benchmark::measure([&] {
+                      Benchmark::doNotOptimize(descent(erased));
+                    }));
+  Benchmark::report(name + " inlined", STEPS, Benchmark::measure([&] {
+                      Benchmark::doNotOptimize(descent(model));
+                    }));
+}
+}  // namespace
+
+BENCHMARK(AtmosphereModelDescent) {
+  USStandardAtmosphere1976 standard;
+  std::vector<Length> boundaries;
+  for (const AtmosphereLayer& layer : USStandardAtmosphere1976::layers())
+    boundaries.push_back(layer.baseHeight);
+  TabulatedAtmosphere table(standard, 0_m, 85000_m, 1e-6, boundaries);
+
+  compare("LayeredAtmosphere", standard.getLowerAtmosphere());
+  compare("USStandardAtmosphere1976", standard);
+  compare("TabulatedAtmosphere", table);
+}
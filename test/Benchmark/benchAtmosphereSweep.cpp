@@ -0,0 +1,63 @@
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Benchmark.h"
+#include "SpaceToolkit/AtmosphereSweep.h"
+#include "SpaceToolkit/USStandardAtmosphere1976.h"
+
+using SpaceToolkit::AtmosphereSweep;
+using SpaceToolkit::AtmosphereSweepSink;
+using SpaceToolkit::USStandardAtmosphere1976;
+
+namespace {
+constexpr size_t N = 1 << 22;
+
+// a sink which only touches the results, e.g. in place of a file writer
+class DiscardingSink : public AtmosphereSweepSink {
+ public:
+  double sum = 0.0;
+
+  void consume(size_t, const Length*, const Temperature* T, const Pressure*,
+               const Density*, size_t n) {
+    sum += T[n - 1].getValue();
+  }
+};
+}  // namespace
+
+BENCHMARK(AtmosphereSweepThroughput) {
+  USStandardAtmosphere1976 standard;
+  std::vector<Length> h(N);
+  for (size_t i = 0; i < N; ++i) h[i] = 86000_m * (double(i) / (N - 1));
+  std::vector<Temperature> T(N);
+  std::vector<Pressure> P(N);
+  std::vector<Density> rho(N);
+
+  Benchmark::report("serial batch", N, Benchmark::measure([&] {
+                      standard.getAtmosphereStateByHeight(
+                          h.data(), T.data(), P.data(), rho.data(), N);
+                      Benchmark::doNotOptimize(rho[N / 2].getValue());
+                    }));
+
+  // the speedup is bounded by the hardware threads
+  std::vector<size_t> threadCounts = {1, 2, 4};
+  if (std::thread::hardware_concurrency() > 4)
+    threadCounts.push_back(std::thread::hardware_concurrency());
+  for (size_t threadCount : threadCounts) {
+    AtmosphereSweep sweep(threadCount);
+    std::string threads = std::to_string(threadCount) + " threads";
+    Benchmark::report("sweep, " + threads, N, Benchmark::measure([&] {
+                        sweep.getAtmosphereStateByHeight(standard, h.data(),
+                                                         T.data(), P.data(),
+                                                         rho.data(), N);
+                        Benchmark::doNotOptimize(rho[N / 2].getValue());
+                      }));
+    Benchmark::report("profile to sink, " + threads, N,
+                      Benchmark::measure([&] {
+                        DiscardingSink sink;
+                        sweep.getAtmosphereProfile(standard, 0_m, 0.02_m, N,
+                                                   sink);
+                        Benchmark::doNotOptimize(sink.sum);
+                      }));
+  }
+}
@@ -0,0 +1,33 @@
+#include <cmath>
+#include <vector>
+
+#include "Benchmark.h"
+#include "SpaceToolkit/FastMath.h"
+
+namespace FastMath = SpaceToolkit::FastMath;
+namespace Simd = SpaceToolkit::Simd;
+
+namespace {
+constexpr size_t N = 1 << 12;
+
+// pow over independent arguments as in the layer equations, T_b / T to the
+// power of g M / (R L)
+template <typename F>
+void pow(const std::string& name, F f) {
+  std::vector<double> x(N), y(N), z(N);
+  for (size_t i = 0; i < N; ++i) {
+    x[i] = 0.7 + 0.6 * double(i) / N;
+    y[i] = -34.0 + 68.0 * double((i * 37) % N) / N;
+  }
+  Benchmark::report(name, N, Benchmark::measure([&] {
+                      for (size_t i = 0; i < N; ++i) z[i] = f(x[i], y[i]);
+                      Benchmark::doNotOptimize(z[N / 2]);
+                    }));
+}
+}  // namespace
+
+BENCHMARK(FastMathPow) {
+  pow("libm pow", [](double x, double y) { return std::pow(x, y); });
+  pow("FastMath::pow", [](double x, double y) { return FastMath::pow(x, y); });
+  pow("Simd::pow", [](double x, double y) { return Simd::pow(x, y); });
+}
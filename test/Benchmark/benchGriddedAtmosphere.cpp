@@ -0,0 +1,102 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Benchmark.h"
+#include "SpaceToolkit/GriddedAtmosphere.h"
+#include "SpaceToolkit/USStandardAtmosphere1976.h"
+
+using SpaceToolkit::AtmosphereState;
+using SpaceToolkit::GriddedAtmosphere;
+using SpaceToolkit::GriddedAtmosphereGrid;
+using SpaceToolkit::GriddedAtmosphereTable;
+using SpaceToolkit::USStandardAtmosphere1976;
+
+namespace {
+constexpr size_t N = 1 << 16;
+}  // namespace
+
+BENCHMARK(GriddedAtmosphereThroughput) {
+  // a 0.25 degree grid of 20 x 20 degrees, 64 levels and 8 times, 87 MB
+  USStandardAtmosphere1976 standard;
+  GriddedAtmosphereGrid grid;
+  grid.latitude = {40.0, 0.25, 81};
+  grid.longitude = {0.0, 0.25, 81};
+  grid.time = {0.0, 3600.0, 8};
+  for (int i = 0; i < 64; ++i) grid.heights.push_back(i * 1250_m);
+
+  const char* path = "benchGriddedAtmosphere.stk";
+  GriddedAtmosphereTable::write(
+      path, grid, [&](double latitude, double longitude, Length h, Time t) {
+        AtmosphereState s = standard.getAtmosphereStateByHeight(h);
+        double variation = 1.0 + 1e-3 * std::sin(latitude + longitude) +
+                           1e-4 * t.getValue() / 3600.0;
+        return AtmosphereState{s.T * variation, s.P * variation, s.rho};
+      });
+
+  auto start = std::chrono::steady_clock::now();
+  GriddedAtmosphereTable table(path);
+  std::chrono::duration<double> opening =
+      std::chrono::steady_clock::now() - start;
+  std::printf("opened %zu bytes in %.1f us\n", table.getMappedSize(),
+              opening.count() * 1e6);
+
+  std::mt19937 generator(18);
+  std::uniform_real_distribution<double> latitudes(40.0, 60.0);
+  std::uniform_real_distribution<double> longitudes(0.0, 20.0);
+  std::uniform_real_distribution<double> heights(0.0, 78750.0);
+  std::uniform_real_distribution<double> times(0.0, 25200.0);
+  std::vector<double> latitude(N), longitude(N);
+  std::vector<Length> h(N);
+  std::vector<Time> t(N);
+  for (size_t i = 0; i < N; ++i) {
+    latitude[i] = latitudes(generator);
+    longitude[i] = longitudes(generator);
+    h[i] = Length(heights(generator));
+    t[i] = Time(times(generator));
+  }
+  std::vector<Temperature> T(N);
+  std::vector<Pressure> P(N);
+  std::vector<Density> rho(N);
+
+  Benchmark::report("random point query", N, Benchmark::measure([&] {
+                      for (size_t i = 0; i < N; ++i)
+                        rho[i] = table
+                                     .getAtmosphereState(latitude[i],
+                                                         longitude[i], h[i],
+                                                         t[i])
+                                     .rho;
+                      Benchmark::doNotOptimize(rho[N / 2].getValue());
+                    }));
+  Benchmark::report("random point batch", N, Benchmark::measure([&] {
+                      table.getAtmosphereState(latitude.data(),
+                                               longitude.data(), h.data(),
+                                               t.data(), T.data(), P.data(),
+                                               rho.data(), N);
+                      Benchmark::doNotOptimize(rho[N / 2].getValue());
+                    }));
+
+  // a column, e.g. for an ascent from one site
+  GriddedAtmosphere atmosphere(table, 51.3, 7.9, Time(9000.0));
+  for (size_t i = 0; i < N; ++i) h[i] = 78750_m * (double(i) / (N - 1));
+  Benchmark::report("column state query", N, Benchmark::measure([&] {
+                      for (size_t i = 0; i < N; ++i)
+                        rho[i] =
+                            atmosphere.getAtmosphereStateByHeight(h[i]).rho;
+                      Benchmark::doNotOptimize(rho[N / 2].getValue());
+                    }));
+  Benchmark::report("column state batch", N, Benchmark::measure([&] {
+                      atmosphere.getAtmosphereStateByHeight(
+                          h.data(), T.data(), P.data(), rho.data(), N);
+                      Benchmark::doNotOptimize(rho[N / 2].getValue());
+                    }));
+  Benchmark::report("standard state batch", N, Benchmark::measure([&] {
+                      standard.getAtmosphereStateByHeight(
+                          h.data(), T.data(), P.data(), rho.data(), N);
+                      Benchmark::doNotOptimize(rho[N / 2].getValue());
+                    }));
+
+  std::remove(path);
+}
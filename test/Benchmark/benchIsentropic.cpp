@@ -0,0 +1,69 @@
+#include <cmath>
+#include <vector>
+
+#include "Benchmark.h"
+#include "SpaceToolkit/Isentropic.h"
+
+using SpaceToolkit::IsentropicTable;
+using SpaceToolkit::MachBranch;
+namespace Isentropic = SpaceToolkit::Isentropic;
+
+namespace {
+constexpr size_t N = 1 << 16;
+constexpr double MAXIMUM_AREA_RATIO = 400.0;
+
+// the textbook inversion: bisection of A / A* on the supersonic branch
+double bisectMach(double areaRatio, double k) {
+  double low = 1.0;
+  double high = 100.0;
+  while (high - low > 1e-15 * high) {
+    double M = 0.5 * (low + high);
+    double ratio = std::pow(2.0 / (k + 1.0) * (1.0 + 0.5 * (k - 1.0) * M * M),
+                            (k + 1.0) / (2.0 * (k - 1.0))) /
+                   M;
+    (ratio < areaRatio ? low : high) = M;
+  }
+  return 0.5 * (low + high);
+}
+}  // namespace
+
+BENCHMARK(IsentropicMachFromAreaRatio) {
+  Number kappa(1.22);
+  std::vector<Number> areaRatio(N);
+  for (size_t i = 0; i < N; ++i)
+    areaRatio[i] = Number(1.0 + (MAXIMUM_AREA_RATIO - 1.0) * i / N);
+
+  Benchmark::report("bisection", N, Benchmark::measure([&] {
+                      for (size_t i = 0; i < N; ++i)
+                        Benchmark::doNotOptimize(
+                            bisectMach(areaRatio[i].getValue(), 1.22));
+                    }));
+
+  Benchmark::report("Halley solver", N, Benchmark::measure([&] {
+                      for (size_t i = 0; i < N; ++i)
+                        Benchmark::doNotOptimize(
+                            Isentropic::machFromAreaRatio(
+                                areaRatio[i], kappa, MachBranch::SUPERSONIC)
+                                .getValue());
+                    }));
+
+  IsentropicTable table(kappa, Number(MAXIMUM_AREA_RATIO));
+  Benchmark::report("table build", 1, Benchmark::measure([&] {
+                      IsentropicTable built(kappa, Number(MAXIMUM_AREA_RATIO));
+                      Benchmark::doNotOptimize(built.getSegmentCount());
+                    }));
+
+  Benchmark::report("table", N, Benchmark::measure([&] {
+                      for (size_t i = 0; i < N; ++i)
+                        Benchmark::doNotOptimize(
+                            table.getMach(areaRatio[i], MachBranch::SUPERSONIC)
+                                .getValue());
+                    }));
+
+  std::vector<Number> mach(N);
+  Benchmark::report("batch table", N, Benchmark::measure([&] {
+                      table.getMach(areaRatio.data(), mach.data(), N,
+                                    MachBranch::SUPERSONIC);
+                      Benchmark::doNotOptimize(mach[N / 2].getValue());
+                    }));
+}
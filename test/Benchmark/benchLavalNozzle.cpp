@@ -0,0 +1,44 @@
+#include <vector>
+
+#include "Benchmark.h"
+#include "SpaceToolkit/LavalNozzle.h"
+
+using SpaceToolkit::LavalNozzle;
+
+namespace {
+constexpr size_t N = 1 << 16;
+}  // namespace
+
+BENCHMARK(LavalNozzleThroughput) {
+  std::vector<Force> F(N);
+  std::vector<Number> kappa(N);
+  std::vector<Pressure> p_c(N);
+  std::vector<Pressure> p_e(N);
+  for (size_t i = 0; i < N; ++i) {
+    double x = double(i) / N;
+    F[i] = Force(100.0 + 1.0e5 * x);
+    kappa[i] = Number(1.15 + 0.25 * x);
+    p_c[i] = Pressure(1.0e6 + 1.9e7 * x);
+    p_e[i] = Pressure(5.0e3 + 9.6e4 * (1.0 - x));
+  }
+
+  Benchmark::report("construct and read design", N, Benchmark::measure([&] {
+                      for (size_t i = 0; i < N; ++i) {
+                        LavalNozzle nozzle(F[i], kappa[i], p_c[i], p_e[i]);
+                        Benchmark::doNotOptimize(
+                            nozzle.throatDiameter().getValue() +
+                            nozzle.exitDiameter().getValue() +
+                            nozzle.throatCrossSectionalArea().getValue() +
+                            nozzle.exitCrossSectionalArea().getValue());
+                      }
+                    }));
+
+  std::vector<Area> A_t(N), A_e(N);
+  std::vector<Length> d_t(N), d_e(N);
+  Benchmark::report("batch design", N, Benchmark::measure([&] {
+                      LavalNozzle::design(F.data(), kappa.data(), p_c.data(),
+                                          p_e.data(), A_t.data(), A_e.data(),
+                                          d_t.data(), d_e.data(), N);
+                      Benchmark::doNotOptimize(d_e[N / 2].getValue());
+                    }));
+}
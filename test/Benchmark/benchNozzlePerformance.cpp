@@ -0,0 +1,65 @@
+#include <vector>
+
+#include "Benchmark.h"
+#include "SpaceToolkit/LavalNozzle.h"
+#include "SpaceToolkit/NozzlePerformance.h"
+
+using SpaceToolkit::LavalNozzle;
+using SpaceToolkit::NozzlePerformance;
+
+namespace {
+constexpr size_t N = 1 << 16;
+}  // namespace
+
+BENCHMARK(NozzlePerformanceThroughput) {
+  std::vector<Force> F(N);
+  std::vector<Number> kappa(N);
+  std::vector<Pressure> p_c(N), p_e(N), p_a(N);
+  std::vector<Temperature> T_c(N);
+  std::vector<MolarMass> M(N);
+  for (size_t i = 0; i < N; ++i) {
+    double x = double(i) / N;
+    F[i] = Force(100.0 + 1.0e5 * x);
+    kappa[i] = Number(1.15 + 0.25 * x);
+    p_c[i] = Pressure(1.0e6 + 1.9e7 * x);
+    p_e[i] = Pressure(5.0e3 + 9.6e4 * (1.0 - x));
+    p_a[i] = Pressure(101325.0 * (1.0 - x));
+    T_c[i] = Temperature(900.0 + 2700.0 * x);
+    M[i] = MolarMass(0.030 - 0.026 * x);
+  }
+
+  Benchmark::report("design and performance", N, Benchmark::measure([&] {
+                      for (size_t i = 0; i < N; ++i) {
+                        NozzlePerformance performance(
+                            LavalNozzle::design(F[i], kappa[i], p_c[i],
+                                                p_e[i]),
+                            T_c[i], M[i]);
+                        Benchmark::doNotOptimize(
+                            performance.massFlowRate().getValue() +
+                            performance.thrust(p_a[i]).getValue() +
+                            performance.specificImpulse(p_a[i]).getValue());
+                      }
+                    }));
+
+  NozzlePerformance performance(
+      LavalNozzle::design(F[0], kappa[0], p_c[0], p_e[0]), T_c[0], M[0]);
+  Benchmark::report("thrust of one design", N, Benchmark::measure([&] {
+                      for (size_t i = 0; i < N; ++i)
+                        Benchmark::doNotOptimize(
+                            performance.thrust(p_a[i]).getValue());
+                    }));
+
+  std::vector<Speed> cStar(N);
+  std::vector<MassFlowRate> mDot(N);
+  std::vector<Number> C_F(N);
+  std::vector<Force> thrust(N);
+  std::vector<Time> I_sp(N);
+  Benchmark::report("batch performance", N, Benchmark::measure([&] {
+                      NozzlePerformance::performance(
+                          F.data(), kappa.data(), p_c.data(), p_e.data(),
+                          T_c.data(), M.data(), p_a.data(), cStar.data(),
+                          mDot.data(), C_F.data(), thrust.data(),
+                          I_sp.data(), N);
+                      Benchmark::doNotOptimize(I_sp[N / 2].getValue());
+                    }));
+}
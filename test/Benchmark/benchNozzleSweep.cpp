@@ -0,0 +1,56 @@
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Benchmark.h"
+#include "SpaceToolkit/NozzleSweep.h"
+
+using SpaceToolkit::MinimumMassFlowReduction;
+using SpaceToolkit::NozzleSweep;
+using SpaceToolkit::NozzleSweepBlock;
+using SpaceToolkit::NozzleSweepGrid;
+using SpaceToolkit::NozzleSweepSink;
+using SpaceToolkit::ParetoFrontReduction;
+
+namespace {
+// a sink which only touches the results, e.g. in place of a file writer
+class DiscardingSink : public NozzleSweepSink {
+ public:
+  double sum = 0.0;
+
+  void consume(const NozzleSweepBlock& block) {
+    sum += block.exitDiameter[block.n - 1].getValue();
+  }
+};
+}  // namespace
+
+BENCHMARK(NozzleSweepThroughput) {
+  // 4.2M points
+  NozzleSweepGrid grid = {{100_N, 100_N, 50},
+                          {Number(1.12), Number(0.02), 12},
+                          {1000000_Pa, 500000_Pa, 20},
+                          {2000_Pa, 5000_Pa, 10},
+                          {2500_K, 100_K, 7},
+                          {MolarMass(0.012), MolarMass(0.002), 5}};
+  size_t n = grid.getPointCount();
+
+  std::vector<size_t> threadCounts = {1, 2, 4};
+  if (std::thread::hardware_concurrency() > 4)
+    threadCounts.push_back(std::thread::hardware_concurrency());
+  for (size_t threadCount : threadCounts) {
+    NozzleSweep sweep(threadCount);
+    std::string threads = std::to_string(threadCount) + " threads";
+    Benchmark::report("sweep to sink, " + threads, n, Benchmark::measure([&] {
+                        DiscardingSink sink;
+                        sweep.sweep(grid, &sink);
+                        Benchmark::doNotOptimize(sink.sum);
+                      }));
+    Benchmark::report("Pareto front and envelope, " + threads, n,
+                      Benchmark::measure([&] {
+                        ParetoFrontReduction pareto;
+                        MinimumMassFlowReduction envelope(2000_N, 0.5_m);
+                        sweep.sweep(grid, nullptr, {&pareto, &envelope});
+                        Benchmark::doNotOptimize(pareto.getFront().size());
+                      }));
+  }
+}
@@ -0,0 +1,60 @@
+#include <cstdio>
+#include <vector>
+
+#include "Benchmark.h"
+#include "SpaceToolkit/TabulatedAtmosphere.h"
+#include "SpaceToolkit/USStandardAtmosphere1976.h"
+
+using SpaceToolkit::AtmosphereLayer;
+using SpaceToolkit::TabulatedAtmosphere;
+using SpaceToolkit::USStandardAtmosphere1976;
+
+namespace {
+constexpr size_t N = 1 << 16;
+}  // namespace
+
+BENCHMARK(TabulatedAtmosphereThroughput) {
+  USStandardAtmosphere1976 analytic;
+  std::vector<Length> boundaries;
+  for (const AtmosphereLayer& layer : USStandardAtmosphere1976::layers())
+    boundaries.push_back(layer.baseHeight);
+
+  std::vector<Length> h(N);
+  for (size_t i = 0; i < N; ++i) h[i] = 85000_m * (double(i) / (N - 1));
+  std::vector<Temperature> T(N);
+  std::vector<Pressure> P(N);
+  std::vector<Density> rho(N);
+
+  Benchmark::report("analytic state query", N, Benchmark::measure([&] {
+                      for (size_t i = 0; i < N; ++i)
+                        rho[i] = analytic.getAtmosphereStateByHeight(h[i]).rho;
+                      Benchmark::doNotOptimize(rho[N / 2].getValue());
+                    }));
+  Benchmark::report("analytic state batch", N, Benchmark::measure([&] {
+                      analytic.getAtmosphereStateByHeight(
+                          h.data(), T.data(), P.data(), rho.data(), N);
+                      Benchmark::doNotOptimize(rho[N / 2].getValue());
+                    }));
+
+  for (double bound : {1e-6, 1e-9}) {
+    for (bool withBreakpoints : {true, false}) {
+      TabulatedAtmosphere table(analytic, 0_m, 85000_m, bound,
+                                withBreakpoints ? boundaries
+                                                : std::vector<Length>());
+      std::printf("table for %g%s: %zu segments, %zu bytes\n", bound,
+                  withBreakpoints ? " with breakpoints" : "",
+                  table.getSegmentCount(), table.getMemoryFootprint());
+
+      Benchmark::report("tabulated state query", N, Benchmark::measure([&] {
+                          for (size_t i = 0; i < N; ++i)
+                            rho[i] = table.getAtmosphereStateByHeight(h[i]).rho;
+                          Benchmark::doNotOptimize(rho[N / 2].getValue());
+                        }));
+      Benchmark::report("tabulated state batch", N, Benchmark::measure([&] {
+                          table.getAtmosphereStateByHeight(
+                              h.data(), T.data(), P.data(), rho.data(), N);
+                          Benchmark::doNotOptimize(rho[N / 2].getValue());
+                        }));
+    }
+  }
+}
@@ -0,0 +1,450 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "SpaceToolkit/SpaceToolkitException.h"
+#include "SpaceToolkit/USStandardAtmosphere1976.h"
+
+using SpaceToolkit::AtmosphereDerivatives;
+using SpaceToolkit::AtmosphereProperties;
+using SpaceToolkit::AtmosphereState;
+using SpaceToolkit::AtmosphereStatus;
+using SpaceToolkit::OutOfRangePolicy;
+using SpaceToolkit::SpaceToolkitException;
+using SpaceToolkit::USStandardAtmosphere1976;
+
+namespace {
+constexpr size_t N = 1 << 16;
+
+// heights spread evenly over 0 ... 85 km
+std::vector<Length> heights() {
+  std::vector<Length> h(N);
+  for (size_t i = 0; i < N; ++i) h[i] = 85000_m * (double(i) / (N - 1));
+  return h;
+}
+}  // namespace
+
+BENCHMARK(USStandardAtmosphere1976Batch) {
+  USStandardAtmosphere1976 atmosphere;
+  std::vector<Length> h = heights();
+  std::vector<Temperature> T(N);
+  std::vector<Pressure> P(N);
+  std::vector<Density> rho(N);
+
+  Benchmark::report("temperature scalar loop", N, Benchmark::measure([&] {
+                      for (size_t i = 0; i < N; ++i)
+                        T[i] =
+                            atmosphere.getAtmosphereTemperatureByHeight(h[i]);
+                      Benchmark::doNotOptimize(T[N / 2].getValue());
+                    }));
+  Benchmark::report("temperature batch", N, Benchmark::measure([&] {
+                      atmosphere.getAtmosphereTemperatureByHeight(h.data(),
+                                                                  T.data(), N);
+                      Benchmark::doNotOptimize(T[N / 2].getValue());
+                    }));
+  Benchmark::report("pressure scalar loop", N, Benchmark::measure([&] {
+                      for (size_t i = 0; i < N; ++i)
+                        P[i] = atmosphere.getAtmospherePressureByHeight(h[i]);
+                      Benchmark::doNotOptimize(P[N / 2].getValue());
+                    }));
+  Benchmark::report("pressure batch", N, Benchmark::measure([&] {
+                      atmosphere.getAtmospherePressureByHeight(h.data(),
+                                                               P.data(), N);
+                      Benchmark::doNotOptimize(P[N / 2].getValue());
+                    }));
+  Benchmark::report("density scalar loop", N, Benchmark::measure([&] {
+                      for (size_t i = 0; i < N; ++i)
+                        rho[i] = atmosphere.getAtmosphereDensityByHeight(h[i]);
+                      Benchmark::doNotOptimize(rho[N / 2].getValue());
+                    }));
+  Benchmark::report("density batch", N, Benchmark::measure([&] {
+                      atmosphere.getAtmosphereDensityByHeight(h.data(),
+                                                              rho.data(), N);
+                      Benchmark::doNotOptimize(rho[N / 2].getValue());
+                    }));
+}
+
+BENCHMARK(USStandardAtmosphere1976State) {
+  USStandardAtmosphere1976 atmosphere;
+  std::vector<Length> h = heights();
+  std::vector<Temperature> T(N);
+  std::vector<Pressure> P(N);
+  std::vector<Density> rho(N);
+
+  Benchmark::report("three single queries", N, Benchmark::measure([&] {
+                      for (size_t i = 0; i < N; ++i) {
+                        T[i] =
+                            atmosphere.getAtmosphereTemperatureByHeight(h[i]);
+                        P[i] = atmosphere.getAtmospherePressureByHeight(h[i]);
+                        rho[i] = atmosphere.getAtmosphereDensityByHeight(h[i]);
+                      }
+                      Benchmark::doNotOptimize(rho[N / 2].getValue());
+                    }));
+  Benchmark::report("state query", N, Benchmark::measure([&] {
+                      for (size_t i = 0; i < N; ++i) {
+                        AtmosphereState state =
+                            atmosphere.getAtmosphereStateByHeight(h[i]);
+                        rho[i] = state.rho;
+                      }
+                      Benchmark::doNotOptimize(rho[N / 2].getValue());
+                    }));
+  Benchmark::report("three batch queries", N, Benchmark::measure([&] {
+                      atmosphere.getAtmosphereTemperatureByHeight(h.data(),
+                                                                  T.data(), N);
+                      atmosphere.getAtmospherePressureByHeight(h.data(),
+                                                               P.data(), N);
+                      atmosphere.getAtmosphereDensityByHeight(h.data(),
+                                                              rho.data(), N);
+                      Benchmark::doNotOptimize(rho[N / 2].getValue());
+                    }));
+  Benchmark::report("state batch", N, Benchmark::measure([&] {
+                      atmosphere.getAtmosphereStateByHeight(
+                          h.data(), T.data(), P.data(), rho.data(), N);
+                      Benchmark::doNotOptimize(rho[N / 2].getValue());
+                    }));
+}
+
+// the cost of a single query should not depend on the layer
+BENCHMARK(USStandardAtmosphere1976PerLayer) {
+  USStandardAtmosphere1976 atmosphere;
+  const Length heights[] = {5000_m,   15000_m,  25000_m,  40000_m,
+                            49000_m,  60000_m,  80000_m,  88000_m,
+                            105000_m, 200000_m, 700000_m};
+
+  for (Length h : heights) {
+    std::string name =
+        "pressure at " + std::to_string(int(h.getValue() / 1000)) + " km";
+    Benchmark::report(name, N, Benchmark::measure([&] {
+                        double sum = 0.0;
+                        for (size_t i = 0; i < N; ++i)
+                          sum += atmosphere
+                                     .getAtmospherePressureByHeight(
+                                         h + double(i % 100) * 1_m)
+                                     .getValue();
+                        Benchmark::doNotOptimize(sum);
+                      }));
+  }
+}
+
+// integrator steps probing just above the top of the model
+BENCHMARK(USStandardAtmosphere1976OutOfRange) {
+  USStandardAtmosphere1976 atmosphere;
+  std::vector<Length> h(N);
+  for (size_t i = 0; i < N; ++i)
+    h[i] = atmosphere.getTopHeight() - 10_m + double(i % 20) * 1_m;
+  std::vector<Temperature> T(N);
+  std::vector<Pressure> P(N);
+  std::vector<Density> rho(N);
+  std::vector<uint64_t> outOfRange((N + 63) / 64);
+
+  Benchmark::report("throwing state query", N, Benchmark::measure([&] {
+                      double sum = 0.0;
+                      for (size_t i = 0; i < N; ++i) {
+                        try {
+                          sum += atmosphere.getAtmosphereStateByHeight(h[i])
+                                     .P.getValue();
+                        } catch (SpaceToolkitException&) {
+                          sum += 1.0;
+                        }
+                      }
+                      Benchmark::doNotOptimize(sum);
+                    }));
+  Benchmark::report("non-throwing state query", N, Benchmark::measure([&] {
+                      double sum = 0.0;
+                      AtmosphereState state;
+                      for (size_t i = 0; i < N; ++i) {
+                        if (atmosphere.tryGetAtmosphereStateByHeight(
+                                h[i], state) == AtmosphereStatus::Ok)
+                          sum += state.P.getValue();
+                        else
+                          sum += 1.0;
+                      }
+                      Benchmark::doNotOptimize(sum);
+                    }));
+  Benchmark::report("non-throwing state batch", N, Benchmark::measure([&] {
+                      atmosphere.tryGetAtmosphereStateByHeight(
+                          h.data(), T.data(), P.data(), rho.data(), N,
+                          outOfRange.data(), OutOfRangePolicy::NaN);
+                      Benchmark::doNotOptimize(P[N / 2].getValue());
+                    }));
+}
+
+// the state batch below and above the 85 km junction
+BENCHMARK(USStandardAtmosphere1976Thermosphere) {
+  USStandardAtmosphere1976 atmosphere;
+  std::vector<Length> lower = heights();
+  std::vector<Length> upper(N);
+  for (size_t i = 0; i < N; ++i)
+    upper[i] = 85000_m + (atmosphere.getTopHeight() - 85000_m) *
+                             (double(i) / (N - 1));
+  std::vector<Temperature> T(N);
+  std::vector<Pressure> P(N);
+  std::vector<Density> rho(N);
+
+  Benchmark::report("state query 0 ... 85 km", N, Benchmark::measure([&] {
+                      for (size_t i = 0; i < N; ++i)
+                        rho[i] = atmosphere.getAtmosphereStateByHeight(lower[i])
+                                     .rho;
+                      Benchmark::doNotOptimize(rho[N / 2].getValue());
+                    }));
+  Benchmark::report("state query 85 ... 1000 km", N, Benchmark::measure([&] {
+                      for (size_t i = 0; i < N; ++i)
+                        rho[i] = atmosphere.getAtmosphereStateByHeight(upper[i])
+                                     .rho;
+                      Benchmark::doNotOptimize(rho[N / 2].getValue());
+                    }));
+  Benchmark::report("state batch 0 ... 85 km", N, Benchmark::measure([&] {
+                      atmosphere.getAtmosphereStateByHeight(
+                          lower.data(), T.data(), P.data(), rho.data(), N);
+                      Benchmark::doNotOptimize(rho[N / 2].getValue());
+                    }));
+  Benchmark::report("state batch 85 ... 1000 km", N, Benchmark::measure([&] {
+                      atmosphere.getAtmosphereStateByHeight(
+                          upper.data(), T.data(), P.data(), rho.data(), N);
+                      Benchmark::doNotOptimize(rho[N / 2].getValue());
+                    }));
+}
+
+// geometric altitudes converted by the caller or by the altitude query
+BENCHMARK(USStandardAtmosphere1976Altitude) {
+  USStandardAtmosphere1976 atmosphere;
+  std::vector<Length> z(N);
+  for (size_t i = 0; i < N; ++i) z[i] = 1000000_m * (double(i) / (N - 1));
+  std::vector<Length> h(N);
+  std::vector<Temperature> T(N);
+  std::vector<Pressure> P(N);
+  std::vector<Density> rho(N);
+
+  Benchmark::report("conversion pass and height batch", N,
+                    Benchmark::measure([&] {
+                      for (size_t i = 0; i < N; ++i)
+                        h[i] = std::min(
+                            USStandardAtmosphere1976::toGeopotentialHeight(
+                                z[i]),
+                            atmosphere.getTopHeight());
+                      atmosphere.getAtmosphereStateByHeight(
+                          h.data(), T.data(), P.data(), rho.data(), N);
+                      Benchmark::doNotOptimize(rho[N / 2].getValue());
+                    }));
+  Benchmark::report("altitude batch", N, Benchmark::measure([&] {
+                      atmosphere.getAtmosphereStateByAltitude(
+                          z.data(), T.data(), P.data(), rho.data(), N);
+                      Benchmark::doNotOptimize(rho[N / 2].getValue());
+                    }));
+}
+
+// derived gas properties computed by the caller from the state or fused
+BENCHMARK(USStandardAtmosphere1976Properties) {
+  USStandardAtmosphere1976 atmosphere;
+  std::vector<Length> h = heights();
+  std::vector<Temperature> T(N);
+  std::vector<Pressure> P(N);
+  std::vector<Density> rho(N);
+  std::vector<AtmosphereProperties> properties(N);
+
+  Benchmark::report("state batch", N, Benchmark::measure([&] {
+                      atmosphere.getAtmosphereStateByHeight(
+                          h.data(), T.data(), P.data(), rho.data(), N);
+                      Benchmark::doNotOptimize(rho[N / 2].getValue());
+                    }));
+  Benchmark::report("state batch and separate pass", N, Benchmark::measure([&] {
+                      atmosphere.getAtmosphereStateByHeight(
+                          h.data(), T.data(), P.data(), rho.data(), N);
+                      for (size_t i = 0; i < N; ++i) {
+                        AtmosphereProperties& p = properties[i];
+                        p.a = Psqrt(1.4 * R * T[i] / 0.0289644_kgpmol);
+                        p.mu = DynamicViscosity(
+                            1.458e-6 * std::pow(T[i].getValue(), 1.5) /
+                            (T[i].getValue() + 110.4));
+                        p.nu = KinematicViscosity(p.mu.getValue() /
+                                                  rho[i].getValue());
+                        p.reynoldsPerMetre = p.a / p.nu;
+                        p.meanFreePath = Length(2.3e-25 * T[i].getValue() /
+                                                P[i].getValue());
+                      }
+                      Benchmark::doNotOptimize(properties[N / 2].a.getValue());
+                    }));
+  Benchmark::report("properties batch", N, Benchmark::measure([&] {
+                      atmosphere.getAtmospherePropertiesByHeight(
+                          h.data(), properties.data(), N);
+                      Benchmark::doNotOptimize(properties[N / 2].a.getValue());
+                    }));
+  Benchmark::report("properties query", N, Benchmark::measure([&] {
+                      double sum = 0.0;
+                      for (size_t i = 0; i < N; ++i)
+                        sum += atmosphere.getAtmospherePropertiesByHeight(h[i])
+                                   .reynoldsPerMetre.getValue();
+                      Benchmark::doNotOptimize(sum);
+                    }));
+}
+
+// pressure altitude by bisection on the pressure query against the inverse
+BENCHMARK(USStandardAtmosphere1976Inverse) {
+  USStandardAtmosphere1976 atmosphere;
+  std::vector<Length> h_ref = heights();
+  std::vector<Pressure> P(N);
+  std::vector<Length> h(N);
+  atmosphere.getAtmospherePressureByHeight(h_ref.data(), P.data(), N);
+
+  Benchmark::report("bisection", N, Benchmark::measure([&] {
+                      double sum = 0.0;
+                      for (size_t i = 0; i < N; ++i) {
+                        Length low = 0_m, high = 85000_m;
+                        for (int j = 0; j < 40; ++j) {
+                          Length mid = 0.5 * (low + high);
+                          if (atmosphere.getAtmospherePressureByHeight(mid) >
+                              P[i])
+                            low = mid;
+                          else
+                            high = mid;
+                        }
+                        sum += low.getValue();
+                      }
+                      Benchmark::doNotOptimize(sum);
+                    }));
+  Benchmark::report("inverse query", N, Benchmark::measure([&] {
+                      double sum = 0.0;
+                      for (size_t i = 0; i < N; ++i)
+                        sum += atmosphere.getHeightByPressure(P[i]).getValue();
+                      Benchmark::doNotOptimize(sum);
+                    }));
+  Benchmark::report("inverse batch", N, Benchmark::measure([&] {
+                      atmosphere.getHeightByPressure(P.data(), h.data(), N);
+                      Benchmark::doNotOptimize(h[N / 2].getValue());
+                    }));
+}
+
+// float against double batch, then the largest relative errors of the float
+// query in each layer and thermosphere region, boundaries included
+BENCHMARK(USStandardAtmosphere1976SinglePrecision) {
+  USStandardAtmosphere1976 atmosphere;
+  std::vector<Length> h = heights();
+  std::vector<Temperature> T(N);
+  std::vector<Pressure> P(N);
+  std::vector<Density> rho(N);
+  std::vector<float> h_f(N), T_f(N), P_f(N), rho_f(N);
+  for (size_t i = 0; i < N; ++i) h_f[i] = static_cast<float>(h[i].getValue());
+
+  Benchmark::report("double batch", N, Benchmark::measure([&] {
+                      atmosphere.getAtmosphereStateByHeight(
+                          h.data(), T.data(), P.data(), rho.data(), N);
+                      Benchmark::doNotOptimize(rho[N / 2].getValue());
+                    }));
+  Benchmark::report("float batch", N, Benchmark::measure([&] {
+                      atmosphere.getAtmosphereStateByHeight(
+                          h_f.data(), T_f.data(), P_f.data(), rho_f.data(), N);
+                      Benchmark::doNotOptimize(rho_f[N / 2]);
+                    }));
+
+  std::vector<double> boundaries;
+  for (const auto& layer : USStandardAtmosphere1976::layers())
+    boundaries.push_back(layer.baseHeight.getValue());
+  for (double z : {86000.0, 91000.0, 110000.0, 120000.0, 1000000.0}) {
+    boundaries.push_back(
+        USStandardAtmosphere1976::toGeopotentialHeight(Length(z)).getValue());
+  }
+  boundaries[7] = 85000.0;  // the junction of layers and thermosphere
+
+  std::printf("%-24s %12s %12s %12s\n", "relative error of float",
+              "T", "P", "rho");
+  const int samples = 1000;
+  for (size_t k = 0; k + 1 < boundaries.size(); ++k) {
+    std::vector<float> h_k;
+    for (int i = 0; i <= samples; ++i) {
+      h_k.push_back(static_cast<float>(
+          boundaries[k] + (boundaries[k + 1] - boundaries[k]) * i / samples));
+    }
+    h_k.back() = std::min(
+        h_k.back(), static_cast<float>(atmosphere.getTopHeight().getValue()));
+    atmosphere.getAtmosphereStateByHeight(h_k.data(), T_f.data(), P_f.data(),
+                                          rho_f.data(), h_k.size());
+
+    double errorT = 0.0, errorP = 0.0, errorRho = 0.0;
+    for (size_t i = 0; i < h_k.size(); ++i) {
+      AtmosphereState ref = atmosphere.getAtmosphereStateByHeight(
+          std::min(Length(h_k[i]), atmosphere.getTopHeight()));
+      errorT = std::max(errorT, std::fabs(T_f[i] / ref.T.getValue() - 1.0));
+      errorP = std::max(errorP, std::fabs(P_f[i] / ref.P.getValue() - 1.0));
+      errorRho =
+          std::max(errorRho, std::fabs(rho_f[i] / ref.rho.getValue() - 1.0));
+    }
+    std::string name = std::to_string(int(boundaries[k] / 1000)) + " ... " +
+                       std::to_string(int(boundaries[k + 1] / 1000)) + " km";
+    std::printf("%-24s %12.2e %12.2e %12.2e\n", name.c_str(), errorT, errorP,
+                errorRho);
+  }
+}
+
+// state and derivatives by height as an implicit integrator needs them, from
+// the analytic query and from central differences
+BENCHMARK(USStandardAtmosphere1976Derivatives) {
+  USStandardAtmosphere1976 atmosphere;
+  const Length h_top = atmosphere.getTopHeight() - 1_m;
+  std::vector<Length> h(N);
+  for (size_t i = 0; i < N; ++i) h[i] = h_top * (double(i) / (N - 1));
+
+  Benchmark::report("central differences", N, Benchmark::measure([&] {
+                      const Length dh = 0.5_m;
+                      double sum = 0.0;
+                      for (size_t i = 0; i < N; ++i) {
+                        Length h_i = std::max(h[i], dh);
+                        AtmosphereState state =
+                            atmosphere.getAtmosphereStateByHeight(h_i);
+                        AtmosphereState below =
+                            atmosphere.getAtmosphereStateByHeight(h_i - dh);
+                        AtmosphereState above =
+                            atmosphere.getAtmosphereStateByHeight(h_i + dh);
+                        sum += state.P.getValue() +
+                               (above.P - below.P).getValue() +
+                               (above.rho - below.rho).getValue();
+                      }
+                      Benchmark::doNotOptimize(sum);
+                    }));
+  Benchmark::report("analytic derivatives", N, Benchmark::measure([&] {
+                      double sum = 0.0;
+                      for (size_t i = 0; i < N; ++i) {
+                        AtmosphereDerivatives d;
+                        AtmosphereState state =
+                            atmosphere.getAtmosphereStateByHeight(h[i], d);
+                        sum += state.P.getValue() + d.dP.getValue() +
+                               d.drho.getValue();
+                      }
+                      Benchmark::doNotOptimize(sum);
+                    }));
+}
+
+// a dense profile on a 1 m grid up to 85 km, from the recurrences and from
+// independent evaluations
+BENCHMARK(USStandardAtmosphere1976Profile) {
+  USStandardAtmosphere1976 atmosphere;
+  const size_t n = 85001;
+  std::vector<Length> h(n);
+  for (size_t i = 0; i < n; ++i) h[i] = Length(double(i));
+  std::vector<Temperature> T(n);
+  std::vector<Pressure> P(n);
+  std::vector<Density> rho(n);
+
+  Benchmark::report("scalar loop", n, Benchmark::measure([&] {
+                      for (size_t i = 0; i < n; ++i) {
+                        AtmosphereState state =
+                            atmosphere.getAtmosphereStateByHeight(h[i]);
+                        T[i] = state.T;
+                        P[i] = state.P;
+                        rho[i] = state.rho;
+                      }
+                      Benchmark::doNotOptimize(P[n / 2].getValue());
+                    }));
+  Benchmark::report("batch", n, Benchmark::measure([&] {
+                      atmosphere.getAtmosphereStateByHeight(
+                          h.data(), T.data(), P.data(), rho.data(), n);
+                      Benchmark::doNotOptimize(P[n / 2].getValue());
+                    }));
+  Benchmark::report("profile", n, Benchmark::measure([&] {
+                      atmosphere.getAtmosphereProfile(
+                          0_m, 1_m, T.data(), P.data(), rho.data(), n);
+                      Benchmark::doNotOptimize(P[n / 2].getValue());
+                    }));
+}
@@ -0,0 +1,42 @@
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Benchmark.h"
+
+namespace {
+std::vector<std::pair<std::string, std::function<void()>>>& registry() {
+  static std::vector<std::pair<std::string, std::function<void()>>> r;
+  return r;
+}
+
+volatile double sink = 0.0;
+}  // namespace
+
+Benchmark::Registration::Registration(const std::string& name,
+                                      std::function<void()> function) {
+  registry().emplace_back(name, function);
+}
+
+void Benchmark::report(const std::string& name, size_t elements,
+                       double seconds) {
+  std::printf("%-56s %10.2f ns/element %10.2f Melements/s\n", name.c_str(),
+              1e9 * seconds / elements, 1e-6 * elements / seconds);
+}
+
+void Benchmark::doNotOptimize(double value) { sink = sink + value; }
+
+const void* Benchmark::opaque(const void* p) { return p; }
+
+// runs all benchmarks, or only those whose name contains argv[1]
+int main(int argc, char* argv[]) {
+  std::string filter = argc > 1 ? argv[1] : "";
+
+  for (auto& benchmark : registry()) {
+    if (benchmark.first.find(filter) == std::string::npos) continue;
+    std::printf("%s\n", benchmark.first.c_str());
+    benchmark.second();
+  }
+  return 0;
+}
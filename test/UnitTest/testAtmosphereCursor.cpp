@@ -0,0 +1,95 @@
+#include "SpaceToolkit/AtmosphereCursor.h"
+#include "SpaceToolkit/SpaceToolkitException.h"
+#include "SpaceToolkit/USStandardAtmosphere1976.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using SpaceToolkit::AtmosphereCursor;
+using SpaceToolkit::AtmosphereState;
+using SpaceToolkit::SpaceToolkitException;
+using SpaceToolkit::USStandardAtmosphere1976;
+
+TEST(AtmosphereCursorTest, TestAscentAndDescentMatchStatelessQueries) {
+  USStandardAtmosphere1976 atmosphere;
+
+  // SUT
+  auto cursor = std::make_unique<AtmosphereCursor>(atmosphere);
+
+  // ascent to the top, then descent to the ground, crossing every boundary
+  for (int i = 0; i <= 2 * 8500; ++i) {
+    Length h = (i <= 8500 ? i : 2 * 8500 - i) * 10_m;
+    AtmosphereState state = cursor->moveTo(h);
+    AtmosphereState expected = atmosphere.getAtmosphereStateByHeight(h);
+
+    ASSERT_EQ(expected.T.getValue(), state.T.getValue());
+    ASSERT_EQ(expected.P.getValue(), state.P.getValue());
+    ASSERT_EQ(expected.rho.getValue(), state.rho.getValue());
+  }
+  ASSERT_EQ(0u, cursor->getLayer());
+
+  // jumps over several layers
+  cursor->moveTo(80000_m);
+  ASSERT_EQ(6u, cursor->getLayer());
+  cursor->moveTo(15000_m);
+  ASSERT_EQ(1u, cursor->getLayer());
+}
+
+TEST(AtmosphereCursorTest, TestLayerAtBoundaries) {
+  USStandardAtmosphere1976 atmosphere;
+
+  // SUT
+  auto cursor = std::make_unique<AtmosphereCursor>(atmosphere);
+
+  // a boundary belongs to the layer below
+  cursor->moveTo(11000_m);
+  ASSERT_EQ(0u, cursor->getLayer());
+  cursor->moveTo(11000.001_m);
+  ASSERT_EQ(1u, cursor->getLayer());
+  cursor->moveTo(11000_m);
+  ASSERT_EQ(0u, cursor->getLayer());
+  cursor->moveTo(85000_m);
+  ASSERT_EQ(6u, cursor->getLayer());
+}
+
+TEST(AtmosphereCursorTest, TestInputHeightOutOfRange) {
+  USStandardAtmosphere1976 atmosphere;
+
+  // SUT
+  auto cursor = std::make_unique<AtmosphereCursor>(atmosphere);
+
+  cursor->moveTo(30000_m);
+  ASSERT_THROW(cursor->moveTo(-1 * 0.1_m), SpaceToolkitException);
+  ASSERT_THROW(cursor->moveTo(atmosphere.getTopHeight() + 0.1_m),
+               SpaceToolkitException);
+
+  // a failed move keeps the cursor in place
+  ASSERT_EQ(2u, cursor->getLayer());
+}
+
+TEST(AtmosphereCursorTest, TestThermosphere) {
+  USStandardAtmosphere1976 atmosphere;
+
+  // SUT
+  auto cursor = std::make_unique<AtmosphereCursor>(atmosphere);
+
+  // ascent through the thermosphere regions up to the top and back
+  Length h_top = atmosphere.getTopHeight();
+  for (int i = 0; i <= 2000; ++i) {
+    Length h = h_top * ((i <= 1000 ? i : 2000 - i) / 1000.0);
+    AtmosphereState state = cursor->moveTo(h);
+    AtmosphereState expected = atmosphere.getAtmosphereStateByHeight(h);
+
+    ASSERT_EQ(expected.T.getValue(), state.T.getValue());
+    ASSERT_EQ(expected.P.getValue(), state.P.getValue());
+    ASSERT_EQ(expected.rho.getValue(), state.rho.getValue());
+  }
+  ASSERT_EQ(0u, cursor->getLayer());
+
+  // the thermosphere regions follow the 7 lower layers
+  cursor->moveTo(85000.1_m);
+  ASSERT_EQ(7u, cursor->getLayer());
+  cursor->moveTo(h_top);
+  ASSERT_EQ(10u, cursor->getLayer());
+  cursor->moveTo(80000_m);
+  ASSERT_EQ(6u, cursor->getLayer());
+}
@@ -0,0 +1,237 @@
+#include "SpaceToolkit/AtmosphereDispersion.h"
+#include "SpaceToolkit/SpaceToolkitException.h"
+#include "SpaceToolkit/USStandardAtmosphere1976.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using SpaceToolkit::AtmosphereDispersion;
+using SpaceToolkit::AtmosphereState;
+using SpaceToolkit::DispersedAtmosphere;
+using SpaceToolkit::DispersionParameters;
+using SpaceToolkit::SpaceToolkitException;
+using SpaceToolkit::USStandardAtmosphere1976;
+
+namespace {
+DispersionParameters testParameters() {
+  return {Temperature(5.0), 0.05, 0.02, 5000_m, 500_m};
+}
+}  // namespace
+
+TEST(AtmosphereDispersionTest, TestReproducible) {
+  USStandardAtmosphere1976 usStandardAtmosphere1976;
+
+  // SUT
+  AtmosphereDispersion dispersion(usStandardAtmosphere1976, 0_m, 80000_m,
+                                  testParameters(), 42, 100);
+
+  ASSERT_EQ(100u, dispersion.getSampleCount());
+  ASSERT_EQ(161u, dispersion.getKnotCount());
+
+  // a sample does not depend on the sample count, but on the seed
+  AtmosphereDispersion more(usStandardAtmosphere1976, 0_m, 80000_m,
+                            testParameters(), 42, 1000);
+  AtmosphereDispersion other(usStandardAtmosphere1976, 0_m, 80000_m,
+                             testParameters(), 43, 100);
+  for (size_t s : {0u, 17u, 99u}) {
+    DispersedAtmosphere a = dispersion.getSample(s);
+    DispersedAtmosphere b = more.getSample(s);
+    DispersedAtmosphere c = other.getSample(s);
+    ASSERT_EQ(a.getTemperatureOffset().getValue(),
+              b.getTemperatureOffset().getValue());
+    ASSERT_NE(a.getTemperatureOffset().getValue(),
+              c.getTemperatureOffset().getValue());
+    for (int i = 0; i <= 80; ++i) {
+      Length h = i * 1000_m;
+      ASSERT_EQ(a.getLogDensityPerturbation(h),
+                b.getLogDensityPerturbation(h));
+    }
+  }
+
+  ASSERT_THROW(dispersion.getSample(100), SpaceToolkitException);
+}
+
+TEST(AtmosphereDispersionTest, TestStatistics) {
+  USStandardAtmosphere1976 usStandardAtmosphere1976;
+  DispersionParameters parameters = testParameters();
+  parameters.densityScaleSigma = 0.0;
+
+  // SUT
+  AtmosphereDispersion dispersion(usStandardAtmosphere1976, 0_m, 80000_m,
+                                  parameters, 1, 20000);
+
+  // standard deviations of the temperature offset and of the noise at the
+  // knots, and the correlation of the noise one correlation length apart
+  double sumT2 = 0.0, sumN2 = 0.0, sumProduct = 0.0;
+  const Length h = 30000_m;
+  for (size_t s = 0; s < dispersion.getSampleCount(); ++s) {
+    DispersedAtmosphere sample = dispersion.getSample(s);
+    double dT = sample.getTemperatureOffset().getValue();
+    double n0 = sample.getLogDensityPerturbation(h);
+    double n1 = sample.getLogDensityPerturbation(h + 5000_m);
+    sumT2 += dT * dT;
+    sumN2 += n0 * n0;
+    sumProduct += n0 * n1;
+  }
+  double count = dispersion.getSampleCount();
+
+  ASSERT_NEAR(5.0, std::sqrt(sumT2 / count), 0.1);
+  ASSERT_NEAR(0.02, std::sqrt(sumN2 / count), 0.0004);
+  ASSERT_NEAR(std::exp(-1.0), sumProduct / sumN2, 0.03);
+}
+
+TEST(AtmosphereDispersionTest, TestPerturbation) {
+  USStandardAtmosphere1976 usStandardAtmosphere1976;
+  AtmosphereDispersion dispersion(usStandardAtmosphere1976, 0_m, 80000_m,
+                                  testParameters(), 42, 10);
+
+  // SUT
+  DispersedAtmosphere sample = dispersion.getSample(3);
+  const SpaceToolkit::Atmosphere& virtualSample = sample;
+
+  for (int i = 0; i <= 800; ++i) {
+    Length h = i * 100_m;
+    AtmosphereState base =
+        usStandardAtmosphere1976.getAtmosphereStateByHeight(h);
+    AtmosphereState state = sample.getAtmosphereStateByHeight(h);
+
+    ASSERT_NEAR((base.T + sample.getTemperatureOffset()).getValue(),
+                state.T.getValue(), 1e-12 * base.T.getValue());
+    double factor = std::exp(sample.getLogDensityPerturbation(h));
+    ASSERT_NEAR(base.rho.getValue() * factor, state.rho.getValue(),
+                1e-14 * state.rho.getValue());
+    // the gas law still holds
+    ASSERT_NEAR((base.P / (base.rho * base.T)).getValue(),
+                (state.P / (state.rho * state.T)).getValue(),
+                1e-14 * (base.P / (base.rho * base.T)).getValue());
+
+    ASSERT_NEAR(state.T.getValue(),
+                virtualSample.getAtmosphereTemperatureByHeight(h).getValue(),
+                1e-14 * state.T.getValue());
+    ASSERT_NEAR(state.P.getValue(),
+                virtualSample.getAtmospherePressureByHeight(h).getValue(),
+                1e-14 * state.P.getValue());
+    ASSERT_NEAR(state.rho.getValue(),
+                virtualSample.getAtmosphereDensityByHeight(h).getValue(),
+                1e-14 * state.rho.getValue());
+  }
+
+  ASSERT_THROW(sample.getAtmosphereStateByHeight(80001_m),
+               SpaceToolkitException);
+}
+
+TEST(AtmosphereDispersionTest, TestBatchBySample) {
+  USStandardAtmosphere1976 usStandardAtmosphere1976;
+  AtmosphereDispersion dispersion(usStandardAtmosphere1976, 0_m, 80000_m,
+                                  testParameters(), 42, 50);
+
+  std::vector<Length> h;
+  for (int i = 0; i <= 1600; ++i) h.push_back(i * 50_m);
+  const size_t n = h.size();
+  const size_t first = 10, count = 20;
+  std::vector<Temperature> T(n * count);
+  std::vector<Pressure> P(n * count);
+  std::vector<Density> rho(n * count);
+
+  // SUT
+  dispersion.getAtmosphereStateBySample(h.data(), n, first, count, T.data(),
+                                        P.data(), rho.data());
+
+  std::vector<Temperature> T_sample(n);
+  std::vector<Pressure> P_sample(n);
+  std::vector<Density> rho_sample(n);
+  for (size_t s = 0; s < count; ++s) {
+    DispersedAtmosphere sample = dispersion.getSample(first + s);
+    sample.getAtmosphereStateByHeight(h.data(), T_sample.data(),
+                                      P_sample.data(), rho_sample.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+      AtmosphereState expected = sample.getAtmosphereStateByHeight(h[i]);
+      ASSERT_EQ(T_sample[i].getValue(), T[s * n + i].getValue());
+      ASSERT_EQ(P_sample[i].getValue(), P[s * n + i].getValue());
+      ASSERT_EQ(rho_sample[i].getValue(), rho[s * n + i].getValue());
+      ASSERT_NEAR(expected.T.getValue(), T[s * n + i].getValue(),
+                  1e-14 * expected.T.getValue());
+      ASSERT_NEAR(expected.P.getValue(), P[s * n + i].getValue(),
+                  1e-14 * expected.P.getValue());
+      ASSERT_NEAR(expected.rho.getValue(), rho[s * n + i].getValue(),
+                  1e-14 * expected.rho.getValue());
+    }
+  }
+
+  ASSERT_THROW(dispersion.getAtmosphereStateBySample(h.data(), n, 40, 11,
+                                                     T.data(), P.data(),
+                                                     rho.data()),
+               SpaceToolkitException);
+  h[5] = 80001_m;
+  ASSERT_THROW(dispersion.getAtmosphereStateBySample(h.data(), n, 0, 1,
+                                                     T.data(), P.data(),
+                                                     rho.data()),
+               SpaceToolkitException);
+}
+
+TEST(AtmosphereDispersionTest, TestParameterRange) {
+  USStandardAtmosphere1976 usStandardAtmosphere1976;
+  Length bottom = usStandardAtmosphere1976.getBottomHeight();
+  Length top = usStandardAtmosphere1976.getTopHeight();
+
+  // SUT
+  AtmosphereDispersion full(usStandardAtmosphere1976, bottom, top,
+                            testParameters(), 42, 1);
+  ASSERT_EQ(top.getValue(), full.getTopHeight().getValue());
+
+  // the range must lie within the range of the base
+  ASSERT_THROW(AtmosphereDispersion(usStandardAtmosphere1976, bottom - 1_m,
+                                    80000_m, testParameters(), 42, 1),
+               SpaceToolkitException);
+  ASSERT_THROW(AtmosphereDispersion(usStandardAtmosphere1976, 0_m, top + 1_m,
+                                    testParameters(), 42, 1),
+               SpaceToolkitException);
+  ASSERT_THROW(AtmosphereDispersion(usStandardAtmosphere1976, 80000_m,
+                                    80000_m, testParameters(), 42, 1),
+               SpaceToolkitException);
+
+  // a NaN height is out of range
+  Length h = Length(NAN);
+  Temperature T;
+  Pressure P;
+  Density rho;
+  ASSERT_THROW(full.getAtmosphereStateBySample(&h, 1, 0, 1, &T, &P, &rho),
+               SpaceToolkitException);
+}
+
+TEST(AtmosphereDispersionTest, TestLargeTemperatureOffset) {
+  USStandardAtmosphere1976 usStandardAtmosphere1976;
+  DispersionParameters parameters = testParameters();
+  parameters.temperatureSigma = Temperature(300.0);
+
+  // SUT
+  AtmosphereDispersion dispersion(usStandardAtmosphere1976, 0_m, 100000_m,
+                                  parameters, 42, 100);
+
+  // offsets below -T / 10 occur, the state stays positive and keeps the gas
+  // law
+  bool floored = false;
+  for (size_t s = 0; s < dispersion.getSampleCount(); ++s) {
+    DispersedAtmosphere sample = dispersion.getSample(s);
+    double dT = sample.getTemperatureOffset().getValue();
+    for (int i = 0; i <= 100; ++i) {
+      Length h = i * 1000_m;
+      AtmosphereState base =
+          usStandardAtmosphere1976.getAtmosphereStateByHeight(h);
+      AtmosphereState state = sample.getAtmosphereStateByHeight(h);
+      double T = base.T.getValue();
+      floored = floored || T + dT < 0.1 * T;
+      ASSERT_DOUBLE_EQ(std::max(T + dT, 0.1 * T), state.T.getValue());
+      ASSERT_GT(state.P.getValue(), 0.0);
+      ASSERT_NEAR((base.P / (base.rho * base.T)).getValue(),
+                  (state.P / (state.rho * state.T)).getValue(),
+                  1e-14 * (base.P / (base.rho * base.T)).getValue());
+      ASSERT_EQ(state.T.getValue(),
+                sample.getAtmosphereTemperatureByHeight(h).getValue());
+    }
+  }
+  ASSERT_TRUE(floored);
+}
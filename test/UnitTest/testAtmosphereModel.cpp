@@ -0,0 +1,69 @@
+#include <thread>
+#include <vector>
+
+#include "SpaceToolkit/USStandardAtmosphere1976.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using SpaceToolkit::Atmosphere;
+using SpaceToolkit::AtmosphereProperties;
+using SpaceToolkit::AtmosphereState;
+using SpaceToolkit::USStandardAtmosphere1976;
+
+namespace {
+// sum of the pressures at 1 km steps, written once for any atmosphere type
+template <typename A>
+double pressureSum(const A& atmosphere) {
+  double sum = 0.0;
+  for (int i = 0; i <= 85; ++i)
+    sum += atmosphere.getAtmosphereStateByHeight(i * 1000_m).P.getValue();
+  return sum;
+}
+}  // namespace
+
+TEST(AtmosphereModelTest, TestStaticAndVirtualDispatchAgree) {
+  // SUT
+  const USStandardAtmosphere1976 atmosphere;
+  const Atmosphere& erased = atmosphere;
+
+  ASSERT_EQ(pressureSum(erased), pressureSum(atmosphere));
+  const Atmosphere& erasedLower = atmosphere.getLowerAtmosphere();
+  ASSERT_EQ(pressureSum(erasedLower),
+            pressureSum(atmosphere.getLowerAtmosphere()));
+
+  for (Length h : {0_m, 11000_m, 50000_m, 200000_m}) {
+    AtmosphereProperties expected = erased.getAtmospherePropertiesByHeight(h);
+    AtmosphereProperties properties =
+        atmosphere.getAtmospherePropertiesByHeight(h);
+    ASSERT_EQ(expected.a.getValue(), properties.a.getValue());
+    ASSERT_EQ(expected.mu.getValue(), properties.mu.getValue());
+    ASSERT_EQ(expected.meanFreePath.getValue(),
+              properties.meanFreePath.getValue());
+  }
+}
+
+TEST(AtmosphereModelTest, TestSharedBetweenThreads) {
+  // SUT
+  const USStandardAtmosphere1976 atmosphere;
+
+  std::vector<Length> h;
+  for (int i = 0; i <= 10000; ++i)
+    h.push_back(atmosphere.getTopHeight() * (i / 10000.0));
+  std::vector<Pressure> expected(h.size());
+  atmosphere.getAtmospherePressureByHeight(h.data(), expected.data(), h.size());
+
+  // every thread evaluates all heights with the same instance
+  std::vector<std::vector<Pressure>> P(4, std::vector<Pressure>(h.size()));
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < P.size(); ++t)
+    threads.emplace_back([&, t] {
+      for (size_t i = 0; i < h.size(); ++i)
+        P[t][i] = atmosphere.getAtmosphereStateByHeight(h[i]).P;
+    });
+  for (std::thread& thread : threads) thread.join();
+
+  for (size_t t = 0; t < P.size(); ++t)
+    for (size_t i = 0; i < h.size(); ++i)
+      ASSERT_NEAR(expected[i].getValue(), P[t][i].getValue(),
+                  1e-12 * expected[i].getValue());
+}
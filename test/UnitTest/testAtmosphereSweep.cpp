@@ -0,0 +1,137 @@
+#include "SpaceToolkit/AtmosphereSweep.h"
+#include "SpaceToolkit/SpaceToolkitException.h"
+#include "SpaceToolkit/USStandardAtmosphere1976.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using SpaceToolkit::AtmosphereSweep;
+using SpaceToolkit::AtmosphereSweepSink;
+using SpaceToolkit::SpaceToolkitException;
+using SpaceToolkit::USStandardAtmosphere1976;
+
+namespace {
+// a sweep of several chunks and a partial one
+const size_t N = 3 * AtmosphereSweep::CHUNK + 123;
+
+// copies the chunks and checks that they arrive in order
+class RecordingSink : public AtmosphereSweepSink {
+ public:
+  std::vector<Length> h;
+  std::vector<Temperature> T;
+  std::vector<Pressure> P;
+  std::vector<Density> rho;
+  bool ordered = true;
+  size_t throwAt = N;
+
+  void consume(size_t first, const Length* h_chunk,
+               const Temperature* T_chunk, const Pressure* P_chunk,
+               const Density* rho_chunk, size_t n) {
+    if (first >= throwAt)
+      throw SpaceToolkitException("errUnknown", __FILE__, __LINE__);
+    ordered = ordered && first == h.size();
+    h.insert(h.end(), h_chunk, h_chunk + n);
+    T.insert(T.end(), T_chunk, T_chunk + n);
+    P.insert(P.end(), P_chunk, P_chunk + n);
+    rho.insert(rho.end(), rho_chunk, rho_chunk + n);
+  }
+};
+}  // namespace
+
+TEST(AtmosphereSweepTest, TestMatchesBatch) {
+  USStandardAtmosphere1976 usStandardAtmosphere1976;
+
+  std::vector<Length> h(N);
+  for (size_t i = 0; i < N; ++i) h[i] = 86000_m * (double(i) / (N - 1));
+  std::vector<Temperature> T_ref(N), T(N);
+  std::vector<Pressure> P_ref(N), P(N);
+  std::vector<Density> rho_ref(N), rho(N);
+  usStandardAtmosphere1976.getAtmosphereStateByHeight(
+      h.data(), T_ref.data(), P_ref.data(), rho_ref.data(), N);
+
+  for (size_t threadCount : {1u, 3u, 4u}) {
+    // SUT
+    AtmosphereSweep sweep(threadCount);
+    ASSERT_EQ(threadCount, sweep.getThreadCount());
+
+    // the pool is reused by the second sweep
+    for (int run = 0; run < 2; ++run) {
+      sweep.getAtmosphereStateByHeight(usStandardAtmosphere1976, h.data(),
+                                       T.data(), P.data(), rho.data(), N);
+      for (size_t i = 0; i < N; ++i) {
+        ASSERT_EQ(T_ref[i].getValue(), T[i].getValue());
+        ASSERT_EQ(P_ref[i].getValue(), P[i].getValue());
+        ASSERT_EQ(rho_ref[i].getValue(), rho[i].getValue());
+      }
+    }
+  }
+}
+
+TEST(AtmosphereSweepTest, TestProfile) {
+  USStandardAtmosphere1976 usStandardAtmosphere1976;
+  const Length bottom = 100_m;
+  const Length step = 2.5_m;
+
+  std::vector<Length> h(N);
+  for (size_t i = 0; i < N; ++i) h[i] = bottom + double(i) * step;
+  std::vector<Temperature> T_ref(N), T(N);
+  std::vector<Pressure> P_ref(N), P(N);
+  std::vector<Density> rho_ref(N), rho(N);
+  usStandardAtmosphere1976.getAtmosphereStateByHeight(
+      h.data(), T_ref.data(), P_ref.data(), rho_ref.data(), N);
+
+  // SUT
+  AtmosphereSweep sweep(4);
+
+  sweep.getAtmosphereProfile(usStandardAtmosphere1976, bottom, step, T.data(),
+                             P.data(), rho.data(), N);
+  RecordingSink sink;
+  sweep.getAtmosphereProfile(usStandardAtmosphere1976, bottom, step, N, sink);
+
+  ASSERT_TRUE(sink.ordered);
+  ASSERT_EQ(N, sink.h.size());
+  for (size_t i = 0; i < N; ++i) {
+    ASSERT_EQ(T_ref[i].getValue(), T[i].getValue());
+    ASSERT_EQ(P_ref[i].getValue(), P[i].getValue());
+    ASSERT_EQ(rho_ref[i].getValue(), rho[i].getValue());
+    ASSERT_EQ(h[i].getValue(), sink.h[i].getValue());
+    ASSERT_EQ(T_ref[i].getValue(), sink.T[i].getValue());
+    ASSERT_EQ(P_ref[i].getValue(), sink.P[i].getValue());
+    ASSERT_EQ(rho_ref[i].getValue(), sink.rho[i].getValue());
+  }
+}
+
+TEST(AtmosphereSweepTest, TestException) {
+  USStandardAtmosphere1976 usStandardAtmosphere1976;
+  AtmosphereSweep sweep(4);
+
+  // a height out of range in the third chunk
+  std::vector<Length> h(N, 1000_m);
+  h[2 * AtmosphereSweep::CHUNK + 5] = 2000000_m;
+  std::vector<Temperature> T(N);
+  std::vector<Pressure> P(N);
+  std::vector<Density> rho(N);
+  ASSERT_THROW(sweep.getAtmosphereStateByHeight(usStandardAtmosphere1976,
+                                                h.data(), T.data(), P.data(),
+                                                rho.data(), N),
+               SpaceToolkitException);
+
+  // a profile beyond the top, and a sink which fails
+  RecordingSink sink;
+  ASSERT_THROW(sweep.getAtmosphereProfile(usStandardAtmosphere1976, 0_m,
+                                          100_m, N, sink),
+               SpaceToolkitException);
+  RecordingSink failing;
+  failing.throwAt = AtmosphereSweep::CHUNK;
+  ASSERT_THROW(sweep.getAtmosphereProfile(usStandardAtmosphere1976, 0_m,
+                                          1_m, N, failing),
+               SpaceToolkitException);
+  ASSERT_EQ(AtmosphereSweep::CHUNK, failing.h.size());
+
+  // the pool still works
+  h[2 * AtmosphereSweep::CHUNK + 5] = 1000_m;
+  sweep.getAtmosphereStateByHeight(usStandardAtmosphere1976, h.data(),
+                                   T.data(), P.data(), rho.data(), N);
+  ASSERT_EQ(T[0].getValue(), T[N - 1].getValue());
+}
@@ -0,0 +1,75 @@
+#include <cmath>
+
+#include "SpaceToolkit/ConstexprLayeredAtmosphere.h"
+#include "SpaceToolkit/ConstexprMath.h"
+#include "SpaceToolkit/USStandardAtmosphere1976.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using SpaceToolkit::AtmosphereState;
+using SpaceToolkit::LayeredAtmosphere;
+using SpaceToolkit::SpaceToolkitException;
+using SpaceToolkit::USStandardAtmosphere1976;
+namespace ConstexprMath = SpaceToolkit::ConstexprMath;
+
+namespace {
+// evaluated by the compiler, a wrong table would not build
+constexpr AtmosphereState TROPOPAUSE =
+    USStandardAtmosphere1976::constexprLowerAtmosphere()
+        .getAtmosphereStateByHeight(11000_m);
+
+static_assert(TROPOPAUSE.T > 216.64_K && TROPOPAUSE.T < 216.66_K,
+              "tropopause temperature");
+static_assert(TROPOPAUSE.P > 22632_Pa && TROPOPAUSE.P < 22633_Pa,
+              "tropopause pressure");
+static_assert(ConstexprMath::exp(0.0) == 1.0, "exp(0)");
+static_assert(ConstexprMath::log(1.0) == 0.0, "log(1)");
+}  // namespace
+
+TEST(ConstexprAtmosphereTest, TestMath) {
+  for (double x = -700.0; x <= 700.0; x += 0.37) {
+    ASSERT_NEAR(ConstexprMath::exp(x), std::exp(x), 1e-15 * std::exp(x));
+  }
+  for (double x = 1e-300; x < 1e300; x *= 3.7) {
+    ASSERT_NEAR(ConstexprMath::log(x), std::log(x),
+                1e-15 * std::abs(std::log(x)) + 1e-16);
+  }
+  for (double b = 0.1; b < 10.0; b += 0.13) {
+    for (double e = -30.0; e < 30.0; e += 1.7) {
+      ASSERT_NEAR(ConstexprMath::pow(b, e), std::pow(b, e),
+                  1e-14 * std::pow(b, e));
+    }
+  }
+}
+
+TEST(ConstexprAtmosphereTest, TestMatchesLayeredAtmosphere) {
+  // SUT
+  constexpr auto atmosphere =
+      USStandardAtmosphere1976::constexprLowerAtmosphere();
+  USStandardAtmosphere1976 usStandardAtmosphere1976;
+  const LayeredAtmosphere& lower =
+      usStandardAtmosphere1976.getLowerAtmosphere();
+
+  for (int i = 0; i <= 8500; ++i) {
+    Length h = i * 10_m;
+    AtmosphereState expected = lower.getAtmosphereStateByHeight(h);
+    AtmosphereState actual = atmosphere.getAtmosphereStateByHeight(h);
+    ASSERT_NEAR(actual.T.getValue(), expected.T.getValue(),
+                1e-13 * expected.T.getValue());
+    ASSERT_NEAR(actual.P.getValue(), expected.P.getValue(),
+                1e-13 * expected.P.getValue());
+    ASSERT_NEAR(actual.rho.getValue(), expected.rho.getValue(),
+                1e-13 * expected.rho.getValue());
+  }
+}
+
+TEST(ConstexprAtmosphereTest, TestOutOfRange) {
+  // SUT
+  constexpr auto atmosphere =
+      USStandardAtmosphere1976::constexprLowerAtmosphere();
+
+  ASSERT_THROW(atmosphere.getAtmosphereStateByHeight(-1 * 1_m),
+               SpaceToolkitException);
+  ASSERT_THROW(atmosphere.getAtmosphereStateByHeight(85001_m),
+               SpaceToolkitException);
+}
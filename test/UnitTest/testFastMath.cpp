@@ -0,0 +1,43 @@
+#include <cmath>
+
+#include "SpaceToolkit/FastMath.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace FastMath = SpaceToolkit::FastMath;
+
+// the documented error bounds, against long double references
+TEST(FastMathTest, TestExp) {
+  for (double x = -708.0; x <= 709.0; x += 0.00137) {
+    long double ref = std::exp(static_cast<long double>(x));
+    ASSERT_LE(std::fabs((FastMath::exp(x) - ref) / ref), 2.5e-16)
+        << "x = " << x;
+  }
+}
+
+TEST(FastMathTest, TestLog) {
+  for (double x = 1e-300; x < 1e300; x *= 1.00137) {
+    long double ref = std::log(static_cast<long double>(x));
+    ASSERT_LE(std::fabs(FastMath::log(x) - ref), 4e-16 * std::fabs(ref))
+        << "x = " << x;
+  }
+  for (double x = 0.5; x <= 2.0; x += 1e-6) {
+    if (x == 1.0) continue;
+    long double ref = std::log(static_cast<long double>(x));
+    ASSERT_LE(std::fabs(FastMath::log(x) - ref), 4e-16 * std::fabs(ref))
+        << "x = " << x;
+  }
+  EXPECT_EQ(0.0, FastMath::log(1.0));
+}
+
+TEST(FastMathTest, TestPow) {
+  for (double x = 1e-3; x < 1e3; x *= 1.0137) {
+    for (double y = -40.0; y <= 40.0; y += 0.173) {
+      long double ref =
+          std::pow(static_cast<long double>(x), static_cast<long double>(y));
+      double bound = 4e-16 * (1.0 + std::fabs(y * std::log(x)));
+      ASSERT_LE(std::fabs((FastMath::pow(x, y) - ref) / ref), bound)
+          << "x = " << x << ", y = " << y;
+    }
+  }
+}
@@ -0,0 +1,251 @@
+#include "SpaceToolkit/GriddedAtmosphere.h"
+#include "SpaceToolkit/SpaceToolkitException.h"
+#include "SpaceToolkit/USStandardAtmosphere1976.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using SpaceToolkit::AtmosphereState;
+using SpaceToolkit::GridAxis;
+using SpaceToolkit::GriddedAtmosphere;
+using SpaceToolkit::GriddedAtmosphereGrid;
+using SpaceToolkit::GriddedAtmosphereTable;
+using SpaceToolkit::SpaceToolkitException;
+using SpaceToolkit::USStandardAtmosphere1976;
+
+namespace {
+// T linear and P, rho exponential in every coordinate, which the
+// interpolation reproduces up to rounding
+AtmosphereState linearState(double latitude, double longitude, Length h,
+                            Time t) {
+  double z = h.getValue();
+  double s = t.getValue();
+  double T = 280.0 - 0.5 * latitude + 0.1 * longitude - 0.0065 * z + 1e-4 * s;
+  double lnP =
+      11.5 + 1e-3 * latitude - 2e-3 * longitude - z / 8000.0 + 1e-6 * s;
+  double lnRho = 0.2 - 2e-3 * latitude + 1e-3 * longitude - z / 9000.0;
+  return {Temperature(T), Pressure(std::exp(lnP)), Density(std::exp(lnRho))};
+}
+
+// latitude and longitude counts which are not multiples of the block size,
+// uneven levels and three times
+GriddedAtmosphereGrid testGrid() {
+  GriddedAtmosphereGrid grid;
+  grid.latitude = {30.0, 2.5, 9};
+  grid.longitude = {-10.0, 2.0, 11};
+  grid.time = {0.0, 3600.0, 3};
+  for (double z : {0.0, 250.0, 600.0, 1000.0, 1500.0, 2500.0, 4000.0, 6000.0,
+                   8000.0, 10000.0, 12000.0, 16000.0, 20000.0})
+    grid.heights.push_back(Length(z));
+  return grid;
+}
+
+std::string tablePath(const std::string& name) {
+  return testing::TempDir() + name;
+}
+
+void expectState(const AtmosphereState& expected, const AtmosphereState& state,
+                 double bound) {
+  ASSERT_NEAR(expected.T.getValue(), state.T.getValue(),
+              bound * expected.T.getValue());
+  ASSERT_NEAR(expected.P.getValue(), state.P.getValue(),
+              bound * expected.P.getValue());
+  ASSERT_NEAR(expected.rho.getValue(), state.rho.getValue(),
+              bound * expected.rho.getValue());
+}
+}  // namespace
+
+TEST(GriddedAtmosphereTest, TestInterpolation) {
+  std::string path = tablePath("griddedInterpolation.stk");
+  GriddedAtmosphereTable::write(path, testGrid(), linearState);
+
+  // SUT
+  GriddedAtmosphereTable table(path);
+
+  ASSERT_EQ(9u, table.getLatitudeAxis().count);
+  ASSERT_EQ(11u, table.getLongitudeAxis().count);
+  ASSERT_EQ(3u, table.getTimeAxis().count);
+  ASSERT_EQ(13u, table.getHeightCount());
+  ASSERT_EQ(0.0, table.getBottomHeight().getValue());
+  ASSERT_EQ(20000.0, table.getTopHeight().getValue());
+
+  std::mt19937 generator(18);
+  std::uniform_real_distribution<double> latitudes(30.0, 50.0);
+  std::uniform_real_distribution<double> longitudes(-10.0, 10.0);
+  std::uniform_real_distribution<double> heights(0.0, 20000.0);
+  std::uniform_real_distribution<double> times(0.0, 7200.0);
+
+  const size_t N = 2000;
+  std::vector<double> latitude(N), longitude(N);
+  std::vector<Length> h(N);
+  std::vector<Time> t(N);
+  for (size_t i = 0; i < N; ++i) {
+    latitude[i] = latitudes(generator);
+    longitude[i] = longitudes(generator);
+    h[i] = Length(heights(generator));
+    t[i] = Time(times(generator));
+  }
+  // the corners of the grid
+  latitude[0] = 30.0, longitude[0] = -10.0, h[0] = 0_m, t[0] = Time(0.0);
+  latitude[1] = 50.0, longitude[1] = 10.0, h[1] = 20000_m, t[1] = Time(7200.0);
+
+  std::vector<Temperature> T(N);
+  std::vector<Pressure> P(N);
+  std::vector<Density> rho(N);
+  table.getAtmosphereState(latitude.data(), longitude.data(), h.data(),
+                           t.data(), T.data(), P.data(), rho.data(), N);
+
+  for (size_t i = 0; i < N; ++i) {
+    AtmosphereState expected =
+        linearState(latitude[i], longitude[i], h[i], t[i]);
+    expectState(expected,
+                table.getAtmosphereState(latitude[i], longitude[i], h[i], t[i]),
+                1e-12);
+    expectState(expected, {T[i], P[i], rho[i]}, 1e-12);
+  }
+}
+
+TEST(GriddedAtmosphereTest, TestColumn) {
+  std::string path = tablePath("griddedColumn.stk");
+  GriddedAtmosphereTable::write(path, testGrid(), linearState);
+  GriddedAtmosphereTable table(path);
+
+  // SUT
+  GriddedAtmosphere atmosphere(table, 41.3, -3.7, Time(5000.0));
+  const SpaceToolkit::Atmosphere& virtualAtmosphere = atmosphere;
+
+  std::vector<Length> h;
+  for (int i = 0; i <= 2000; ++i) h.push_back(i * 10_m);
+  std::vector<Temperature> T(h.size());
+  std::vector<Pressure> P(h.size());
+  std::vector<Density> rho(h.size());
+  atmosphere.getAtmosphereStateByHeight(h.data(), T.data(), P.data(),
+                                        rho.data(), h.size());
+
+  for (size_t i = 0; i < h.size(); ++i) {
+    AtmosphereState expected = linearState(41.3, -3.7, h[i], Time(5000.0));
+    expectState(expected, atmosphere.getAtmosphereStateByHeight(h[i]), 1e-12);
+    expectState(expected, {T[i], P[i], rho[i]}, 1e-12);
+    expectState(expected,
+                {virtualAtmosphere.getAtmosphereTemperatureByHeight(h[i]),
+                 virtualAtmosphere.getAtmospherePressureByHeight(h[i]),
+                 virtualAtmosphere.getAtmosphereDensityByHeight(h[i])},
+                1e-12);
+  }
+
+  std::vector<Pressure> P_only(h.size());
+  atmosphere.getAtmospherePressureByHeight(h.data(), P_only.data(), h.size());
+  for (size_t i = 0; i < h.size(); ++i)
+    ASSERT_EQ(P[i].getValue(), P_only[i].getValue());
+}
+
+TEST(GriddedAtmosphereTest, TestStandardAtmosphere) {
+  // a site independent table of the standard atmosphere on levels every
+  // 500 m with a single time
+  USStandardAtmosphere1976 usStandardAtmosphere1976;
+  GriddedAtmosphereGrid grid;
+  grid.latitude = {-90.0, 45.0, 5};
+  grid.longitude = {-180.0, 90.0, 5};
+  grid.time = {0.0, 1.0, 1};
+  for (int i = 0; i <= 100; ++i) grid.heights.push_back(i * 500_m);
+
+  std::string path = tablePath("griddedStandard.stk");
+  GriddedAtmosphereTable::write(
+      path, grid, [&](double, double, Length h, Time) {
+        return usStandardAtmosphere1976.getAtmosphereStateByHeight(h);
+      });
+  GriddedAtmosphereTable table(path);
+
+  // SUT, the time axis is constant
+  GriddedAtmosphere atmosphere(table, 12.0, 34.0, Time(1e9));
+
+  // exact at the levels, between them pressure and density follow the
+  // exponential of the local scale height
+  for (int i = 0; i <= 50000; i += 50) {
+    Length h = i * 1_m;
+    double bound = i % 500 == 0 ? 1e-13 : 2e-3;
+    expectState(usStandardAtmosphere1976.getAtmosphereStateByHeight(h),
+                atmosphere.getAtmosphereStateByHeight(h), bound);
+  }
+}
+
+TEST(GriddedAtmosphereTest, TestOutOfRange) {
+  std::string path = tablePath("griddedOutOfRange.stk");
+  GriddedAtmosphereTable::write(path, testGrid(), linearState);
+  GriddedAtmosphereTable table(path);
+
+  ASSERT_THROW(table.getAtmosphereState(29.9, 0.0, 0_m, Time(0.0)),
+               SpaceToolkitException);
+  ASSERT_THROW(table.getAtmosphereState(40.0, 10.1, 0_m, Time(0.0)),
+               SpaceToolkitException);
+  ASSERT_THROW(table.getAtmosphereState(40.0, 0.0, Length(-1.0), Time(0.0)),
+               SpaceToolkitException);
+  ASSERT_THROW(table.getAtmosphereState(40.0, 0.0, 0_m, Time(7201.0)),
+               SpaceToolkitException);
+  ASSERT_THROW(table.getAtmosphereState(NAN, 0.0, 0_m, Time(0.0)),
+               SpaceToolkitException);
+  ASSERT_THROW(GriddedAtmosphere(table, 40.0, 0.0, Time(-1.0)),
+               SpaceToolkitException);
+
+  GriddedAtmosphere atmosphere(table, 40.0, 0.0, Time(0.0));
+  ASSERT_THROW(atmosphere.getAtmosphereStateByHeight(20001_m),
+               SpaceToolkitException);
+  Length h[] = {0_m, 20001_m};
+  Temperature T[2];
+  ASSERT_THROW(atmosphere.getAtmosphereTemperatureByHeight(h, T, 2),
+               SpaceToolkitException);
+}
+
+TEST(GriddedAtmosphereTest, TestFileFormat) {
+  ASSERT_THROW(GriddedAtmosphereTable(tablePath("griddedMissing.stk")),
+               SpaceToolkitException);
+
+  std::string path = tablePath("griddedFormat.stk");
+  GriddedAtmosphereTable::write(path, testGrid(), linearState);
+  std::vector<char> bytes;
+  {
+    std::ifstream file(path, std::ios::binary);
+    bytes.assign(std::istreambuf_iterator<char>(file),
+                 std::istreambuf_iterator<char>());
+  }
+  auto expectRejected = [&](const std::vector<char>& modified) {
+    std::string modifiedPath = tablePath("griddedModified.stk");
+    {
+      std::ofstream file(modifiedPath, std::ios::binary | std::ios::trunc);
+      file.write(modified.data(), modified.size());
+    }
+    ASSERT_THROW(GriddedAtmosphereTable table(modifiedPath),
+                 SpaceToolkitException);
+  };
+
+  // magic, version, truncated nodes, descending levels
+  std::vector<char> modified = bytes;
+  modified[0] = 'X';
+  expectRejected(modified);
+  modified = bytes;
+  modified[8] = 2;
+  expectRejected(modified);
+  modified.assign(bytes.begin(), bytes.end() - 8);
+  expectRejected(modified);
+  modified = bytes;
+  double level = 1e6;
+  std::memcpy(modified.data() + 128, &level, sizeof(level));
+  expectRejected(modified);
+  expectRejected({});
+
+  // invalid grids are not written
+  GriddedAtmosphereGrid grid = testGrid();
+  grid.heights.resize(1);
+  ASSERT_THROW(GriddedAtmosphereTable::write(path, grid, linearState),
+               SpaceToolkitException);
+  grid = testGrid();
+  grid.latitude.step = 0.0;
+  ASSERT_THROW(GriddedAtmosphereTable::write(path, grid, linearState),
+               SpaceToolkitException);
+}
@@ -0,0 +1,123 @@
+#include "SpaceToolkit/Isentropic.h"
+#include "SpaceToolkit/SpaceToolkitException.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+using SpaceToolkit::IsentropicTable;
+using SpaceToolkit::MachBranch;
+using SpaceToolkit::SpaceToolkitException;
+namespace Isentropic = SpaceToolkit::Isentropic;
+
+// values of the isentropic flow tables for kappa = 1.4, e.g. NACA report 1135
+TEST(IsentropicTest, TestRatios) {
+  Number kappa = 1.4;
+
+  // SUT
+  ASSERT_NEAR(0.55556,
+              Isentropic::temperatureRatio(Number(2.0), kappa).getValue(),
+              0.000005);
+  ASSERT_NEAR(0.12780,
+              Isentropic::pressureRatio(Number(2.0), kappa).getValue(),
+              0.000005);
+  ASSERT_NEAR(0.23005,
+              Isentropic::densityRatio(Number(2.0), kappa).getValue(),
+              0.000005);
+  ASSERT_NEAR(1.68750, Isentropic::areaRatio(Number(2.0), kappa).getValue(),
+              0.000005);
+  ASSERT_NEAR(0.84302,
+              Isentropic::pressureRatio(Number(0.5), kappa).getValue(),
+              0.000005);
+  ASSERT_NEAR(1.33984, Isentropic::areaRatio(Number(0.5), kappa).getValue(),
+              0.000005);
+  ASSERT_DOUBLE_EQ(1.0, Isentropic::areaRatio(Number(1.0), kappa).getValue());
+
+  for (double M = 0.0; M < 10.0; M += 0.37)
+    ASSERT_NEAR(M,
+                Isentropic::machFromPressureRatio(
+                    Isentropic::pressureRatio(Number(M), kappa), kappa)
+                    .getValue(),
+                1e-12 * (1.0 + M));
+
+  ASSERT_THROW(Isentropic::areaRatio(Number(0.0), kappa),
+               SpaceToolkitException);
+  ASSERT_THROW(Isentropic::pressureRatio(Number(2.0), Number(1.0)),
+               SpaceToolkitException);
+  ASSERT_THROW(Isentropic::machFromPressureRatio(Number(1.5), kappa),
+               SpaceToolkitException);
+}
+
+TEST(IsentropicTest, TestMachFromAreaRatio) {
+  for (double kappa = 1.05; kappa < 1.7; kappa += 0.07) {
+    Number k(kappa);
+    for (double M = 0.001; M < 30.0; M *= 1.07) {
+      MachBranch branch =
+          M < 1.0 ? MachBranch::SUBSONIC : MachBranch::SUPERSONIC;
+
+      // SUT
+      Number areaRatio = Isentropic::areaRatio(Number(M), k);
+      double mach =
+          Isentropic::machFromAreaRatio(areaRatio, k, branch).getValue();
+
+      // the rounding of the area ratio is amplified near Mach 1
+      double condition = std::fabs(
+          (1.0 + 0.5 * (kappa - 1.0) * M * M) / (M * M - 1.0));
+      ASSERT_NEAR(M, mach, 1e-14 * M * (1.0 + condition));
+    }
+
+    ASSERT_EQ(1.0, Isentropic::machFromAreaRatio(Number(1.0), k,
+                                                 MachBranch::SUBSONIC)
+                       .getValue());
+    ASSERT_EQ(1.0, Isentropic::machFromAreaRatio(Number(1.0), k,
+                                                 MachBranch::SUPERSONIC)
+                       .getValue());
+  }
+
+  ASSERT_THROW(Isentropic::machFromAreaRatio(Number(0.99), Number(1.4),
+                                             MachBranch::SUPERSONIC),
+               SpaceToolkitException);
+}
+
+TEST(IsentropicTest, TestTable) {
+  const double maximum = 2000.0;
+  // a partial chunk after a full one
+  const size_t n = 1500;
+
+  for (double kappa : {1.13, 1.4, 1.67}) {
+    // SUT
+    IsentropicTable table{Number(kappa), Number(maximum)};
+
+    std::vector<Number> areaRatio(n);
+    for (size_t i = 0; i < n; ++i)
+      areaRatio[i] = Number(
+          std::fmin(maximum, std::exp(std::log(maximum) *
+                                      std::pow(i / (n - 1.0), 2))));
+    // both ends of the table exactly
+    areaRatio[n - 1] = Number(maximum);
+
+    for (MachBranch branch : {MachBranch::SUBSONIC, MachBranch::SUPERSONIC}) {
+      std::vector<Number> mach(n);
+      table.getMach(areaRatio.data(), mach.data(), n, branch);
+      for (size_t i = 0; i < n; ++i) {
+        double reference =
+            Isentropic::machFromAreaRatio(areaRatio[i], Number(kappa), branch)
+                .getValue();
+        ASSERT_NEAR(reference, mach[i].getValue(), 2e-12 * reference);
+        ASSERT_NEAR(reference, table.getMach(areaRatio[i], branch).getValue(),
+                    2e-12 * reference);
+      }
+    }
+
+    Number outOfRange[2] = {Number(2.0), Number(maximum * 1.01)};
+    Number mach[2];
+    ASSERT_THROW(table.getMach(outOfRange, mach, 2, MachBranch::SUPERSONIC),
+                 SpaceToolkitException);
+    ASSERT_THROW(table.getMach(Number(0.5), MachBranch::SUBSONIC),
+                 SpaceToolkitException);
+  }
+
+  ASSERT_THROW(IsentropicTable(Number(1.4), Number(1.0)),
+               SpaceToolkitException);
+}
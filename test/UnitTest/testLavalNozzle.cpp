@@ -1,3 +1,6 @@
+#include <cmath>
+#include <vector>
+
 #include "SpaceToolkit/LavalNozzle.h"
 #include "SpaceToolkit/SpaceToolkitException.h"
 #include "gmock/gmock.h"
@@ -39,3 +42,88 @@ TEST(LavalNozzleTest, TestExitCalculation) {
   ASSERT_NEAR(Length(0.030237_m).getValue(),
               lavalNozzle->exitDiameter().getValue(), 0.000005);
 }
+
+TEST(LavalNozzleTest, TestDesign) {
+  Force F = 500_N;
+  Number kappa = 1.21;
+  Pressure p_c = 1500000_Pa;
+  Pressure p_e = 101325_Pa;
+
+  // SUT
+  LavalNozzle lavalNozzle(F, kappa, p_c, p_e);
+  LavalNozzle copy = lavalNozzle;
+  const SpaceToolkit::NozzleDesign& design = copy.getDesign();
+
+  // the closed forms with a pow call per term
+  double k = kappa.getValue();
+  double ratio = p_e.getValue() / p_c.getValue();
+  double gamma = std::sqrt(k * std::pow(2 / (k + 1), (k + 1) / (k - 1)));
+  double velocity =
+      std::sqrt(2 * k / (k - 1) * (1 - std::pow(ratio, (k - 1) / k)));
+  double A_t = F.getValue() / (p_c.getValue() * gamma * velocity);
+  double A_e = A_t * gamma * std::pow(ratio, -1 / k) / velocity;
+
+  ASSERT_NEAR(gamma, design.GAMMA.getValue(), 1e-15);
+  ASSERT_NEAR(ratio, design.pressureRatio.getValue(), 1e-15);
+  ASSERT_NEAR(gamma * velocity, design.thrustCoefficient.getValue(), 1e-14);
+  ASSERT_NEAR(A_e / A_t, copy.expansionRatio().getValue(), 1e-13);
+  ASSERT_NEAR(1.0, copy.throatCrossSectionalArea().getValue() / A_t, 1e-14);
+  ASSERT_NEAR(1.0, copy.exitCrossSectionalArea().getValue() / A_e, 1e-14);
+  ASSERT_EQ(lavalNozzle.exitDiameter().getValue(),
+            design.exitDiameter.getValue());
+  ASSERT_EQ(F.getValue(), design.desiredThrust.getValue());
+}
+
+TEST(LavalNozzleTest, TestBatchDesign) {
+  // a partial chunk after full ones
+  const size_t n = 2500;
+  std::vector<Force> F(n);
+  std::vector<Number> kappa(n);
+  std::vector<Pressure> p_c(n);
+  std::vector<Pressure> p_e(n);
+  for (size_t i = 0; i < n; ++i) {
+    double x = double(i) / (n - 1);
+    F[i] = Force(10.0 + 1.0e6 * x);
+    kappa[i] = Number(1.1 + 0.57 * x);
+    p_c[i] = Pressure(2.0e5 + 3.0e7 * x);
+    p_e[i] = Pressure(1.0e3 + 1.0e5 * (1.0 - x));
+  }
+  std::vector<Area> A_t(n), A_e(n);
+  std::vector<Length> d_t(n), d_e(n);
+
+  // SUT
+  LavalNozzle::design(F.data(), kappa.data(), p_c.data(), p_e.data(),
+                      A_t.data(), A_e.data(), d_t.data(), d_e.data(), n);
+
+  for (size_t i = 0; i < n; ++i) {
+    LavalNozzle lavalNozzle(F[i], kappa[i], p_c[i], p_e[i]);
+    ASSERT_NEAR(1.0, A_t[i].getValue() /
+                         lavalNozzle.throatCrossSectionalArea().getValue(),
+                1e-13);
+    ASSERT_NEAR(1.0, A_e[i].getValue() /
+                         lavalNozzle.exitCrossSectionalArea().getValue(),
+                1e-13);
+    ASSERT_NEAR(1.0,
+                d_t[i].getValue() / lavalNozzle.throatDiameter().getValue(),
+                1e-13);
+    ASSERT_NEAR(1.0,
+                d_e[i].getValue() / lavalNozzle.exitDiameter().getValue(),
+                1e-13);
+  }
+
+  // p_e >= p_c has no design, in the scalar and the batch design
+  p_e[0] = p_c[0];
+  p_e[1] = p_c[1] * 2.0;
+  LavalNozzle::design(F.data(), kappa.data(), p_c.data(), p_e.data(),
+                      A_t.data(), A_e.data(), d_t.data(), d_e.data(), 2);
+  for (size_t i = 0; i < 2; ++i) {
+    LavalNozzle lavalNozzle(F[i], kappa[i], p_c[i], p_e[i]);
+    ASSERT_TRUE(std::isnan(lavalNozzle.throatCrossSectionalArea().getValue()));
+    ASSERT_TRUE(std::isnan(lavalNozzle.exitDiameter().getValue()));
+    ASSERT_TRUE(std::isnan(lavalNozzle.expansionRatio().getValue()));
+    ASSERT_TRUE(std::isnan(A_t[i].getValue()));
+    ASSERT_TRUE(std::isnan(A_e[i].getValue()));
+    ASSERT_TRUE(std::isnan(d_t[i].getValue()));
+    ASSERT_TRUE(std::isnan(d_e[i].getValue()));
+  }
+}
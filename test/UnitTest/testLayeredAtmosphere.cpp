@@ -0,0 +1,170 @@
+#include "SpaceToolkit/LayeredAtmosphere.h"
+#include "SpaceToolkit/SpaceToolkitException.h"
+#include "SpaceToolkit/USStandardAtmosphere1976.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using SpaceToolkit::AtmosphereLayer;
+using SpaceToolkit::LayeredAtmosphere;
+using SpaceToolkit::SpaceToolkitException;
+using SpaceToolkit::USStandardAtmosphere1976;
+
+TEST(LayeredAtmosphereTest, TestIsothermalLayer) {
+  // SUT
+  Temperature T = 250_K;
+  MolarMass M = 0.0289644_kgpmol;
+  auto layeredAtmosphere = std::make_unique<LayeredAtmosphere>(
+      std::vector<AtmosphereLayer>{{0_m, 0_Kpm}}, 30000_m, T, 100000_Pa, M,
+      g_0);
+
+  // barometric formula of an isothermal atmosphere
+  for (Length h = 0_m; h <= 30000_m; h += 2500_m) {
+    Pressure P = 100000_Pa * Pexp(-1 * g_0 * M * h / (R * T));
+    ASSERT_NEAR(
+        T.getValue(),
+        layeredAtmosphere->getAtmosphereTemperatureByHeight(h).getValue(),
+        1e-12);
+    ASSERT_NEAR(P.getValue(),
+                layeredAtmosphere->getAtmospherePressureByHeight(h).getValue(),
+                1e-9 * P.getValue());
+    ASSERT_NEAR((P * M / (R * T)).getValue(),
+                layeredAtmosphere->getAtmosphereDensityByHeight(h).getValue(),
+                1e-9 * (P * M / (R * T)).getValue());
+  }
+}
+
+TEST(LayeredAtmosphereTest, TestTemperatureOffset) {
+  // SUT
+  auto hotDay = std::make_unique<LayeredAtmosphere>(
+      USStandardAtmosphere1976::withTemperatureOffset(15_K));
+  auto coldDay = std::make_unique<LayeredAtmosphere>(
+      USStandardAtmosphere1976::withTemperatureOffset(-1 * 15_K));
+  auto standardDay = std::make_unique<USStandardAtmosphere1976>();
+
+  for (Length h = 0_m; h <= 85000_m; h += 5000_m) {
+    double T = standardDay->getAtmosphereTemperatureByHeight(h).getValue();
+    ASSERT_NEAR(T + 15.0,
+                hotDay->getAtmosphereTemperatureByHeight(h).getValue(), 1e-9);
+    ASSERT_NEAR(T - 15.0,
+                coldDay->getAtmosphereTemperatureByHeight(h).getValue(),
+                1e-9);
+  }
+
+  // same sea level pressure, the warm air is less dense
+  ASSERT_NEAR(101325.0, hotDay->getAtmospherePressureByHeight(0_m).getValue(),
+              1e-9);
+  ASSERT_LT(hotDay->getAtmosphereDensityByHeight(0_m).getValue(),
+            standardDay->getAtmosphereDensityByHeight(0_m).getValue());
+  ASSERT_GT(coldDay->getAtmosphereDensityByHeight(0_m).getValue(),
+            standardDay->getAtmosphereDensityByHeight(0_m).getValue());
+
+  // a warm column decays slower with height
+  ASSERT_GT(hotDay->getAtmospherePressureByHeight(20000_m).getValue(),
+            standardDay->getAtmospherePressureByHeight(20000_m).getValue());
+}
+
+TEST(LayeredAtmosphereTest, TestBatchMatchesScalar) {
+  // SUT
+  auto layeredAtmosphere = std::make_unique<LayeredAtmosphere>(
+      USStandardAtmosphere1976::withTemperatureOffset(-1 * 20_K));
+
+  std::vector<Length> h;
+  for (int i = 0; i <= 850; ++i) h.push_back(i * 100_m);
+
+  std::vector<Temperature> T(h.size());
+  std::vector<Pressure> P(h.size());
+  std::vector<Density> rho(h.size());
+  layeredAtmosphere->getAtmosphereStateByHeight(h.data(), T.data(), P.data(),
+                                                rho.data(), h.size());
+
+  for (size_t i = 0; i < h.size(); ++i) {
+    Temperature T_ref =
+        layeredAtmosphere->getAtmosphereTemperatureByHeight(h[i]);
+    Pressure P_ref = layeredAtmosphere->getAtmospherePressureByHeight(h[i]);
+    Density rho_ref = layeredAtmosphere->getAtmosphereDensityByHeight(h[i]);
+
+    ASSERT_NEAR(T_ref.getValue(), T[i].getValue(), 1e-12 * T_ref.getValue());
+    ASSERT_NEAR(P_ref.getValue(), P[i].getValue(), 1e-12 * P_ref.getValue());
+    ASSERT_NEAR(rho_ref.getValue(), rho[i].getValue(),
+                1e-12 * rho_ref.getValue());
+  }
+}
+
+TEST(LayeredAtmosphereTest, TestInvalidLayers) {
+  MolarMass M = 0.0289644_kgpmol;
+
+  // no layers
+  ASSERT_THROW(LayeredAtmosphere({}, 1000_m, 288.15_K, 101325_Pa, M, g_0),
+               SpaceToolkitException);
+
+  // base heights not increasing
+  ASSERT_THROW(LayeredAtmosphere({{0_m, 0_Kpm}, {0_m, 0_Kpm}}, 1000_m,
+                                 288.15_K, 101325_Pa, M, g_0),
+               SpaceToolkitException);
+
+  // top below the last base height
+  ASSERT_THROW(LayeredAtmosphere({{0_m, 0_Kpm}, {2000_m, 0_Kpm}}, 1000_m,
+                                 288.15_K, 101325_Pa, M, g_0),
+               SpaceToolkitException);
+
+  // temperature drops below 0 K
+  ASSERT_THROW(LayeredAtmosphere({{0_m, -1 * 0.01_Kpm}}, 50000_m, 288.15_K,
+                                 101325_Pa, M, g_0),
+               SpaceToolkitException);
+}
+
+TEST(LayeredAtmosphereTest, TestInverseQueries) {
+  // SUT
+  auto layeredAtmosphere = std::make_unique<LayeredAtmosphere>(
+      USStandardAtmosphere1976::withTemperatureOffset(15_K));
+
+  std::vector<Length> h;
+  for (int i = 0; i <= 850; ++i) h.push_back(i * 100_m);
+
+  std::vector<Pressure> P(h.size());
+  std::vector<Density> rho(h.size());
+  layeredAtmosphere->getAtmospherePressureByHeight(h.data(), P.data(),
+                                                   h.size());
+  layeredAtmosphere->getAtmosphereDensityByHeight(h.data(), rho.data(),
+                                                  h.size());
+
+  std::vector<Length> h_P(h.size());
+  std::vector<Length> h_rho(h.size());
+  layeredAtmosphere->getHeightByPressure(P.data(), h_P.data(), h.size());
+  layeredAtmosphere->getHeightByDensity(rho.data(), h_rho.data(), h.size());
+
+  for (size_t i = 0; i < h.size(); ++i) {
+    ASSERT_NEAR(h[i].getValue(),
+                layeredAtmosphere->getHeightByPressure(P[i]).getValue(), 1e-6);
+    ASSERT_NEAR(h[i].getValue(),
+                layeredAtmosphere->getHeightByDensity(rho[i]).getValue(),
+                1e-6);
+    ASSERT_NEAR(h[i].getValue(), h_P[i].getValue(), 1e-6);
+    ASSERT_NEAR(h[i].getValue(), h_rho[i].getValue(), 1e-6);
+  }
+
+  // the scalar queries at the ends are in range
+  ASSERT_EQ(0.0, layeredAtmosphere
+                     ->getHeightByPressure(
+                         layeredAtmosphere->getAtmospherePressureByHeight(0_m))
+                     .getValue());
+  ASSERT_NEAR(85000.0,
+              layeredAtmosphere
+                  ->getHeightByDensity(
+                      layeredAtmosphere->getAtmosphereDensityByHeight(85000_m))
+                  .getValue(),
+              1e-6);
+
+  ASSERT_THROW(layeredAtmosphere->getHeightByPressure(
+                   layeredAtmosphere->getBottomPressure() * 1.001),
+               SpaceToolkitException);
+  ASSERT_THROW(layeredAtmosphere->getHeightByDensity(
+                   layeredAtmosphere->getTopDensity() * 0.999),
+               SpaceToolkitException);
+  P.back() = 0_Pa;
+  ASSERT_THROW(
+      layeredAtmosphere->getHeightByPressure(P.data(), h_P.data(), P.size()),
+      SpaceToolkitException);
+}
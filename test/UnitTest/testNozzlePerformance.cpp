@@ -0,0 +1,125 @@
+#include <cmath>
+#include <vector>
+
+#include "SpaceToolkit/LavalNozzle.h"
+#include "SpaceToolkit/NozzlePerformance.h"
+#include "SpaceToolkit/SpaceToolkitException.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using SpaceToolkit::LavalNozzle;
+using SpaceToolkit::NozzlePerformance;
+using SpaceToolkit::SpaceToolkitException;
+
+// the design of LavalNozzleTest with a hydrogen peroxide like exhaust
+TEST(NozzlePerformanceTest, TestPerformance) {
+  Force F = 500_N;
+  Number kappa = 1.21;
+  Pressure p_c = 1500000_Pa;
+  Pressure p_e = 101325_Pa;
+  Temperature T_c = 1000_K;
+  MolarMass M = MolarMass(0.022);
+  LavalNozzle lavalNozzle(F, kappa, p_c, p_e);
+
+  // SUT
+  NozzlePerformance performance(lavalNozzle.getDesign(), T_c, M);
+
+  // the closed forms with a pow call per term
+  double k = kappa.getValue();
+  double RT = R.getValue() * T_c.getValue() / M.getValue();
+  double gamma = std::sqrt(k * std::pow(2 / (k + 1), (k + 1) / (k - 1)));
+  double cStar = std::sqrt(RT) / gamma;
+  double ratio = p_e.getValue() / p_c.getValue();
+  double exitVelocity =
+      std::sqrt(2 * k / (k - 1) * RT * (1 - std::pow(ratio, (k - 1) / k)));
+  double mDot = F.getValue() / exitVelocity;
+  double A_e = lavalNozzle.exitCrossSectionalArea().getValue();
+
+  ASSERT_NEAR(cStar, performance.characteristicVelocity().getValue(),
+              1e-12 * cStar);
+  ASSERT_NEAR(mDot, performance.massFlowRate().getValue(), 1e-12 * mDot);
+
+  // adapted, in vacuum and at sea level, where the nozzle is just adapted
+  for (double p_a : {p_e.getValue(), 0.0, 101325.0, 50000.0}) {
+    double thrust = F.getValue() + (p_e.getValue() - p_a) * A_e;
+    double C_F = thrust / (p_c.getValue() *
+                           lavalNozzle.throatCrossSectionalArea().getValue());
+    ASSERT_NEAR(thrust, performance.thrust(Pressure(p_a)).getValue(),
+                1e-12 * thrust);
+    ASSERT_NEAR(C_F, performance.thrustCoefficient(Pressure(p_a)).getValue(),
+                1e-12 * C_F);
+    ASSERT_NEAR(thrust / (mDot * g_0.getValue()),
+                performance.specificImpulse(Pressure(p_a)).getValue(),
+                1e-9);
+    ASSERT_NEAR(cStar * C_F / g_0.getValue(),
+                performance.specificImpulse(Pressure(p_a)).getValue(), 1e-9);
+  }
+  ASSERT_NEAR(exitVelocity / g_0.getValue(),
+              performance.seaLevelSpecificImpulse().getValue(), 1e-9);
+  ASSERT_NEAR(
+      (F.getValue() + p_e.getValue() * A_e) / (mDot * g_0.getValue()),
+      performance.vacuumSpecificImpulse().getValue(), 1e-9);
+  ASSERT_GT(performance.vacuumSpecificImpulse().getValue(),
+            performance.seaLevelSpecificImpulse().getValue());
+
+  ASSERT_THROW(NozzlePerformance(lavalNozzle.getDesign(), 0_K, M),
+               SpaceToolkitException);
+  ASSERT_THROW(NozzlePerformance(lavalNozzle.getDesign(), T_c, MolarMass(0.0)),
+               SpaceToolkitException);
+}
+
+TEST(NozzlePerformanceTest, TestBatchPerformance) {
+  // a partial chunk after a full one, the last points are invalid designs
+  // with p_e == p_c and p_e > p_c
+  const size_t n = 1500;
+  std::vector<Force> F(n);
+  std::vector<Number> kappa(n);
+  std::vector<Pressure> p_c(n), p_e(n), p_a(n);
+  std::vector<Temperature> T_c(n);
+  std::vector<MolarMass> M(n);
+  for (size_t i = 0; i < n; ++i) {
+    double x = double(i) / n;
+    F[i] = Force(100.0 + 1.0e5 * x);
+    kappa[i] = Number(1.15 + 0.25 * x);
+    p_c[i] = Pressure(1.0e6 + 1.9e7 * x);
+    p_e[i] = Pressure(i < n - 10 ? 5.0e3 + 9.6e4 * (1.0 - x) : 2.0e7);
+    if (i == n - 10) p_e[i] = p_c[i];
+    p_a[i] = Pressure(101325.0 * (i % 3) / 2);
+    T_c[i] = Temperature(900.0 + 2700.0 * x);
+    M[i] = MolarMass(0.030 - 0.026 * x);
+  }
+
+  // SUT
+  std::vector<Speed> cStar(n);
+  std::vector<MassFlowRate> mDot(n);
+  std::vector<Number> C_F(n);
+  std::vector<Force> thrust(n);
+  std::vector<Time> I_sp(n);
+  NozzlePerformance::performance(F.data(), kappa.data(), p_c.data(),
+                                 p_e.data(), T_c.data(), M.data(), p_a.data(),
+                                 cStar.data(), mDot.data(), C_F.data(),
+                                 thrust.data(), I_sp.data(), n);
+
+  for (size_t i = 0; i < n; ++i) {
+    NozzlePerformance performance(
+        LavalNozzle::design(F[i], kappa[i], p_c[i], p_e[i]), T_c[i], M[i]);
+    if (i >= n - 10) {
+      ASSERT_TRUE(std::isnan(performance.massFlowRate().getValue()));
+      ASSERT_TRUE(std::isnan(performance.thrust(p_a[i]).getValue()));
+      ASSERT_TRUE(std::isnan(C_F[i].getValue()));
+      ASSERT_TRUE(std::isnan(mDot[i].getValue()));
+      ASSERT_TRUE(std::isnan(thrust[i].getValue()));
+      ASSERT_TRUE(std::isnan(I_sp[i].getValue()));
+      continue;
+    }
+    auto near = [](double expected, double actual) {
+      ASSERT_NEAR(expected, actual, 1e-12 * std::fabs(expected));
+    };
+    near(performance.characteristicVelocity().getValue(),
+         cStar[i].getValue());
+    near(performance.massFlowRate().getValue(), mDot[i].getValue());
+    near(performance.thrustCoefficient(p_a[i]).getValue(), C_F[i].getValue());
+    near(performance.thrust(p_a[i]).getValue(), thrust[i].getValue());
+    near(performance.specificImpulse(p_a[i]).getValue(), I_sp[i].getValue());
+  }
+}
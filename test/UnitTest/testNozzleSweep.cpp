@@ -0,0 +1,237 @@
+#include "SpaceToolkit/LavalNozzle.h"
+#include "SpaceToolkit/NozzleSweep.h"
+#include "SpaceToolkit/SpaceToolkitException.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using SpaceToolkit::LavalNozzle;
+using SpaceToolkit::MinimumMassFlowReduction;
+using SpaceToolkit::NozzleSweep;
+using SpaceToolkit::NozzleSweepBlock;
+using SpaceToolkit::NozzleSweepGrid;
+using SpaceToolkit::NozzleSweepPoint;
+using SpaceToolkit::NozzleSweepSink;
+using SpaceToolkit::ParetoFrontReduction;
+using SpaceToolkit::SpaceToolkitException;
+
+namespace {
+// 12600 points in 13 blocks. The highest exit pressures are above the lowest
+// chamber pressure, which gives invalid designs.
+NozzleSweepGrid testGrid() {
+  return {{100_N, 50_N, 10},
+          {Number(1.15), Number(0.05), 5},
+          {1000000_Pa, 1000000_Pa, 6},
+          {5000_Pa, 200000_Pa, 7},
+          {2800_K, 300_K, 3},
+          {MolarMass(0.018), MolarMass(0.004), 2}};
+}
+
+// stores the designs of all points
+class StoringSink : public NozzleSweepSink {
+ public:
+  std::vector<double> d_t, d_e, I_sp, mDot, F;
+  std::vector<int> visits;
+
+  explicit StoringSink(size_t n)
+      : d_t(n), d_e(n), I_sp(n), mDot(n), F(n), visits(n) {}
+
+  void consume(const NozzleSweepBlock& block) {
+    for (size_t i = 0; i < block.n; ++i) {
+      size_t j = block.first + i;
+      d_t[j] = block.throatDiameter[i].getValue();
+      d_e[j] = block.exitDiameter[i].getValue();
+      I_sp[j] = block.specificImpulse[i].getValue();
+      mDot[j] = block.massFlowRate[i].getValue();
+      F[j] = block.desiredThrust[i].getValue();
+      ++visits[j];
+    }
+  }
+};
+
+void expectNear(double expected, double actual) {
+  if (std::isnan(expected))
+    ASSERT_TRUE(std::isnan(actual));
+  else
+    ASSERT_NEAR(1.0, actual / expected, 1e-12);
+}
+}  // namespace
+
+TEST(NozzleSweepTest, TestGrid) {
+  NozzleSweepGrid grid = testGrid();
+  ASSERT_TRUE(grid.hasPerformance());
+  ASSERT_EQ(12600u, grid.getPointCount());
+  ASSERT_EQ(2800.0, grid.chamberTemperature[0].getValue());
+  ASSERT_EQ(3400.0, grid.chamberTemperature[2].getValue());
+
+  grid.molarMass.count = 0;
+  ASSERT_FALSE(grid.hasPerformance());
+  ASSERT_EQ(2100u, grid.getPointCount());
+}
+
+TEST(NozzleSweepTest, TestSink) {
+  NozzleSweepGrid grid = testGrid();
+  size_t n = grid.getPointCount();
+
+  for (size_t threadCount : {1u, 4u}) {
+    // SUT
+    NozzleSweep sweep(threadCount);
+    StoringSink sink(n);
+    sweep.sweep(grid, &sink);
+
+    // the point index runs over the thrust fastest
+    size_t j = 0;
+    for (size_t m = 0; m < grid.molarMass.count; ++m)
+      for (size_t t = 0; t < grid.chamberTemperature.count; ++t)
+        for (size_t e = 0; e < grid.exitPressure.count; ++e)
+          for (size_t c = 0; c < grid.chamberPressure.count; ++c)
+            for (size_t k = 0; k < grid.exhaustHeatCapacityRatio.count; ++k)
+              for (size_t f = 0; f < grid.desiredThrust.count; ++f, ++j) {
+                ASSERT_EQ(1, sink.visits[j]);
+                LavalNozzle lavalNozzle(grid.desiredThrust[f],
+                                        grid.exhaustHeatCapacityRatio[k],
+                                        grid.chamberPressure[c],
+                                        grid.exitPressure[e]);
+                const SpaceToolkit::NozzleDesign& design =
+                    lavalNozzle.getDesign();
+
+                // ideal exhaust velocity of the expansion to p_e
+                double kappa = grid.exhaustHeatCapacityRatio[k].getValue();
+                double v_e = std::sqrt(
+                    2 * kappa / (kappa - 1) *
+                    (R * grid.chamberTemperature[t] / grid.molarMass[m])
+                        .getValue() *
+                    (1 - design.pressureRatioTerm.getValue()));
+
+                expectNear(lavalNozzle.throatDiameter().getValue(),
+                           sink.d_t[j]);
+                expectNear(lavalNozzle.exitDiameter().getValue(),
+                           sink.d_e[j]);
+                expectNear(v_e / g_0.getValue(), sink.I_sp[j]);
+                expectNear(grid.desiredThrust[f].getValue() / v_e,
+                           sink.mDot[j]);
+              }
+  }
+}
+
+TEST(NozzleSweepTest, TestReductions) {
+  NozzleSweepGrid grid = testGrid();
+  size_t n = grid.getPointCount();
+  NozzleSweep serial(1);
+  StoringSink sink(n);
+  serial.sweep(grid, &sink);
+
+  // the front by sorting: a point is on it if its specific impulse is above
+  // that of all points before it
+  std::vector<size_t> order;
+  for (size_t j = 0; j < n; ++j)
+    if (!std::isnan(sink.I_sp[j])) order.push_back(j);
+  ASSERT_LT(order.size(), n);
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    if (sink.d_e[a] != sink.d_e[b]) return sink.d_e[a] < sink.d_e[b];
+    if (sink.I_sp[a] != sink.I_sp[b]) return sink.I_sp[a] > sink.I_sp[b];
+    return a < b;
+  });
+  std::vector<size_t> front;
+  for (size_t j : order)
+    if (front.empty() || sink.I_sp[j] > sink.I_sp[front.back()])
+      front.push_back(j);
+
+  // the envelope by a search over all points
+  const Force minimumThrust = 300_N;
+  const Length maximumExitDiameter = 0.05_m;
+  size_t minimum = n;
+  for (size_t j = 0; j < n; ++j)
+    if (sink.F[j] >= minimumThrust.getValue() &&
+        sink.d_e[j] <= maximumExitDiameter.getValue() &&
+        (minimum == n || sink.mDot[j] < sink.mDot[minimum]))
+      minimum = j;
+  ASSERT_LT(minimum, n);
+
+  for (size_t threadCount : {1u, 3u, 4u}) {
+    // SUT
+    NozzleSweep sweep(threadCount);
+    ParetoFrontReduction pareto;
+    MinimumMassFlowReduction envelope(minimumThrust, maximumExitDiameter);
+    sweep.sweep(grid, nullptr, {&pareto, &envelope});
+
+    const std::vector<NozzleSweepPoint>& result = pareto.getFront();
+    ASSERT_EQ(front.size(), result.size());
+    for (size_t i = 0; i < front.size(); ++i) {
+      ASSERT_EQ(front[i], result[i].index);
+      ASSERT_EQ(sink.I_sp[front[i]], result[i].specificImpulse.getValue());
+    }
+    ASSERT_TRUE(envelope.hasMinimum());
+    ASSERT_EQ(minimum, envelope.getMinimum().index);
+    ASSERT_EQ(sink.mDot[minimum],
+              envelope.getMinimum().massFlowRate.getValue());
+  }
+
+  // no design in the envelope
+  MinimumMassFlowReduction empty(1000_N, maximumExitDiameter);
+  serial.sweep(grid, nullptr, {&empty});
+  ASSERT_FALSE(empty.hasMinimum());
+}
+
+TEST(NozzleSweepTest, TestInvalidDesigns) {
+  // exit pressures below, at and above the chamber pressures
+  NozzleSweepGrid grid = {{100_N, 50_N, 3},
+                          {Number(1.2), Number(0.1), 2},
+                          {1000000_Pa, 1000000_Pa, 2},
+                          {500000_Pa, 500000_Pa, 5},
+                          {3000_K, 300_K, 2},
+                          {MolarMass(0.02), MolarMass(0.004), 2}};
+  size_t n = grid.getPointCount();
+
+  // SUT
+  NozzleSweep sweep(2);
+  StoringSink sink(n);
+  ParetoFrontReduction pareto;
+  MinimumMassFlowReduction envelope(0_N, 1_m);
+  sweep.sweep(grid, &sink, {&pareto, &envelope});
+
+  size_t invalid = 0;
+  for (size_t j = 0; j < n; ++j) {
+    // the chamber and exit pressure indices of the point
+    size_t c = j / 6 % 2;
+    size_t e = j / 12 % 5;
+    bool valid = grid.exitPressure[e] < grid.chamberPressure[c];
+    invalid += !valid;
+    ASSERT_EQ(!valid, std::isnan(sink.d_t[j]));
+    ASSERT_EQ(!valid, std::isnan(sink.d_e[j]));
+    ASSERT_EQ(!valid, std::isnan(sink.I_sp[j]));
+    ASSERT_EQ(!valid, std::isnan(sink.mDot[j]));
+  }
+  // p_e == p_c twice and p_e > p_c four times, each for 24 points
+  ASSERT_EQ(6u * 24u, invalid);
+
+  ASSERT_FALSE(pareto.getFront().empty());
+  for (const NozzleSweepPoint& point : pareto.getFront())
+    ASSERT_FALSE(std::isnan(sink.I_sp[point.index]));
+  ASSERT_TRUE(envelope.hasMinimum());
+  ASSERT_FALSE(std::isnan(sink.mDot[envelope.getMinimum().index]));
+}
+
+TEST(NozzleSweepTest, TestException) {
+  NozzleSweep sweep(4);
+  NozzleSweepGrid grid = testGrid();
+
+  // an empty axis of the design
+  grid.exitPressure.count = 0;
+  ASSERT_THROW(sweep.sweep(grid, nullptr), SpaceToolkitException);
+
+  // a reduction which needs the performance axes, from all threads
+  grid = testGrid();
+  grid.chamberTemperature.count = 0;
+  ParetoFrontReduction pareto;
+  ASSERT_THROW(sweep.sweep(grid, nullptr, {&pareto}), SpaceToolkitException);
+  ASSERT_TRUE(pareto.getFront().empty());
+
+  // the pool still works
+  grid = testGrid();
+  sweep.sweep(grid, nullptr, {&pareto});
+  ASSERT_FALSE(pareto.getFront().empty());
+}
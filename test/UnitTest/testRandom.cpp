@@ -0,0 +1,57 @@
+#include <cmath>
+
+#include "SpaceToolkit/Random.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Random = SpaceToolkit::Random;
+
+TEST(RandomTest, TestPhiloxKnownAnswers) {
+  // known answer tests of Random123
+  Random::Philox4x32 r = Random::philox({{0, 0, 0, 0}}, 0, 0);
+  ASSERT_THAT(r.x, testing::ElementsAre(0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu,
+                                        0x9b00dbd8u));
+
+  r = Random::philox({{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}},
+                     0xffffffff, 0xffffffff);
+  ASSERT_THAT(r.x, testing::ElementsAre(0x408f276du, 0x41c83b0eu, 0xa20bc7c6u,
+                                        0x6d5451fdu));
+
+  r = Random::philox({{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}},
+                     0xa4093822, 0x299f31d0);
+  ASSERT_THAT(r.x, testing::ElementsAre(0xd16cfe09u, 0x94fdccebu, 0x5001e420u,
+                                        0x24126ea1u));
+}
+
+TEST(RandomTest, TestNormalMoments) {
+  // mean, variance and kurtosis of 2 * 10^5 numbers of two streams
+  const int N = 100000;
+  double sum = 0.0, sum2 = 0.0, sum4 = 0.0, product = 0.0;
+  for (uint64_t stream : {0u, 1u}) {
+    for (int i = 0; i < N / 2; ++i) {
+      double z0, z1;
+      Random::normalPair(7, stream, i, z0, z1);
+      for (double z : {z0, z1}) {
+        sum += z;
+        sum2 += z * z;
+        sum4 += z * z * z * z;
+      }
+      product += z0 * z1;
+    }
+  }
+
+  ASSERT_NEAR(0.0, sum / (2 * N), 0.01);
+  ASSERT_NEAR(1.0, sum2 / (2 * N), 0.01);
+  ASSERT_NEAR(3.0, sum4 / (2 * N), 0.05);
+  ASSERT_NEAR(0.0, product / N, 0.01);
+
+  // the numbers depend on the seed, the stream and the pair
+  double a0, a1, b0, b1, c0, c1, d0, d1;
+  Random::normalPair(7, 0, 0, a0, a1);
+  Random::normalPair(8, 0, 0, b0, b1);
+  Random::normalPair(7, 1, 0, c0, c1);
+  Random::normalPair(7, 0, 1, d0, d1);
+  ASSERT_NE(a0, b0);
+  ASSERT_NE(a0, c0);
+  ASSERT_NE(a0, d0);
+}
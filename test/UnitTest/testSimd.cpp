@@ -0,0 +1,59 @@
+#include <cmath>
+
+#include "SpaceToolkit/Simd.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Simd = SpaceToolkit::Simd;
+
+TEST(SimdTest, TestExp) {
+  for (double x = -700.0; x <= 700.0; x += 0.0137) {
+    double ref = std::exp(x);
+    ASSERT_NEAR(ref, Simd::exp(x), 1e-15 * ref) << "x = " << x;
+  }
+}
+
+TEST(SimdTest, TestLog) {
+  for (double x = 1e-300; x < 1e300; x *= 1.0137) {
+    double ref = std::log(x);
+    ASSERT_NEAR(ref, Simd::log(x), 1e-15 * std::fabs(ref) + 1e-16)
+        << "x = " << x;
+  }
+  for (double x = 0.5; x <= 2.0; x += 1e-5) {
+    double ref = std::log(x);
+    ASSERT_NEAR(ref, Simd::log(x), 1e-15 * std::fabs(ref) + 1e-16)
+        << "x = " << x;
+  }
+}
+
+TEST(SimdTest, TestSqrt) {
+  for (double x = 1e-300; x < 1e300; x *= 1.0137) {
+    double ref = std::sqrt(x);
+    ASSERT_NEAR(ref, Simd::sqrt(x), 4e-16 * ref) << "x = " << x;
+  }
+  for (double x = 0.5; x <= 4.0; x += 1e-5) {
+    double ref = std::sqrt(x);
+    ASSERT_NEAR(ref, Simd::sqrt(x), 4e-16 * ref) << "x = " << x;
+  }
+  ASSERT_EQ(Simd::sqrt(2.0), Simd::sqrtOrNaN(2.0));
+  ASSERT_TRUE(std::isnan(Simd::sqrtOrNaN(0.0)));
+  ASSERT_TRUE(std::isnan(Simd::sqrtOrNaN(-2.0)));
+  ASSERT_TRUE(std::isnan(Simd::sqrtOrNaN(NAN)));
+}
+
+TEST(SimdTest, TestFloatExpAndLog) {
+  for (float x = -87.0f; x <= 88.0f; x += 0.0137f) {
+    double ref = std::exp(static_cast<double>(x));
+    ASSERT_NEAR(ref, Simd::exp(x), 3e-7 * ref) << "x = " << x;
+  }
+  for (float x = 1e-37f; x < 1e38f; x *= 1.0137f) {
+    double ref = std::log(static_cast<double>(x));
+    ASSERT_NEAR(ref, Simd::log(x), 2e-7 * std::fabs(ref) + 1e-7)
+        << "x = " << x;
+  }
+  for (float x = 0.5f; x <= 2.0f; x += 1e-5f) {
+    double ref = std::log(static_cast<double>(x));
+    ASSERT_NEAR(ref, Simd::log(x), 2e-7 * std::fabs(ref) + 1e-7)
+        << "x = " << x;
+  }
+}
@@ -0,0 +1,109 @@
+#include "SpaceToolkit/SpaceToolkitException.h"
+#include "SpaceToolkit/TabulatedAtmosphere.h"
+#include "SpaceToolkit/USStandardAtmosphere1976.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using SpaceToolkit::AtmosphereLayer;
+using SpaceToolkit::AtmosphereState;
+using SpaceToolkit::SpaceToolkitException;
+using SpaceToolkit::TabulatedAtmosphere;
+using SpaceToolkit::USStandardAtmosphere1976;
+
+namespace {
+std::vector<Length> layerBoundaries() {
+  std::vector<Length> boundaries;
+  for (const AtmosphereLayer& layer : USStandardAtmosphere1976::layers())
+    boundaries.push_back(layer.baseHeight);
+  return boundaries;
+}
+
+// relative error of the table against the source on a 1 m grid
+void expectWithinBound(TabulatedAtmosphere& table,
+                       USStandardAtmosphere1976& source, double bound) {
+  for (int i = 0; i <= 85000; ++i) {
+    Length h = i * 1_m;
+    AtmosphereState expected = source.getAtmosphereStateByHeight(h);
+    AtmosphereState state = table.getAtmosphereStateByHeight(h);
+
+    ASSERT_NEAR(expected.T.getValue(), state.T.getValue(),
+                bound * expected.T.getValue());
+    ASSERT_NEAR(expected.P.getValue(), state.P.getValue(),
+                bound * expected.P.getValue());
+    ASSERT_NEAR(expected.rho.getValue(), state.rho.getValue(),
+                bound * expected.rho.getValue());
+  }
+}
+}  // namespace
+
+TEST(TabulatedAtmosphereTest, TestErrorBound) {
+  USStandardAtmosphere1976 usStandardAtmosphere1976;
+
+  // SUT
+  auto tabulatedAtmosphere = std::make_unique<TabulatedAtmosphere>(
+      usStandardAtmosphere1976, 0_m, 85000_m, 1e-6, layerBoundaries());
+
+  expectWithinBound(*tabulatedAtmosphere, usStandardAtmosphere1976, 1e-6);
+
+  // a tighter bound needs more segments
+  TabulatedAtmosphere tighter(usStandardAtmosphere1976, 0_m, 85000_m, 1e-9,
+                              layerBoundaries());
+  expectWithinBound(tighter, usStandardAtmosphere1976, 1e-9);
+  ASSERT_GT(tighter.getSegmentCount(),
+            tabulatedAtmosphere->getSegmentCount());
+}
+
+TEST(TabulatedAtmosphereTest, TestWithoutBreakpoints) {
+  USStandardAtmosphere1976 usStandardAtmosphere1976;
+
+  // SUT
+  auto tabulatedAtmosphere = std::make_unique<TabulatedAtmosphere>(
+      usStandardAtmosphere1976, 0_m, 85000_m, 1e-6);
+
+  expectWithinBound(*tabulatedAtmosphere, usStandardAtmosphere1976, 1e-6);
+}
+
+TEST(TabulatedAtmosphereTest, TestBatchMatchesScalar) {
+  USStandardAtmosphere1976 usStandardAtmosphere1976;
+
+  // SUT
+  auto tabulatedAtmosphere = std::make_unique<TabulatedAtmosphere>(
+      usStandardAtmosphere1976, 0_m, 85000_m, 1e-6, layerBoundaries());
+
+  std::vector<Length> h;
+  for (int i = 0; i <= 850; ++i) h.push_back(i * 100_m);
+
+  std::vector<Temperature> T(h.size());
+  std::vector<Pressure> P(h.size());
+  std::vector<Density> rho(h.size());
+  tabulatedAtmosphere->getAtmosphereStateByHeight(h.data(), T.data(), P.data(),
+                                                  rho.data(), h.size());
+
+  for (size_t i = 0; i < h.size(); ++i) {
+    AtmosphereState state = tabulatedAtmosphere->getAtmosphereStateByHeight(h[i]);
+    ASSERT_EQ(state.T.getValue(), T[i].getValue());
+    ASSERT_EQ(state.P.getValue(), P[i].getValue());
+    ASSERT_EQ(state.rho.getValue(), rho[i].getValue());
+  }
+}
+
+TEST(TabulatedAtmosphereTest, TestInputHeightOutOfRange) {
+  USStandardAtmosphere1976 usStandardAtmosphere1976;
+
+  // SUT
+  auto tabulatedAtmosphere = std::make_unique<TabulatedAtmosphere>(
+      usStandardAtmosphere1976, 10000_m, 50000_m, 1e-6, layerBoundaries());
+
+  ASSERT_THROW(tabulatedAtmosphere->getAtmospherePressureByHeight(9999.9_m),
+               SpaceToolkitException);
+  ASSERT_THROW(tabulatedAtmosphere->getAtmospherePressureByHeight(50000.1_m),
+               SpaceToolkitException);
+
+  ASSERT_THROW(TabulatedAtmosphere(usStandardAtmosphere1976, 0_m, 0_m, 1e-6),
+               SpaceToolkitException);
+  ASSERT_THROW(
+      TabulatedAtmosphere(usStandardAtmosphere1976, 0_m, 85000_m, 0.0),
+      SpaceToolkitException);
+}
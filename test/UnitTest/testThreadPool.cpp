@@ -0,0 +1,49 @@
+#include "SpaceToolkit/SpaceToolkitException.h"
+#include "SpaceToolkit/ThreadPool.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <vector>
+
+using SpaceToolkit::SpaceToolkitException;
+using SpaceToolkit::ThreadPool;
+
+TEST(ThreadPoolTest, TestRun) {
+  // SUT
+  ThreadPool pool(4);
+  ASSERT_EQ(4u, pool.getThreadCount());
+
+  // every thread is called once per run, with its own index
+  std::vector<std::atomic<int>> calls(pool.getThreadCount());
+  for (int run = 1; run <= 3; ++run) {
+    pool.run([&](size_t index) { ++calls[index]; });
+    for (std::atomic<int>& count : calls) ASSERT_EQ(run, count.load());
+  }
+
+  ASSERT_LE(1u, ThreadPool().getThreadCount());
+}
+
+TEST(ThreadPoolTest, TestException) {
+  // SUT
+  ThreadPool pool(4);
+
+  // the threads take numbers until none is left or one has thrown
+  std::atomic<size_t> next(0);
+  ThreadPool::Task task = [&](size_t) {
+    for (;;) {
+      size_t i = next.fetch_add(1);
+      if (i >= 1000 || pool.hasFailed()) return;
+      if (i == 100)
+        throw SpaceToolkitException("errUnknown", __FILE__, __LINE__);
+    }
+  };
+  ASSERT_THROW(pool.run(task), SpaceToolkitException);
+  ASSERT_TRUE(pool.hasFailed());
+
+  // the pool still works
+  std::atomic<int> calls(0);
+  pool.run([&](size_t) { ++calls; });
+  ASSERT_FALSE(pool.hasFailed());
+  ASSERT_EQ(4, calls.load());
+}
@@ -3,9 +3,27 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using SpaceToolkit::AtmosphereProperties;
+using SpaceToolkit::AtmosphereState;
+using SpaceToolkit::AtmosphereStatus;
+using SpaceToolkit::OutOfRangePolicy;
 using SpaceToolkit::SpaceToolkitException;
 using SpaceToolkit::USStandardAtmosphere1976;
 
+namespace {
+// geopotential height of a geometric altitude, the tables of the standard
+// above 86 km are given by geometric altitude
+Length geopotential(double Z) {
+  const double r_0 = 6356766.0;
+  return Length(r_0 * Z / (r_0 + Z));
+}
+}  // namespace
+
 TEST(USStandardAtmosphere1976Test, TestTemperaturesAtLevelBorders) {
   // SUT
   auto usStandardAtmosphere1976 = std::make_unique<USStandardAtmosphere1976>();
@@ -175,16 +193,17 @@ TEST(USStandardAtmosphere1976Test, TestDensityAtLevelBorders) {
 TEST(USStandardAtmosphere1976Test, TestInputHeightOutOfRange) {
   // SUT
   auto usStandardAtmosphere1976 = std::make_unique<USStandardAtmosphere1976>();
+  Length h_top = usStandardAtmosphere1976->getTopHeight();
 
   // temperature calculation - negative height 0.1 meter beyond sea level
   ASSERT_THROW(
       usStandardAtmosphere1976->getAtmosphereTemperatureByHeight(-1 * 0.1_m),
       SpaceToolkitException);
 
-  // temperature calculation - above atmosphere end at 85000.1 meter beyond sea
-  // level
+  // temperature calculation - 0.1 meter above atmosphere end at 1000 km
+  // geometric altitude
   ASSERT_THROW(
-      usStandardAtmosphere1976->getAtmosphereTemperatureByHeight(85000.1_m),
+      usStandardAtmosphere1976->getAtmosphereTemperatureByHeight(h_top + 0.1_m),
       SpaceToolkitException);
 
   // pressure calculation - negative height 0.1 meter beyond sea level
@@ -192,10 +211,9 @@ TEST(USStandardAtmosphere1976Test, TestInputHeightOutOfRange) {
       usStandardAtmosphere1976->getAtmospherePressureByHeight(-1 * 0.1_m),
       SpaceToolkitException);
 
-  // pressure calculation -  above atmosphere end at 85000.1 meter beyond sea
-  // level
+  // pressure calculation - 0.1 meter above atmosphere end
   ASSERT_THROW(
-      usStandardAtmosphere1976->getAtmospherePressureByHeight(85000.1_m),
+      usStandardAtmosphere1976->getAtmospherePressureByHeight(h_top + 0.1_m),
       SpaceToolkitException);
 
   // density calculation - negative height 0.1 meter beyond sea level
@@ -203,9 +221,664 @@ TEST(USStandardAtmosphere1976Test, TestInputHeightOutOfRange) {
       usStandardAtmosphere1976->getAtmosphereDensityByHeight(-1 * 0.1_m),
       SpaceToolkitException);
 
-  // density calculation -  above atmosphere end at 85000.1 meter beyond sea
-  // level
+  // density calculation - 0.1 meter above atmosphere end
+  ASSERT_THROW(
+      usStandardAtmosphere1976->getAtmosphereDensityByHeight(h_top + 0.1_m),
+      SpaceToolkitException);
+}
+
+TEST(USStandardAtmosphere1976Test, TestBatchMatchesScalar) {
+  // SUT
+  auto usStandardAtmosphere1976 = std::make_unique<USStandardAtmosphere1976>();
+
+  // heights across all levels including the level borders
+  std::vector<Length> h;
+  for (int i = 0; i <= 850; ++i) h.push_back(i * 100_m);
+
+  std::vector<Temperature> T(h.size());
+  std::vector<Pressure> P(h.size());
+  std::vector<Density> rho(h.size());
+  usStandardAtmosphere1976->getAtmosphereTemperatureByHeight(h.data(), T.data(),
+                                                             h.size());
+  usStandardAtmosphere1976->getAtmospherePressureByHeight(h.data(), P.data(),
+                                                          h.size());
+  usStandardAtmosphere1976->getAtmosphereDensityByHeight(h.data(), rho.data(),
+                                                         h.size());
+
+  for (size_t i = 0; i < h.size(); ++i) {
+    Temperature T_ref =
+        usStandardAtmosphere1976->getAtmosphereTemperatureByHeight(h[i]);
+    Pressure P_ref =
+        usStandardAtmosphere1976->getAtmospherePressureByHeight(h[i]);
+    Density rho_ref =
+        usStandardAtmosphere1976->getAtmosphereDensityByHeight(h[i]);
+
+    ASSERT_NEAR(T_ref.getValue(), T[i].getValue(),
+                1e-12 * T_ref.getValue());
+    ASSERT_NEAR(P_ref.getValue(), P[i].getValue(),
+                1e-12 * P_ref.getValue());
+    ASSERT_NEAR(rho_ref.getValue(), rho[i].getValue(),
+                1e-12 * rho_ref.getValue());
+  }
+}
+
+TEST(USStandardAtmosphere1976Test, TestBatchInputHeightOutOfRange) {
+  // SUT
+  auto usStandardAtmosphere1976 = std::make_unique<USStandardAtmosphere1976>();
+
+  std::vector<Length> h = {0_m, 1000_m,
+                           usStandardAtmosphere1976->getTopHeight() + 0.1_m,
+                           2000_m};
+  std::vector<Temperature> T(h.size());
+  std::vector<Pressure> P(h.size());
+  std::vector<Density> rho(h.size());
+
+  ASSERT_THROW(usStandardAtmosphere1976->getAtmosphereTemperatureByHeight(
+                   h.data(), T.data(), h.size()),
+               SpaceToolkitException);
+  ASSERT_THROW(usStandardAtmosphere1976->getAtmospherePressureByHeight(
+                   h.data(), P.data(), h.size()),
+               SpaceToolkitException);
+
+  h[2] = -1 * 0.1_m;
+  ASSERT_THROW(usStandardAtmosphere1976->getAtmosphereDensityByHeight(
+                   h.data(), rho.data(), h.size()),
+               SpaceToolkitException);
+}
+
+TEST(USStandardAtmosphere1976Test, TestStateMatchesSingleQueries) {
+  // SUT
+  auto usStandardAtmosphere1976 = std::make_unique<USStandardAtmosphere1976>();
+
+  std::vector<Length> h;
+  for (int i = 0; i <= 850; ++i) h.push_back(i * 100_m);
+
+  std::vector<Temperature> T(h.size());
+  std::vector<Pressure> P(h.size());
+  std::vector<Density> rho(h.size());
+  usStandardAtmosphere1976->getAtmosphereStateByHeight(
+      h.data(), T.data(), P.data(), rho.data(), h.size());
+
+  for (size_t i = 0; i < h.size(); ++i) {
+    AtmosphereState state =
+        usStandardAtmosphere1976->getAtmosphereStateByHeight(h[i]);
+    Temperature T_ref =
+        usStandardAtmosphere1976->getAtmosphereTemperatureByHeight(h[i]);
+    Pressure P_ref =
+        usStandardAtmosphere1976->getAtmospherePressureByHeight(h[i]);
+    Density rho_ref =
+        usStandardAtmosphere1976->getAtmosphereDensityByHeight(h[i]);
+
+    ASSERT_NEAR(T_ref.getValue(), state.T.getValue(),
+                1e-12 * T_ref.getValue());
+    ASSERT_NEAR(P_ref.getValue(), state.P.getValue(),
+                1e-12 * P_ref.getValue());
+    // the fused query derives density from the ideal gas law
+    ASSERT_NEAR(rho_ref.getValue(), state.rho.getValue(),
+                1e-5 * rho_ref.getValue());
+
+    ASSERT_NEAR(state.T.getValue(), T[i].getValue(),
+                1e-14 * state.T.getValue());
+    ASSERT_NEAR(state.P.getValue(), P[i].getValue(),
+                1e-14 * state.P.getValue());
+    ASSERT_NEAR(state.rho.getValue(), rho[i].getValue(),
+                1e-14 * state.rho.getValue());
+  }
+
+  ASSERT_THROW(usStandardAtmosphere1976->getAtmosphereStateByHeight(
+                   usStandardAtmosphere1976->getTopHeight() + 0.1_m),
+               SpaceToolkitException);
+}
+
+TEST(USStandardAtmosphere1976Test, TestNonThrowingQueries) {
+  // SUT
+  auto usStandardAtmosphere1976 = std::make_unique<USStandardAtmosphere1976>();
+
+  Length h_top = usStandardAtmosphere1976->getTopHeight();
+
+  AtmosphereState state;
+  ASSERT_EQ(AtmosphereStatus::Ok,
+            usStandardAtmosphere1976->tryGetAtmosphereStateByHeight(
+                25000_m, state));
+  ASSERT_NEAR(2511.0, state.P.getValue(), 0.5);
+
+  // clamped to the state at the nearest valid height
+  ASSERT_EQ(AtmosphereStatus::BelowRange,
+            usStandardAtmosphere1976->tryGetAtmosphereStateByHeight(
+                -1 * 0.1_m, state, OutOfRangePolicy::Clamp));
+  ASSERT_EQ(101325.0, state.P.getValue());
+  ASSERT_EQ(AtmosphereStatus::AboveRange,
+            usStandardAtmosphere1976->tryGetAtmosphereStateByHeight(
+                h_top + 0.1_m, state, OutOfRangePolicy::Clamp));
+  ASSERT_EQ(
+      usStandardAtmosphere1976->getAtmospherePressureByHeight(h_top).getValue(),
+      state.P.getValue());
+
+  ASSERT_EQ(AtmosphereStatus::AboveRange,
+            usStandardAtmosphere1976->tryGetAtmosphereStateByHeight(
+                h_top + 0.1_m, state, OutOfRangePolicy::NaN));
+  ASSERT_TRUE(std::isnan(state.T.getValue()));
+  ASSERT_TRUE(std::isnan(state.P.getValue()));
+  ASSERT_TRUE(std::isnan(state.rho.getValue()));
+}
+
+TEST(USStandardAtmosphere1976Test, TestNonThrowingBatchQuery) {
+  // SUT
+  auto usStandardAtmosphere1976 = std::make_unique<USStandardAtmosphere1976>();
+
+  // 10 heights below and 10 above the range
+  std::vector<Length> h;
+  for (int i = -10; i <= 860; ++i) h.push_back(i * 100_m);
+  for (int i = -10; i <= 10; ++i)
+    h.push_back(usStandardAtmosphere1976->getTopHeight() + i * 100_m);
+
+  std::vector<Temperature> T(h.size());
+  std::vector<Pressure> P(h.size());
+  std::vector<Density> rho(h.size());
+  std::vector<uint64_t> outOfRange((h.size() + 63) / 64);
+
+  for (OutOfRangePolicy policy :
+       {OutOfRangePolicy::Clamp, OutOfRangePolicy::NaN}) {
+    ASSERT_EQ(20u, usStandardAtmosphere1976->tryGetAtmosphereStateByHeight(
+                       h.data(), T.data(), P.data(), rho.data(), h.size(),
+                       outOfRange.data(), policy));
+
+    for (size_t i = 0; i < h.size(); ++i) {
+      AtmosphereState state;
+      AtmosphereStatus status =
+          usStandardAtmosphere1976->tryGetAtmosphereStateByHeight(h[i], state,
+                                                                  policy);
+      bool marked = outOfRange[i / 64] >> (i % 64) & 1;
+      ASSERT_EQ(status != AtmosphereStatus::Ok, marked);
+
+      if (policy == OutOfRangePolicy::NaN && marked) {
+        ASSERT_TRUE(std::isnan(P[i].getValue()));
+        continue;
+      }
+      ASSERT_NEAR(state.T.getValue(), T[i].getValue(),
+                  1e-14 * state.T.getValue());
+      ASSERT_NEAR(state.P.getValue(), P[i].getValue(),
+                  1e-14 * state.P.getValue());
+      ASSERT_NEAR(state.rho.getValue(), rho[i].getValue(),
+                  1e-14 * state.rho.getValue());
+    }
+  }
+
+  // all heights in range
+  ASSERT_EQ(0u, usStandardAtmosphere1976->tryGetAtmosphereStateByHeight(
+                    h.data() + 10, T.data(), P.data(), rho.data(), 851,
+                    outOfRange.data()));
+  for (size_t w = 0; w < (851 + 63) / 64; ++w) ASSERT_EQ(0u, outOfRange[w]);
+}
+
+TEST(USStandardAtmosphere1976Test, TestUpperAtmosphereReferenceValues) {
+  // SUT
+  auto usStandardAtmosphere1976 = std::make_unique<USStandardAtmosphere1976>();
+
+  // geometric altitude, pressure and density of the standard's tables
+  const double reference[][3] = {
+      {100000, 3.2011e-2, 5.604e-7},  {120000, 2.5382e-3, 2.222e-8},
+      {150000, 4.5422e-4, 2.076e-9},  {200000, 8.4736e-5, 2.541e-10},
+      {300000, 8.7704e-6, 1.916e-11}, {500000, 3.0236e-7, 5.215e-13},
+      {1000000, 7.5138e-9, 3.561e-15},
+  };
+  for (const auto& r : reference) {
+    AtmosphereState state =
+        usStandardAtmosphere1976->getAtmosphereStateByHeight(
+            geopotential(r[0]));
+    ASSERT_NEAR(r[1], state.P.getValue(), 2e-3 * r[1]);
+    ASSERT_NEAR(r[2], state.rho.getValue(), 2e-3 * r[2]);
+  }
+
+  ASSERT_NEAR(195.08,
+              usStandardAtmosphere1976
+                  ->getAtmosphereTemperatureByHeight(geopotential(100000))
+                  .getValue(),
+              0.01);
+  ASSERT_NEAR(360.0,
+              usStandardAtmosphere1976
+                  ->getAtmosphereTemperatureByHeight(geopotential(120000))
+                  .getValue(),
+              0.01);
+  ASSERT_NEAR(1000.0,
+              usStandardAtmosphere1976
+                  ->getAtmosphereTemperatureByHeight(geopotential(1000000))
+                  .getValue(),
+              0.01);
+  ASSERT_NEAR(geopotential(1000000).getValue(),
+              usStandardAtmosphere1976->getTopHeight().getValue(), 1e-6);
+}
+
+TEST(USStandardAtmosphere1976Test, TestUpperAtmosphereIsContinuous) {
+  // SUT
+  auto usStandardAtmosphere1976 = std::make_unique<USStandardAtmosphere1976>();
+
+  // the lower layers and the thermosphere differ by 0.2 K at the junction
+  AtmosphereState lower =
+      usStandardAtmosphere1976->getAtmosphereStateByHeight(85000_m);
+  AtmosphereState upper =
+      usStandardAtmosphere1976->getAtmosphereStateByHeight(85000.001_m);
+  ASSERT_NEAR(lower.T.getValue(), upper.T.getValue(), 0.25);
+  ASSERT_NEAR(lower.P.getValue(), upper.P.getValue(), 2e-3 * lower.P.getValue());
+  ASSERT_NEAR(lower.rho.getValue(), upper.rho.getValue(),
+              2e-3 * lower.rho.getValue());
+
+  // above it pressure and density decrease monotonically and without jumps at
+  // the table nodes, the step of 1 m changes them by far less than 1e-3
+  Length h_top = usStandardAtmosphere1976->getTopHeight();
+  AtmosphereState previous = upper;
+  for (Length h = 85001_m; h <= h_top; h = h + 1_m) {
+    AtmosphereState state = usStandardAtmosphere1976->getAtmosphereStateByHeight(h);
+    ASSERT_LT(state.P.getValue(), previous.P.getValue());
+    ASSERT_LT(state.rho.getValue(), previous.rho.getValue());
+    ASSERT_GT(state.P.getValue(), (1 - 1e-3) * previous.P.getValue());
+    ASSERT_GT(state.rho.getValue(), (1 - 1e-3) * previous.rho.getValue());
+    previous = state;
+  }
+}
+
+TEST(USStandardAtmosphere1976Test, TestUpperAtmosphereBatchMatchesScalar) {
+  // SUT
+  auto usStandardAtmosphere1976 = std::make_unique<USStandardAtmosphere1976>();
+
+  // heights from sea level to the top, more than one batch chunk
+  Length h_top = usStandardAtmosphere1976->getTopHeight();
+  std::vector<Length> h;
+  for (int i = 0; i <= 5000; ++i) h.push_back(h_top * (i / 5000.0));
+
+  std::vector<Temperature> T(h.size());
+  std::vector<Pressure> P(h.size());
+  std::vector<Density> rho(h.size());
+  usStandardAtmosphere1976->getAtmosphereStateByHeight(
+      h.data(), T.data(), P.data(), rho.data(), h.size());
+
+  std::vector<Temperature> T_single(h.size());
+  std::vector<Pressure> P_single(h.size());
+  std::vector<Density> rho_single(h.size());
+  usStandardAtmosphere1976->getAtmosphereTemperatureByHeight(
+      h.data(), T_single.data(), h.size());
+  usStandardAtmosphere1976->getAtmospherePressureByHeight(
+      h.data(), P_single.data(), h.size());
+  usStandardAtmosphere1976->getAtmosphereDensityByHeight(
+      h.data(), rho_single.data(), h.size());
+
+  for (size_t i = 0; i < h.size(); ++i) {
+    AtmosphereState state =
+        usStandardAtmosphere1976->getAtmosphereStateByHeight(h[i]);
+
+    ASSERT_NEAR(state.T.getValue(), T[i].getValue(),
+                1e-12 * state.T.getValue());
+    ASSERT_NEAR(state.P.getValue(), P[i].getValue(),
+                1e-12 * state.P.getValue());
+    ASSERT_NEAR(state.rho.getValue(), rho[i].getValue(),
+                1e-12 * state.rho.getValue());
+
+    ASSERT_EQ(T[i].getValue(), T_single[i].getValue());
+    ASSERT_EQ(P[i].getValue(), P_single[i].getValue());
+    ASSERT_EQ(rho[i].getValue(), rho_single[i].getValue());
+  }
+}
+
+// Heights of both atmospheres interleaved in one chunk and a NaN height, so
+// the upper atmosphere kernel also runs on heights it does not cover. Run
+// under -fsanitize=address to check that it stays within its table.
+TEST(USStandardAtmosphere1976Test, TestMixedHeightBatch) {
+  // SUT
+  USStandardAtmosphere1976 usStandardAtmosphere1976;
+
+  Length h_top = usStandardAtmosphere1976.getTopHeight();
+  std::vector<Length> h;
+  for (int i = 0; i <= 3000; ++i)
+    h.push_back(h_top * ((i * 7919 % 3001) / 3000.0));
+
+  std::vector<Temperature> T(h.size());
+  std::vector<Pressure> P(h.size());
+  std::vector<Density> rho(h.size());
+  usStandardAtmosphere1976.getAtmosphereStateByHeight(
+      h.data(), T.data(), P.data(), rho.data(), h.size());
+
+  for (size_t i = 0; i < h.size(); ++i) {
+    AtmosphereState state =
+        usStandardAtmosphere1976.getAtmosphereStateByHeight(h[i]);
+    ASSERT_NEAR(state.T.getValue(), T[i].getValue(),
+                1e-12 * state.T.getValue());
+    ASSERT_NEAR(state.P.getValue(), P[i].getValue(),
+                1e-12 * state.P.getValue());
+    ASSERT_NEAR(state.rho.getValue(), rho[i].getValue(),
+                1e-12 * state.rho.getValue());
+  }
+
+  h[h.size() / 2] = Length(NAN);
+  std::vector<uint64_t> outOfRange((h.size() + 63) / 64);
+  ASSERT_EQ(1u, usStandardAtmosphere1976.tryGetAtmosphereStateByHeight(
+                    h.data(), T.data(), P.data(), rho.data(), h.size(),
+                    outOfRange.data(), OutOfRangePolicy::NaN));
+  ASSERT_TRUE(std::isnan(P[h.size() / 2].getValue()));
+}
+
+TEST(USStandardAtmosphere1976Test, TestAltitudeConversion) {
+  ASSERT_EQ(0.0, USStandardAtmosphere1976::toGeopotentialHeight(0_m).getValue());
+  ASSERT_NEAR(
+      84852.05,
+      USStandardAtmosphere1976::toGeopotentialHeight(86000_m).getValue(),
+      0.01);
+  ASSERT_NEAR(
+      86000.0,
+      USStandardAtmosphere1976::toGeometricAltitude(84852.05_m).getValue(),
+      0.01);
+
+  for (int i = 0; i <= 1000; ++i) {
+    Length z = i * 1000_m;
+    ASSERT_NEAR(z.getValue(),
+                USStandardAtmosphere1976::toGeometricAltitude(
+                    USStandardAtmosphere1976::toGeopotentialHeight(z))
+                    .getValue(),
+                1e-9);
+  }
+}
+
+TEST(USStandardAtmosphere1976Test, TestStateByAltitude) {
+  // SUT
+  auto usStandardAtmosphere1976 = std::make_unique<USStandardAtmosphere1976>();
+
+  // altitudes from sea level to 1000 km, more than one batch chunk
+  std::vector<Length> z;
+  for (int i = 0; i <= 5000; ++i) z.push_back(i * 200_m);
+
+  std::vector<Temperature> T(z.size());
+  std::vector<Pressure> P(z.size());
+  std::vector<Density> rho(z.size());
+  usStandardAtmosphere1976->getAtmosphereStateByAltitude(
+      z.data(), T.data(), P.data(), rho.data(), z.size());
+
+  for (size_t i = 0; i < z.size(); ++i) {
+    AtmosphereState state =
+        usStandardAtmosphere1976->getAtmosphereStateByAltitude(z[i]);
+    Length h = std::min(USStandardAtmosphere1976::toGeopotentialHeight(z[i]),
+                        usStandardAtmosphere1976->getTopHeight());
+    AtmosphereState expected =
+        usStandardAtmosphere1976->getAtmosphereStateByHeight(h);
+
+    ASSERT_EQ(expected.T.getValue(), state.T.getValue());
+    ASSERT_NEAR(expected.P.getValue(), state.P.getValue(),
+                1e-12 * expected.P.getValue());
+    ASSERT_NEAR(expected.rho.getValue(), state.rho.getValue(),
+                1e-12 * expected.rho.getValue());
+
+    ASSERT_NEAR(state.T.getValue(), T[i].getValue(),
+                1e-12 * state.T.getValue());
+    ASSERT_NEAR(state.P.getValue(), P[i].getValue(),
+                1e-12 * state.P.getValue());
+    ASSERT_NEAR(state.rho.getValue(), rho[i].getValue(),
+                1e-12 * state.rho.getValue());
+  }
+
+  // the reference values of the standard are given by geometric altitude
+  AtmosphereState top =
+      usStandardAtmosphere1976->getAtmosphereStateByAltitude(1000000_m);
+  ASSERT_NEAR(1000.0, top.T.getValue(), 0.01);
+  ASSERT_NEAR(7.5138e-9, top.P.getValue(), 2e-3 * 7.5138e-9);
+
   ASSERT_THROW(
-      usStandardAtmosphere1976->getAtmosphereDensityByHeight(85000.1_m),
+      usStandardAtmosphere1976->getAtmosphereStateByAltitude(-1 * 0.1_m),
       SpaceToolkitException);
+  ASSERT_THROW(
+      usStandardAtmosphere1976->getAtmosphereStateByAltitude(1000000.1_m),
+      SpaceToolkitException);
+  z[3] = 1000000.1_m;
+  ASSERT_THROW(usStandardAtmosphere1976->getAtmosphereStateByAltitude(
+                   z.data(), T.data(), P.data(), rho.data(), z.size()),
+               SpaceToolkitException);
+}
+
+TEST(USStandardAtmosphere1976Test, TestDerivedProperties) {
+  // SUT
+  auto usStandardAtmosphere1976 = std::make_unique<USStandardAtmosphere1976>();
+
+  // sea level and 11 km values of the standard
+  AtmosphereProperties seaLevel =
+      usStandardAtmosphere1976->getAtmospherePropertiesByHeight(0_m);
+  ASSERT_NEAR(340.294, seaLevel.a.getValue(), 1e-3);
+  ASSERT_NEAR(1.7894e-5, seaLevel.mu.getValue(), 1e-9);
+  ASSERT_NEAR(1.4607e-5, seaLevel.nu.getValue(), 1e-9);
+  ASSERT_NEAR(6.6328e-8, seaLevel.meanFreePath.getValue(), 1e-11);
+  ASSERT_NEAR(seaLevel.a.getValue() / seaLevel.nu.getValue(),
+              seaLevel.reynoldsPerMetre.getValue(),
+              1e-12 * seaLevel.reynoldsPerMetre.getValue());
+
+  AtmosphereProperties tropopause =
+      usStandardAtmosphere1976->getAtmospherePropertiesByHeight(11000_m);
+  ASSERT_NEAR(295.070, tropopause.a.getValue(), 1e-3);
+  ASSERT_NEAR(1.4216e-5, tropopause.mu.getValue(), 1e-9);
+
+  // heights from sea level to the top, more than one chunk
+  Length h_top = usStandardAtmosphere1976->getTopHeight();
+  std::vector<Length> h;
+  for (int i = 0; i <= 2000; ++i) h.push_back(h_top * (i / 2000.0));
+
+  std::vector<AtmosphereProperties> properties(h.size());
+  usStandardAtmosphere1976->getAtmospherePropertiesByHeight(
+      h.data(), properties.data(), h.size());
+
+  for (size_t i = 0; i < h.size(); ++i) {
+    AtmosphereProperties expected =
+        usStandardAtmosphere1976->getAtmospherePropertiesByHeight(h[i]);
+    const AtmosphereProperties& p = properties[i];
+
+    ASSERT_NEAR(expected.T.getValue(), p.T.getValue(),
+                1e-12 * expected.T.getValue());
+    ASSERT_NEAR(expected.P.getValue(), p.P.getValue(),
+                1e-12 * expected.P.getValue());
+    ASSERT_NEAR(expected.a.getValue(), p.a.getValue(),
+                1e-12 * expected.a.getValue());
+    ASSERT_NEAR(expected.mu.getValue(), p.mu.getValue(),
+                1e-12 * expected.mu.getValue());
+    ASSERT_NEAR(expected.nu.getValue(), p.nu.getValue(),
+                1e-12 * expected.nu.getValue());
+    ASSERT_NEAR(expected.reynoldsPerMetre.getValue(),
+                p.reynoldsPerMetre.getValue(),
+                1e-12 * expected.reynoldsPerMetre.getValue());
+    ASSERT_NEAR(expected.meanFreePath.getValue(), p.meanFreePath.getValue(),
+                1e-12 * expected.meanFreePath.getValue());
+  }
+
+  ASSERT_THROW(usStandardAtmosphere1976->getAtmospherePropertiesByHeight(
+                   h_top + 0.1_m),
+               SpaceToolkitException);
+}
+
+TEST(USStandardAtmosphere1976Test, TestInverseQueries) {
+  // SUT
+  auto usStandardAtmosphere1976 = std::make_unique<USStandardAtmosphere1976>();
+
+  // pressure altitude of the standard, 1000 hPa at 110.9 m geopotential
+  ASSERT_NEAR(
+      110.9,
+      usStandardAtmosphere1976->getHeightByPressure(100000_Pa).getValue(),
+      0.1);
+
+  // heights from sea level to the top, more than one chunk
+  Length h_top = usStandardAtmosphere1976->getTopHeight();
+  std::vector<Length> h;
+  for (int i = 0; i <= 5000; ++i) h.push_back(h_top * (i / 5000.0));
+
+  std::vector<Pressure> P(h.size());
+  std::vector<Density> rho(h.size());
+  usStandardAtmosphere1976->getAtmospherePressureByHeight(h.data(), P.data(),
+                                                          h.size());
+  usStandardAtmosphere1976->getAtmosphereDensityByHeight(h.data(), rho.data(),
+                                                         h.size());
+
+  std::vector<Length> h_P(h.size());
+  std::vector<Length> h_rho(h.size());
+  usStandardAtmosphere1976->getHeightByPressure(P.data(), h_P.data(),
+                                                h.size());
+  usStandardAtmosphere1976->getHeightByDensity(rho.data(), h_rho.data(),
+                                               h.size());
+
+  for (size_t i = 0; i < h.size(); ++i) {
+    Length h_Pi = usStandardAtmosphere1976->getHeightByPressure(P[i]);
+    Length h_rhoi = usStandardAtmosphere1976->getHeightByDensity(rho[i]);
+    ASSERT_NEAR(h_Pi.getValue(), h_P[i].getValue(), 1e-6);
+    ASSERT_NEAR(h_rhoi.getValue(), h_rho[i].getValue(), 1e-6);
+
+    // the pressure jumps by 5e-5 at 85 km, heights less than 1 m above it
+    // may come back as 85 km
+    double tolerance = h[i] > 85000_m && h[i] < 85001_m ? 1.0 : 1e-6;
+    ASSERT_NEAR(h[i].getValue(), h_Pi.getValue(), tolerance);
+    ASSERT_NEAR(h[i].getValue(), h_rhoi.getValue(), tolerance);
+  }
+
+  ASSERT_THROW(usStandardAtmosphere1976->getHeightByPressure(101326_Pa),
+               SpaceToolkitException);
+  ASSERT_THROW(usStandardAtmosphere1976->getHeightByDensity(Density(1e-20)),
+               SpaceToolkitException);
+}
+
+TEST(USStandardAtmosphere1976Test, TestSinglePrecisionBatch) {
+  // SUT
+  auto usStandardAtmosphere1976 = std::make_unique<USStandardAtmosphere1976>();
+
+  // heights from sea level to the top, more than one chunk
+  float h_top = static_cast<float>(
+      usStandardAtmosphere1976->getTopHeight().getValue());
+  std::vector<float> h;
+  for (int i = 0; i <= 5000; ++i) h.push_back(h_top * (i / 5000.0f));
+
+  std::vector<float> T(h.size());
+  std::vector<float> P(h.size());
+  std::vector<float> rho(h.size());
+  usStandardAtmosphere1976->getAtmosphereStateByHeight(
+      h.data(), T.data(), P.data(), rho.data(), h.size());
+
+  for (size_t i = 0; i < h.size(); ++i) {
+    Length h_i =
+        std::min(Length(h[i]), usStandardAtmosphere1976->getTopHeight());
+    AtmosphereState state =
+        usStandardAtmosphere1976->getAtmosphereStateByHeight(h_i);
+
+    ASSERT_NEAR(state.T.getValue(), T[i], 3e-7 * state.T.getValue());
+    ASSERT_NEAR(state.P.getValue(), P[i], 1e-6 * state.P.getValue());
+    ASSERT_NEAR(state.rho.getValue(), rho[i], 1e-6 * state.rho.getValue());
+  }
+
+  h.back() = h_top * 1.001f;
+  ASSERT_THROW(usStandardAtmosphere1976->getAtmosphereStateByHeight(
+                   h.data(), T.data(), P.data(), rho.data(), h.size()),
+               SpaceToolkitException);
+}
+
+TEST(USStandardAtmosphere1976Test, TestDerivatives) {
+  // SUT
+  auto usStandardAtmosphere1976 = std::make_unique<USStandardAtmosphere1976>();
+
+  // central differences away from the layer boundaries and the junction, the
+  // thermosphere profiles are smooth across their nodes and regions
+  std::vector<double> boundaries = {11000.0, 20000.0, 32000.0, 47000.0,
+                                    51000.0, 71000.0, 85000.0};
+  Length h_top = usStandardAtmosphere1976->getTopHeight();
+  const Length dh = 0.5_m;
+  for (Length h = 1_m; h < h_top - 1_m; h += 97.3_m) {
+    bool nearBoundary = false;
+    for (double h_b : boundaries)
+      nearBoundary = nearBoundary || std::fabs(h.getValue() - h_b) < 1.0;
+    if (nearBoundary) continue;
+
+    SpaceToolkit::AtmosphereDerivatives d;
+    AtmosphereState state =
+        usStandardAtmosphere1976->getAtmosphereStateByHeight(h, d);
+    AtmosphereState reference =
+        usStandardAtmosphere1976->getAtmosphereStateByHeight(h);
+    ASSERT_EQ(reference.T.getValue(), state.T.getValue());
+    ASSERT_EQ(reference.P.getValue(), state.P.getValue());
+    ASSERT_EQ(reference.rho.getValue(), state.rho.getValue());
+
+    AtmosphereState below =
+        usStandardAtmosphere1976->getAtmosphereStateByHeight(h - dh);
+    AtmosphereState above =
+        usStandardAtmosphere1976->getAtmosphereStateByHeight(h + dh);
+    double dT = (above.T - below.T).getValue() / (2 * dh.getValue());
+    double dP = (above.P - below.P).getValue() / (2 * dh.getValue());
+    double drho = (above.rho - below.rho).getValue() / (2 * dh.getValue());
+    ASSERT_NEAR(dT, d.dT.getValue(), 1e-6 * std::fabs(dT) + 1e-9)
+        << "h = " << h.getValue();
+    ASSERT_NEAR(dP, d.dP.getValue(), 1e-6 * std::fabs(dP))
+        << "h = " << h.getValue();
+    ASSERT_NEAR(drho, d.drho.getValue(), 1e-6 * std::fabs(drho))
+        << "h = " << h.getValue();
+
+    // hydrostatic equilibrium in the lower layers
+    if (h <= 85000_m) {
+      ASSERT_NEAR(-9.80665 * state.rho.getValue(), d.dP.getValue(),
+                  1e-12 * std::fabs(d.dP.getValue()));
+    }
+  }
+
+  // at a layer boundary the derivatives from below
+  SpaceToolkit::AtmosphereDerivatives d;
+  usStandardAtmosphere1976->getAtmosphereStateByHeight(0_m, d);
+  ASSERT_EQ(-0.0065, d.dT.getValue());
+  usStandardAtmosphere1976->getAtmosphereStateByHeight(11000_m, d);
+  ASSERT_EQ(-0.0065, d.dT.getValue());
+  usStandardAtmosphere1976->getAtmosphereStateByHeight(20000_m, d);
+  ASSERT_EQ(0.0, d.dT.getValue());
+  usStandardAtmosphere1976->getAtmosphereStateByHeight(85000_m, d);
+  ASSERT_EQ(-0.002, d.dT.getValue());
+
+  ASSERT_THROW(usStandardAtmosphere1976->getAtmosphereStateByHeight(
+                   h_top + 1_m, d),
+               SpaceToolkitException);
+}
+
+TEST(USStandardAtmosphere1976Test, TestProfile) {
+  // SUT
+  auto usStandardAtmosphere1976 = std::make_unique<USStandardAtmosphere1976>();
+
+  // fine and coarse steps, from sea level and from within a layer, through
+  // the thermosphere
+  Length h_top = usStandardAtmosphere1976->getTopHeight();
+  for (Length step : {0.25_m, 1_m, 7.3_m, 100_m, 2500_m}) {
+    for (Length bottom : {0_m, 10999.9_m}) {
+      size_t n = std::min(
+          size_t((h_top - bottom).getValue() / step.getValue()) + 1,
+          size_t(200000));
+      std::vector<Length> h(n);
+      for (size_t i = 0; i < n; ++i)
+        h[i] = Length(bottom.getValue() + i * step.getValue());
+
+      std::vector<Temperature> T(n), T_ref(n);
+      std::vector<Pressure> P(n), P_ref(n);
+      std::vector<Density> rho(n), rho_ref(n);
+      usStandardAtmosphere1976->getAtmosphereProfile(bottom, step, T.data(),
+                                                     P.data(), rho.data(), n);
+      usStandardAtmosphere1976->getAtmosphereStateByHeight(
+          h.data(), T_ref.data(), P_ref.data(), rho_ref.data(), n);
+
+      for (size_t i = 0; i < n; ++i) {
+        ASSERT_NEAR(T_ref[i].getValue(), T[i].getValue(),
+                    1e-12 * T_ref[i].getValue())
+            << "h = " << h[i].getValue();
+        ASSERT_NEAR(P_ref[i].getValue(), P[i].getValue(),
+                    1e-12 * P_ref[i].getValue())
+            << "h = " << h[i].getValue();
+        ASSERT_NEAR(rho_ref[i].getValue(), rho[i].getValue(),
+                    1e-12 * rho_ref[i].getValue())
+            << "h = " << h[i].getValue();
+      }
+    }
+  }
+
+  Temperature T[2];
+  Pressure P[2];
+  Density rho[2];
+  usStandardAtmosphere1976->getAtmosphereProfile(0_m, 1_m, T, P, rho, 0);
+  ASSERT_THROW(usStandardAtmosphere1976->getAtmosphereProfile(
+                   -1 * 1_m, 1_m, T, P, rho, 2),
+               SpaceToolkitException);
+  ASSERT_THROW(usStandardAtmosphere1976->getAtmosphereProfile(
+                   h_top, 1_m, T, P, rho, 2),
+               SpaceToolkitException);
+  ASSERT_THROW(usStandardAtmosphere1976->getAtmosphereProfile(
+                   0_m, 0_m, T, P, rho, 2),
+               SpaceToolkitException);
 }
@@ -0,0 +1,42 @@
+#include "SpaceToolkit/UniformBuckets.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <vector>
+
+using SpaceToolkit::UniformBuckets;
+
+namespace {
+// interval k with x[k] <= v < x[k + 1] by binary search, the top belongs to
+// the last interval
+size_t intervalBySearch(const std::vector<double>& x, double v) {
+  size_t k = std::upper_bound(x.begin(), x.end(), v) - x.begin();
+  return std::min(k, x.size() - 1) - 1;
+}
+}  // namespace
+
+TEST(UniformBucketsTest, TestIntervalOf) {
+  // intervals of very different widths, with more buckets than the maximum
+  std::vector<double> x = {-1000.0, -999.999, 0.0, 0.5, 3.0, 2500.0, 2600.0};
+
+  // SUT
+  UniformBuckets buckets(x.data(), x.size());
+  ASSERT_EQ(UniformBuckets::MAX_BUCKET_COUNT * sizeof(uint32_t),
+            buckets.getMemoryFootprint());
+
+  for (size_t k = 0; k < x.size(); ++k)
+    ASSERT_EQ(std::min(k, x.size() - 2), buckets.intervalOf(x.data(), x[k]));
+
+  for (int i = 0; i <= 100000; ++i) {
+    double v = x.front() + (x.back() - x.front()) * i / 100000.0;
+    ASSERT_EQ(intervalBySearch(x, v), buckets.intervalOf(x.data(), v))
+        << "v = " << v;
+  }
+
+  // a single interval
+  std::vector<double> y = {1.0, 2.0};
+  UniformBuckets single(y.data(), y.size());
+  ASSERT_EQ(0u, single.intervalOf(y.data(), 1.0));
+  ASSERT_EQ(0u, single.intervalOf(y.data(), 2.0));
+}